@@ -25,6 +25,7 @@ namespace Synchronization
     class AbstractConnection;
     class AbstractDataHistory;
     class Communicator;
+    class GlobalVirtualTime;
     class HistoryEntry;
     class Interpolation;
     class SerialDataHistory;
@@ -32,6 +33,7 @@ namespace Synchronization
     typedef std::shared_ptr<AbstractConnection> ConnectionSPtr;
     typedef std::shared_ptr<AbstractDataHistory> DataHistorySPtr;
     typedef std::shared_ptr<Communicator> CommunicatorSPtr;
+    typedef std::shared_ptr<GlobalVirtualTime> GlobalVirtualTimeSPtr;
     typedef std::shared_ptr<Interpolation> InterpolationSPtr;
 
     //struct CompareTwoEntryPtr;
@@ -31,6 +31,7 @@
 #include <assert.h>
 #include <type_traits>
 #include <utility>
+#include <functional>
 
 using std::list;
 using std::deque;
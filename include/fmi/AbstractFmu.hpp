@@ -10,9 +10,12 @@
 
 #include "Stdafx.hpp"
 #include "fmi/FmuEventInfo.hpp"
+#include "fmi/FmuStatePool.hpp"
+#include "fmi/FmuTypeInfo.hpp"
 #include "fmi/ValueCollection.hpp"
 #include "fmi/ValueInfo.hpp"
 #include "fmi/ValueReferenceCollection.hpp"
+#include "fmi/ValueSubset.hpp"
 #include "util/EventHandler.hpp"
 #include "initialization/Plans.hpp"
 
@@ -23,6 +26,14 @@ namespace FMI
         ALL, START, EVENT, CONTINIOUS
     };
 
+    /**
+     * Result of a communication step of a co-simulation FMU.
+     */
+    enum CoSimulationStepStatus
+    {
+        DONE, PENDING, DISCARDED
+    };
+
 
     /**
      * This class represents a loaded FMU that can access all functions that are described in the FMI 1.0
@@ -75,6 +86,24 @@ namespace FMI
         virtual void getStateDerivativesInternal(real_type * stateDerivatives) = 0;
         virtual void getEventIndicatorsInternal(real_type * eventIndicators) = 0;
 
+        /**
+         * Calculates the product of the Jacobian of the state derivatives and the given seed vector of the states.
+         * Only called, if providesDirectionalDerivative() is true.
+         */
+        virtual void getDirectionalDerivativeInternal(const real_type * seed, real_type * result);
+
+        /**
+         * Saves the state of the FMU into the snapshot. The default emulates it by the continuous states and the
+         * values of the event value references, the internal state of the FMU isn't saved.
+         */
+        virtual void saveStateInternal(FmuSnapshot & snapshot);
+        virtual void restoreStateInternal(const FmuSnapshot & snapshot);
+
+        /**
+         * Frees the handle of the snapshot, called when the FMU is unloaded.
+         */
+        virtual void freeStateInternal(FmuSnapshot & snapshot);
+
      public:
 
         /**
@@ -158,6 +187,7 @@ namespace FMI
         /**
          * Set all value references that should be used by the FMU.
          * @param valueReferences The new value references.
+         * @note The instance gets its own copy of the type info, other instances of the FMU are unchanged.
          * @todo Make the setAllValueReferences protected and use the library loader as friend.
          */
         void setAllValueReferences(const ValueReferenceCollection & valueReferences);
@@ -192,8 +222,112 @@ namespace FMI
 
         vector<real_type> getEventIndicators();
 
+        /**
+         * Check if the FMU calculates exact directional derivatives of its state derivatives.
+         * @return True, if getJacobian() uses directional derivatives instead of finite differences.
+         */
+        virtual bool_type providesDirectionalDerivative() const;
+
+        /**
+         * Calculates the Jacobian of the state derivatives by the states in column-major order, i.e.,
+         * jacobian[j * numStates + i] is the derivative of the i-th state derivative by the j-th state. Columns without
+         * a common row in the dependency pattern are evaluated together by one directional derivative or, if the FMU
+         * doesn't provide them, by one forward difference.
+         * @param jacobian Space for numStates * numStates values.
+         */
+        void getJacobian(real_type * jacobian);
+
+        /**
+         * Get the dependencies of the state derivatives on the states.
+         * @return For every state derivative the indices of the states it depends on. Empty, if unknown.
+         */
+        const vector<vector<size_type>> & getJacobianPattern() const;
+
+        /**
+         * Check if the FMU is driven by its own solver via doStep() instead of the model exchange functions.
+         * @return True, if the FMU is loaded as co-simulation FMU.
+         */
+        bool isCoSimulation() const;
+
+        /**
+         * Starts the communication step from the current time to the current time plus stepSize. The inputs at the
+         * current time have to be set before.
+         * @return DONE, if the FMU reached the end of the step. PENDING, if it computes the step asynchronously, poll
+         *         getStepStatus() then. DISCARDED, if it only reached getTime().
+         */
+        virtual CoSimulationStepStatus doStep(const real_type & stepSize);
+
+        /**
+         * Polls the status of a pending communication step.
+         */
+        virtual CoSimulationStepStatus getStepStatus();
+
+        /**
+         * Aborts a pending communication step. Afterwards, the FMU can only be unloaded.
+         */
+        virtual void cancelStep();
+
+        /**
+         * Check if pending communication steps can be aborted by cancelStep().
+         */
+        virtual bool_type canCancelStep() const;
+
+        /**
+         * Check if the communication step size may change from step to step.
+         */
+        virtual bool_type canHandleVariableStepSize() const;
+
+        /**
+         * Check if saveState() saves the complete internal state of the FMU. Otherwise it saves the time, the
+         * continuous states and the values, which is enough for FMUs without hidden discrete states.
+         */
+        virtual bool_type canGetAndSetState() const;
+
+        /**
+         * Saves the state of the FMU into a new snapshot. The snapshots are pooled, so saving states frequently
+         * doesn't allocate memory, as long as the snapshots are released.
+         * @return The id of the snapshot, valid until releaseState().
+         */
+        size_type saveState();
+
+        /**
+         * Overwrites the given snapshot with the current state of the FMU.
+         */
+        void saveState(const size_type & snapshot);
+
+        /**
+         * Resets the FMU to the state of the snapshot. The snapshot stays valid.
+         */
+        void restoreState(const size_type & snapshot);
+
+        void releaseState(const size_type & snapshot);
+
+        /**
+         * Packs the snapshot into a buffer, e.g., to move it to another process.
+         * @throw runtime_error If the FMU can't serialize its state.
+         */
+        virtual vector<char> serializeState(const size_type & snapshot);
+
+        /**
+         * Unpacks a buffer of serializeState() into a new snapshot.
+         * @return The id of the snapshot, valid until releaseState().
+         */
+        virtual size_type deserializeState(const vector<char> & buffer);
+
         void setValues(const ValueCollection & values);
 
+        /**
+         * Reads the variables of the subset into their places in the collection of all values, the other values are
+         * kept. Every type is read by a single call of the FMU. Unlike getAllValues(), strings are read, too.
+         */
+        void getValues(ValueCollection & values, const ValueSubset & subset) const;
+
+        /**
+         * Sets the variables of the subset to their values in the collection of all values by a single call of the
+         * FMU per type.
+         */
+        void setValues(const ValueCollection & values, const ValueSubset & subset);
+
         /**
          * Set all value references that are related to output variables.
          * @param outputValues The new output references.
@@ -248,9 +382,15 @@ namespace FMI
         /**
          * Set the value info for the FMU, describing all values.
          * @param valueInfo The new value info.
+         * @note The instance gets its own copy of the type info, other instances of the FMU are unchanged.
          */
         void setValueInfo(const ValueInfo & valueInfo);
 
+        /**
+         * Get the metadata of the FMU type, which is shared by all instances of the FMU.
+         */
+        const FmuTypeInfo & getTypeInfo() const;
+
         /**
          * Check if the event update function should return after every internal event iteration.
          * @return True if intermediate results are returned.
@@ -260,6 +400,12 @@ namespace FMI
         /// Set the relative tolerance to the given value.
         void setRelativeTolerance(real_type relativeTolerance);
 
+        /**
+         * Sets the metadata of the FMU type, the number of states and event indicators and the default inputs and
+         * outputs. Called by the loaders during load().
+         */
+        void setTypeInfo(const FmuTypeInfoSPtr & typeInfo);
+
         void getValues(ValueCollection & values) const;
 
         void getAllValues(ValueCollection & values) const;
@@ -299,6 +445,46 @@ namespace FMI
             //
         }
 
+        template<typename T>
+        void getValueSubset(vector<T> & values, const ValueSubset & subset) const
+        {
+            const vector<size_type> & indices = subset.getIndices<T>();
+            if (indices.empty())
+                return;
+            if (subset.isComplete<T>())
+            {
+                getValuesInternal(values, subset.getReferences().getValues<T>());
+                return;
+            }
+            vector<T> buffer(indices.size());
+            getValuesInternal(buffer, subset.getReferences().getValues<T>());
+            for (size_type i = 0; i < indices.size(); ++i)
+                values[indices[i]] = buffer[i];
+        }
+
+        template<typename T>
+        void setValueSubset(const vector<T> & values, const ValueSubset & subset)
+        {
+            const vector<size_type> & indices = subset.getIndices<T>();
+            if (indices.empty())
+                return;
+            if (subset.isComplete<T>())
+            {
+                setValuesInternal(values, subset.getReferences().getValues<T>());
+                return;
+            }
+            vector<T> buffer(indices.size());
+            for (size_type i = 0; i < indices.size(); ++i)
+                buffer[i] = values[indices[i]];
+            setValuesInternal(buffer, subset.getReferences().getValues<T>());
+        }
+
+        /**
+         * Sets the dependencies of the state derivatives on the states and groups the Jacobian columns, which can be
+         * evaluated together.
+         */
+        void setJacobianPattern(const vector<vector<size_type>> & pattern);
+
         /// Unique identifier.
         const size_type _id;
         size_type _localId;
@@ -308,29 +494,37 @@ namespace FMI
         /// (Absolute) Path to the FMU.
         string _path;
         string _workingPath;
+        /// Directory of the FMU extraction cache.
+        string _cachePath;
         bool _loaded;
         real_type _relativeTolerance;
         bool _toleranceControlled;
         bool _loggingEnabled;
         bool _intermediateResults;
+        bool _coSimulation;
         FmuEventInfo _eventInfo;
 
-        ValueReferenceCollection _allValueReferences;  // containing every variable
-        ValueReferenceCollection _startValueReferences;  // all - constant vars
-        ValueReferenceCollection _eventValueReferences;  // start - parameter vars
-        ValueReferenceCollection _continousValueReferences;  // event - discrete vars
+        /// Shared by all instances of the FMU. Empty, until the FMU is loaded.
+        FmuTypeInfoSPtr _typeInfo;
 
         ValueReferenceCollection _outputValueReferences;
         ValueReferenceCollection _inputValueReferences;
 
-        ValueCollection _startValues;
         real_type _time;
 
-        ValueInfo _valueInfo;
         size_type _numberOfStates;
         size_type _numberOfEventIndicators;
 
         vector<Synchronization::ConnectionSPtr> _fmuCons;
+
+        /// State derivative -> states it depends on. Empty, if every state derivative depends on every state.
+        vector<vector<size_type>> _jacobianPattern;
+        /// State -> state derivatives depending on it.
+        vector<vector<size_type>> _jacobianRows;
+        /// Groups of states, whose Jacobian columns don't share a row.
+        vector<vector<size_type>> _jacobianColumnGroups;
+
+        FmuStatePool _statePool;
     };
 
 } /* namespace FMI */
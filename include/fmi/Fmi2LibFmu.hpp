@@ -0,0 +1,218 @@
+/** @addtogroup FMI
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+#ifdef USE_FMILIB
+
+#ifndef INCLUDE_FMI_FMI2LIBFMU_HPP_
+#define INCLUDE_FMI_FMI2LIBFMU_HPP_
+
+extern "C"
+{
+#include <fmilib.h>
+}
+
+#include <mutex>
+
+#include "Stdafx.hpp"
+#include "fmi/AbstractFmu.hpp"
+
+namespace FMI
+{
+    /**
+     * Loads FMI 2.0 model exchange FMUs with the FMI library (loader "fmi2"). The FMU is extracted into the FMU cache
+     * (see Util::FmuCache). If the FMU provides directional derivatives, getJacobian() uses fmi2GetDirectionalDerivative. The
+     * dependencies of the derivatives in the ModelStructure give the sparsity pattern of the Jacobian.
+     * If the plan requests co-simulation (solver "cosim"), the FMU is instantiated as co-simulation slave instead. It
+     * has neither states nor event indicators then and is advanced by doStep().
+     */
+    class Fmi2LibFmu : public AbstractFmu
+    {
+     public:
+        using AbstractFmu::getValuesInternal;
+        using AbstractFmu::setValuesInternal;
+
+        Fmi2LibFmu(const Initialization::FmuPlan & in);
+        virtual ~Fmi2LibFmu();
+
+        void load(const bool & alsoInit = true) override;
+        void unload() override;
+        void initialize() override;
+
+        AbstractFmu * duplicate() override;
+
+        void stepCompleted() override;
+
+        /**
+         * Does one event iteration. The FMU enters the event mode on the first call and returns to the continuous time
+         * mode, as soon as no new discrete states are needed.
+         */
+        FmuEventInfo eventUpdate() override;
+
+        void setTime(const double & time) override;
+        double getDefaultStart() const override;
+        double getDefaultStop() const override;
+
+        bool_type providesDirectionalDerivative() const override;
+
+        CoSimulationStepStatus doStep(const real_type & stepSize) override;
+        CoSimulationStepStatus getStepStatus() override;
+        void cancelStep() override;
+        bool_type canCancelStep() const override;
+        bool_type canHandleVariableStepSize() const override;
+
+        bool_type canGetAndSetState() const override;
+
+        /**
+         * The buffer holds the time and the state serialized by fmi2SerializeFMUstate.
+         */
+        vector<char> serializeState(const size_type & snapshot) override;
+        size_type deserializeState(const vector<char> & buffer) override;
+
+     protected:
+
+        void getStatesInternal(real_type * states) const override;
+        void setStatesInternal(const real_type * states) override;
+        void getStateDerivativesInternal(real_type * stateDerivatives) override;
+        void getEventIndicatorsInternal(real_type * eventIndicators) override;
+        void getDirectionalDerivativeInternal(const real_type * seed, real_type * result) override;
+
+        /**
+         * Uses fmi2GetFMUstate, if the FMU can get and set its state. The state of a recycled snapshot is overwritten.
+         */
+        void saveStateInternal(FmuSnapshot & snapshot) override;
+        void restoreStateInternal(const FmuSnapshot & snapshot) override;
+        void freeStateInternal(FmuSnapshot & snapshot) override;
+
+        void getValuesInternal(vector<real_type> & out, const vector<size_type> & references) const override;
+        void getValuesInternal(vector<int_type> & out, const vector<size_type> & references) const override;
+        void getValuesInternal(vector<bool_type> & out, const vector<size_type> & references) const override;
+        void getValuesInternal(vector<string_type> & out, const vector<size_type> & references) const override;
+
+        void setValuesInternal(const vector<real_type> & in, const vector<size_type> & references) override;
+        void setValuesInternal(const vector<int_type> & in, const vector<size_type> & references) override;
+        void setValuesInternal(const vector<bool_type> & in, const vector<size_type> & references) override;
+        void setValuesInternal(const vector<string_type> & in, const vector<size_type> & references) override;
+
+     private:
+        std::shared_ptr<fmi_import_context_t> _context;
+        std::shared_ptr<fmi2_import_t> _fmu;
+
+        jm_callbacks _callbacks;
+        fmi2_event_info_t _fmuEventInfo;
+        bool_type _inEventMode;
+        bool_type _providesDirectionalDerivative;
+        bool_type _canRunAsynchronously;
+        bool_type _canHandleVariableStepSize;
+        bool_type _canGetAndSetState;
+        bool_type _canSerializeState;
+        /// End of the current communication step.
+        real_type _stepEndTime;
+
+        /**
+         * Value references of the states and of their derivatives, in the order of the derivatives in the
+         * ModelStructure.
+         */
+        vector<fmi2_value_reference_t> _stateReferences;
+        vector<fmi2_value_reference_t> _derivativeReferences;
+
+        /**
+         * Throws, if the status of an FMI call is worse than a warning.
+         */
+        void check(const fmi2_status_t & status, const string_type & function) const;
+
+        /**
+         * Maps the status of fmi2DoStep, respectively of the pending step, and advances the time accordingly.
+         */
+        CoSimulationStepStatus finishStep(const fmi2_status_t & status);
+
+        /**
+         * Reads the states and the dependencies of their derivatives from the ModelStructure.
+         */
+        void readModelStructure(fmi2_import_variable_list_t * variables);
+
+        /**
+         * Returns the metadata read by another instance of the FMU, which is still in use, or nullptr.
+         */
+        static FmuTypeInfoSPtr findTypeInfo(const string_type & key);
+
+        /**
+         * Shares the given metadata with the instances loaded later, unless another instance shared it first.
+         * @return The shared metadata.
+         */
+        static FmuTypeInfoSPtr shareTypeInfo(const string_type & key, const FmuTypeInfoSPtr & typeInfo);
+
+        /// Metadata of the FMU types by cache directory and FMU kind. Guarded by _typeInfosMutex.
+        static map<string_type, weak_ptr<const FmuTypeInfo>> _typeInfos;
+        static std::mutex _typeInfosMutex;
+
+        template<typename T>
+        void addVariable(fmi2_import_variable_t * variable, FmuTypeInfo & info)
+        {
+            string_type varName = string_type(fmi2_import_get_variable_name(variable));
+            size_type valueReference = fmi2_import_get_variable_vr(variable);
+            info.valueInfo.addNameReferencePair<T>(varName, valueReference);
+            info.allValueReferences.getValues<T>().push_back(valueReference);
+
+            if (fmi2_import_get_variable_alias_kind(variable) == fmi2_variable_is_not_alias)
+            {
+                // There are intentionally no breaks!
+                switch (fmi2_import_get_variability(variable))
+                {
+                    case fmi2_variability_enu_continuous:
+                        info.continousValueReferences.getValues<T>().push_back(valueReference);
+                    case fmi2_variability_enu_discrete:
+                        info.eventValueReferences.getValues<T>().push_back(valueReference);
+                    case fmi2_variability_enu_tunable:
+                    case fmi2_variability_enu_fixed:
+                        if (fmi2_import_get_variable_has_start(variable))
+                        {
+                            info.startValueReferences.getValues<T>().push_back(valueReference);
+                            info.startValues.getValues<T>().push_back(getStartValue<T>(variable));
+                        }
+                    default:
+                        ;
+                }
+            }
+
+            switch (fmi2_import_get_causality(variable))
+            {
+                case fmi2_causality_enu_input:
+                    info.valueInfo.addInputNameReferencePair<T>(varName, valueReference);
+                    info.inputValueReferences.getValues<T>().push_back(valueReference);
+                    break;
+                case fmi2_causality_enu_output:
+                    info.outputValueReferences.getValues<T>().push_back(valueReference);
+                    break;
+                default:
+                    ;
+            }
+        }
+
+        template<typename T>
+        T getStartValue(fmi2_import_variable_t * variable)
+        {
+            throw std::runtime_error("Fmi2LibFmu: Unknown type for start value.");
+        }
+    };
+
+    template<>
+    real_type Fmi2LibFmu::getStartValue<real_type>(fmi2_import_variable_t * variable);
+
+    template<>
+    int_type Fmi2LibFmu::getStartValue<int_type>(fmi2_import_variable_t * variable);
+
+    template<>
+    bool_type Fmi2LibFmu::getStartValue<bool_type>(fmi2_import_variable_t * variable);
+
+    template<>
+    string_type Fmi2LibFmu::getStartValue<string_type>(fmi2_import_variable_t * variable);
+
+} /* namespace FMI */
+
+#endif /* INCLUDE_FMI_FMI2LIBFMU_HPP_ */
+/**
+ * @}
+ */
+
+#endif
@@ -14,6 +14,8 @@ extern "C"
 #include <fmilib.h>
 }
 
+#include <mutex>
+
 #include "Stdafx.hpp"
 #include "fmi/AbstractFmu.hpp"
 
@@ -64,6 +66,7 @@ namespace FMI
      private:
 
         static set<string_type> _loadedFmuObjects;
+        static std::mutex _loadedFmuObjectsMutex;
         set<string_type>::iterator _posPath;
         std::shared_ptr<fmi_import_context_t> _context;
 
@@ -72,30 +75,30 @@ namespace FMI
         fmi1_event_info_t _fmuEventInfo;
 
         template<typename T>
-        void addVariable(fmi1_import_variable_t * variable)
+        void addVariable(fmi1_import_variable_t * variable, FmuTypeInfo & info)
         {
             string_type varName = string_type(fmi1_import_get_variable_name(variable));
             size_type valueReference = fmi1_import_get_variable_vr(variable);
-            _valueInfo.addNameReferencePair<T>(varName, valueReference);
+            info.valueInfo.addNameReferencePair<T>(varName, valueReference);
             fmi1_causality_enu_t varCausality = fmi1_import_get_causality(variable);
 
             if (fmi1_import_get_variable_has_start(variable))
             {
-                _startValues.getValues<T>().push_back(getStartValue<T>(variable));
-                _startValueReferences.getValues<T>().push_back(valueReference);
+                info.startValues.getValues<T>().push_back(getStartValue<T>(variable));
+                info.startValueReferences.getValues<T>().push_back(valueReference);
             }
-            _valueInfo.addNameReferencePair<T>(varName, valueReference);
-            _allValueReferences.getValues<T>().push_back(valueReference);
+            info.valueInfo.addNameReferencePair<T>(varName, valueReference);
+            info.allValueReferences.getValues<T>().push_back(valueReference);
 
             switch (varCausality)
             {
                 case fmi1_causality_enu_t::fmi1_causality_enu_input:
-                    _inputValueReferences.getValues<T>().push_back(valueReference);
+                    info.inputValueReferences.getValues<T>().push_back(valueReference);
                     //_startValues.getValues<T>().push_back(std::numeric_limits<T>::max());
                     //_startValueReferences.getValues<T>().push_back(valueReference);
                     break;
                 case fmi1_causality_enu_t::fmi1_causality_enu_output:
-                    _outputValueReferences.getValues<T>().push_back(valueReference);
+                    info.outputValueReferences.getValues<T>().push_back(valueReference);
                     break;
                 default:
                     ;
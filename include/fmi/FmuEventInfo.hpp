@@ -118,6 +118,11 @@ namespace FMI
 
 #ifdef USE_FMILIB
         void assign(const fmi1_event_info_t & in);
+
+        /**
+         * Maps the FMI 2.0 event info: the event iteration converged, if no new discrete states are needed.
+         */
+        void assign(const fmi2_event_info_t & in);
 #endif
 
      private:
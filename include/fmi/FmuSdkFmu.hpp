@@ -8,7 +8,11 @@
 #ifndef INCLUDE_FMI_FMUSDKFMU_HPP_
 #define INCLUDE_FMI_FMUSDKFMU_HPP_
 
+#include <future>
+#include <mutex>
+
 #include "fmi/AbstractFmu.hpp"
+#include "fmi/ModelDescriptionCache.hpp"
 #include "fmusdk.h"
 
 namespace FMI
@@ -51,7 +55,18 @@ namespace FMI
 
         void fillNameVector(vector<string_type> &valueNames, const map<int, string_type> &valueNamesIdx);
 
-        FMU* getFmuHandle(string_type fmuName) const;
+        /**
+         * Returns the shared handle of the FMU and loads it, if no other instance did. Safe to call in parallel: The
+         * FMU is extracted and its modelDescription is parsed only once, threads requesting the same FMU meanwhile
+         * wait for it, while FMUs of other types are extracted concurrently.
+         * @param typeInfo Gets the metadata of the FMU, which is shared by all its instances as well.
+         */
+        FMU* getFmuHandle(string_type fmuName, FmuTypeInfoSPtr & typeInfo);
+
+        /**
+         * Reads the variables of the modelDescription once per FMU type.
+         */
+        FmuTypeInfoSPtr createTypeInfo(const ModelDescriptionTable & table);
 
         void getValuesInternal(vector<real_type> & out, const vector<size_type> & references) const override;
         void getValuesInternal(vector<int_type> & out, const vector<size_type> & references) const override;
@@ -68,7 +83,11 @@ namespace FMI
         void (*_Nullifier)(FMU*) = [](FMU * in)
         {   in = nullptr;};
 
-        static map<string_type, tuple<FMU *, size_type>> _knownFmus;
+        /// Loaded FMUs, their metadata and the number of instances using them. Guarded by _knownFmusMutex.
+        static map<string_type, tuple<std::shared_future<pair<FMU *, FmuTypeInfoSPtr>>, size_type>> _knownFmus;
+        static std::mutex _knownFmusMutex;
+        /// Serializes the parsing of modelDescription files.
+        static std::mutex _parserMutex;
 
         FMU * _fmu;
         fmiComponent _component;
@@ -80,35 +99,35 @@ namespace FMI
          * Returns StartValue
          */
         template<typename T>
-        void addVariable(ScalarVariable * variable)
+        void addVariable(const ModelVariable & variable, FmuTypeInfo & info)
         {
-            ValueStatus vs;
-            T res = getStartValue<T>(variable, vs);
-            size_type valueReference = getValueReference(variable);
-            VarCausality varCausality = getVariableCausality(variable);
-            string_type varName = string_type(getName((void*) variable));
+            ValueStatus vs = variable.startStatus;
+            T res = getStartValue<T>(variable);
+            size_type valueReference = variable.valueReference;
+            VarCausality varCausality = variable.causality;
+            const string_type & varName = variable.name;
             if (vs == valueDefined || vs == ValueStatus::valueMissing)
             {
-                _valueInfo.addNameReferencePair<T>(varName, valueReference);
-                _allValueReferences.getValues<T>().push_back(valueReference);
+                info.valueInfo.addNameReferencePair<T>(varName, valueReference);
+                info.allValueReferences.getValues<T>().push_back(valueReference);
 
-                if (getAlias(variable) == Enu::enu_noAlias)
+                if (variable.alias == Enu::enu_noAlias)
                 {
-                    Enu variability = getVariability(variable);
+                    Enu variability = variable.variability;
                     // There are intentionally no breaks!
                     switch (variability)
                     {
                         case Enu::enu_BAD_DEFINED:
                             throw std::runtime_error("Variable contains illegal or missing vars");
                         case Enu::enu_continuous:
-                            _continousValueReferences.getValues<T>().push_back(valueReference);
+                            info.continousValueReferences.getValues<T>().push_back(valueReference);
                         case Enu::enu_discrete:
-                            _eventValueReferences.getValues<T>().push_back(valueReference);
+                            info.eventValueReferences.getValues<T>().push_back(valueReference);
                         case Enu::enu_parameter:
                             if (vs == ValueStatus::valueDefined)
                             {
-                                _startValueReferences.getValues<T>().push_back(valueReference);
-                                _startValues.getValues<T>().push_back(res);
+                                info.startValueReferences.getValues<T>().push_back(valueReference);
+                                info.startValues.getValues<T>().push_back(res);
                             }
                             //else
                             //  _startValues.getValues<T>().push_back(0);
@@ -124,13 +143,13 @@ namespace FMI
             switch (varCausality)
             {
                 case VarCausality::varCausalityInput:
-                    _valueInfo.addInputNameReferencePair<T>(varName, valueReference);
-                    _inputValueReferences.getValues<T>().push_back(valueReference);
+                    info.valueInfo.addInputNameReferencePair<T>(varName, valueReference);
+                    info.inputValueReferences.getValues<T>().push_back(valueReference);
                     //_startValueReferences.getValues<T>().push_back(valueReference);
                     //_startValues.getValues<T>().push_back(std::numeric_limits<T>::max());
                     break;
                 case VarCausality::varCausalityOutput:
-                    _outputValueReferences.getValues<T>().push_back(valueReference);
+                    info.outputValueReferences.getValues<T>().push_back(valueReference);
                     break;
                 default:
                     ;
@@ -138,23 +157,23 @@ namespace FMI
         }
 
         template<typename T>
-        T getStartValue(ScalarVariable * variable, ValueStatus & vs)
+        T getStartValue(const ModelVariable & variable)
         {
             throw runtime_error("FmuSdk: Unkown type for start value.");
         }
     };
 
     template<>
-    real_type FmuSdkFmu::getStartValue<real_type>(ScalarVariable * variable, ValueStatus & vs);
+    real_type FmuSdkFmu::getStartValue<real_type>(const ModelVariable & variable);
 
     template<>
-    int_type FmuSdkFmu::getStartValue<int_type>(ScalarVariable * variable, ValueStatus & vs);
+    int_type FmuSdkFmu::getStartValue<int_type>(const ModelVariable & variable);
 
     template<>
-    bool_type FmuSdkFmu::getStartValue<bool_type>(ScalarVariable * variable, ValueStatus & vs);
+    bool_type FmuSdkFmu::getStartValue<bool_type>(const ModelVariable & variable);
 
     template<>
-    string_type FmuSdkFmu::getStartValue<string_type>(ScalarVariable * variable, ValueStatus & vs);
+    string_type FmuSdkFmu::getStartValue<string_type>(const ModelVariable & variable);
 
 } /* namespace FMI */
 
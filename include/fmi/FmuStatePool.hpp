@@ -0,0 +1,75 @@
+/** @addtogroup FMI
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_FMI_FMUSTATEPOOL_HPP_
+#define INCLUDE_FMI_FMUSTATEPOOL_HPP_
+
+#include "Stdafx.hpp"
+#include "fmi/FmuEventInfo.hpp"
+#include "fmi/ValueCollection.hpp"
+
+namespace FMI
+{
+
+    /**
+     * A saved state of a FMU. FMUs which can save their internal state keep it in the handle. The others are emulated
+     * by the continuous states and the values of the FMU.
+     */
+    struct FmuSnapshot
+    {
+        real_type time;
+        FmuEventInfo eventInfo;
+        vector<real_type> states;
+        ValueCollection values;
+        /// State owned by the FMU, e.g., a fmi2FMUstate.
+        void * handle;
+    };
+
+    /**
+     * Recycles the snapshots of a FMU. A released snapshot keeps its memory and its handle, so the next saved state
+     * reuses them, e.g., fmi2GetFMUstate overwrites a given state instead of allocating a new one.
+     */
+    class FmuStatePool
+    {
+     public:
+        FmuStatePool();
+
+        /**
+         * @return Id of an unused snapshot, which is valid until it is released.
+         */
+        size_type acquire();
+
+        void release(const size_type & id);
+
+        FmuSnapshot & get(const size_type & id);
+
+        const FmuSnapshot & get(const size_type & id) const;
+
+        bool_type isUsed(const size_type & id) const;
+
+        /**
+         * @return Number of allocated snapshots, used or not. The ids are 0 ... size()-1.
+         */
+        size_type size() const;
+
+        /**
+         * Drops all snapshots, used or not.
+         * @param freeHandle Called for every snapshot with a handle.
+         */
+        void clear(const std::function<void(FmuSnapshot &)> & freeHandle);
+
+     private:
+        /// A deque, so references to snapshots stay valid when the pool grows.
+        deque<FmuSnapshot> _snapshots;
+        vector<bool_type> _used;
+        vector<size_type> _unused;
+    };
+
+} /* namespace FMI */
+
+#endif /* INCLUDE_FMI_FMUSTATEPOOL_HPP_ */
+/**
+ * @}
+ */
@@ -0,0 +1,60 @@
+/** @addtogroup FMI
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_FMI_FMUTYPEINFO_HPP_
+#define INCLUDE_FMI_FMUTYPEINFO_HPP_
+
+#include "Stdafx.hpp"
+#include "fmi/ValueCollection.hpp"
+#include "fmi/ValueInfo.hpp"
+#include "fmi/ValueReferenceCollection.hpp"
+
+namespace FMI
+{
+
+    /**
+     * The metadata of a FMU type, read from its modelDescription. It is built once per FMU and shared by all of its
+     * instances, so it mustn't be changed after it is handed to an instance.
+     */
+    struct FmuTypeInfo
+    {
+        FmuTypeInfo()
+                : defaultStartTime(0.0),
+                  defaultStopTime(0.0),
+                  numberOfStates(0),
+                  numberOfEventIndicators(0)
+        {
+        }
+
+        string_type modelIdentifier;
+        string_type guid;
+        real_type defaultStartTime;
+        real_type defaultStopTime;
+
+        ValueInfo valueInfo;
+
+        ValueReferenceCollection allValueReferences;  // containing every variable
+        ValueReferenceCollection startValueReferences;  // all - constant vars
+        ValueReferenceCollection eventValueReferences;  // start - parameter vars
+        ValueReferenceCollection continousValueReferences;  // event - discrete vars
+
+        /// Defaults of the instances, which may change them.
+        ValueReferenceCollection outputValueReferences;
+        ValueReferenceCollection inputValueReferences;
+
+        ValueCollection startValues;
+
+        size_type numberOfStates;
+        size_type numberOfEventIndicators;
+    };
+
+    typedef shared_ptr<const FmuTypeInfo> FmuTypeInfoSPtr;
+
+} /* namespace FMI */
+
+#endif /* INCLUDE_FMI_FMUTYPEINFO_HPP_ */
+/**
+ * @}
+ */
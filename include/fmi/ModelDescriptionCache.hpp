@@ -0,0 +1,103 @@
+/** @addtogroup FMI
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_FMI_MODELDESCRIPTIONCACHE_HPP_
+#define INCLUDE_FMI_MODELDESCRIPTIONCACHE_HPP_
+
+#include <cstdint>
+
+#include "Stdafx.hpp"
+#include <xml_parser.h>
+
+namespace FMI
+{
+
+    /**
+     * A scalar variable of a FMI 1.0 modelDescription, as far as FmuSdkFmu uses it. Only the start value of the
+     * variable's type is set.
+     */
+    struct ModelVariable
+    {
+        string_type name;
+        size_type valueReference;
+        VarType type;
+        VarCausality causality;
+        Enu variability;
+        Enu alias;
+        ValueStatus startStatus;
+        real_type realStart;
+        int_type intStart;
+        bool_type boolStart;
+        string_type stringStart;
+    };
+
+    /**
+     * The parts of a FMI 1.0 modelDescription needed to load and instantiate the FMU.
+     */
+    struct ModelDescriptionTable
+    {
+        string_type modelIdentifier;
+        string_type guid;
+        real_type defaultStartTime;
+        real_type defaultStopTime;
+        size_type numberOfStates;
+        size_type numberOfEventIndicators;
+        vector<ModelVariable> variables;
+    };
+
+    /**
+     * Keeps the variable table of a modelDescription.xml in a compact binary file next to it, so FMUs with many
+     * variables are loaded without parsing the XML again. The file stores the size, the modification time and the
+     * hash of the XML file. It is valid as long as the size matches and either the modification time or, if the XML
+     * was touched since, the hash matches. So on a hit the XML is only stat'ed, not read. The file is memory mapped
+     * and read in one pass. It is written in native byte order and only read by machines with the same byte order and
+     * word size, others rewrite it.
+     */
+    class ModelDescriptionCache
+    {
+        ModelDescriptionCache() = delete;
+        ModelDescriptionCache(const ModelDescriptionCache &) = delete;
+     public:
+        /// Name of the binary file in the directory of the extracted FMU.
+        static const char * const fileName;
+
+        /**
+         * Reads the table of the FMU extracted to the given directory.
+         * @param extractedPath The directory of the extracted FMU, ending with a slash.
+         * @param table Is filled, if the cache is valid.
+         * @return False, if there is no valid binary file for the current modelDescription.xml.
+         */
+        static bool read(const string_type & extractedPath, ModelDescriptionTable & table);
+
+        /**
+         * Stores the table of the FMU extracted to the given directory. The file is replaced atomically, so concurrent
+         * processes read either the old or the new file. If the directory isn't writable, the table isn't stored.
+         */
+        static void write(const string_type & extractedPath, const ModelDescriptionTable & table);
+
+        /**
+         * Converts a modelDescription parsed by the FMU SDK.
+         */
+        static ModelDescriptionTable fromModelDescription(ModelDescription * modelDescription);
+
+     private:
+        /**
+         * Gets the size and the modification time in nanoseconds of the modelDescription.xml of the FMU.
+         * @return False, if the file doesn't exist.
+         */
+        static bool statXml(const string_type & extractedPath, std::uint64_t & size, std::int64_t & modificationTime);
+
+        /**
+         * @return Hash of the content of the modelDescription.xml of the FMU.
+         */
+        static std::uint64_t hashXml(const string_type & extractedPath);
+    };
+
+} /* namespace FMI */
+
+#endif /* INCLUDE_FMI_MODELDESCRIPTIONCACHE_HPP_ */
+/**
+ * @}
+ */
@@ -0,0 +1,99 @@
+/** @addtogroup FMI
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_FMI_NATIVEFMU_HPP_
+#define INCLUDE_FMI_NATIVEFMU_HPP_
+
+#include <mutex>
+
+#include "fmi/AbstractFmu.hpp"
+#include "fmi/NativeModel.hpp"
+
+namespace FMI
+{
+
+    /**
+     * Simulates a NativeModel compiled into the program (loader "native"), so the scheduling, communication and
+     * writing can be benchmarked without building FMUs. The path of the FMU plan selects the model and its parameters,
+     * e.g., "synthetic?states=100&stiffness=1000&eventPeriod=0.5&inputs=4&outputs=4". FMUs of the same path share
+     * their metadata.
+     */
+    class NativeFmu : public AbstractFmu
+    {
+     public:
+
+        using AbstractFmu::getValuesInternal;
+        using AbstractFmu::setValuesInternal;
+
+        NativeFmu(const Initialization::FmuPlan & in);
+
+        NativeFmu() = delete;
+
+        virtual ~NativeFmu();
+
+        void load(const bool & alsoInit = true) override;
+        void unload() override;
+        void initialize() override;
+
+        AbstractFmu * duplicate() override;
+
+        void stepCompleted() override;
+        FmuEventInfo eventUpdate() override;
+
+        void setTime(const double & time) override;
+        double getDefaultStart() const override;
+        double getDefaultStop() const override;
+
+     protected:
+
+        void getStatesInternal(real_type * states) const override;
+        void setStatesInternal(const real_type * states) override;
+        void getStateDerivativesInternal(real_type * stateDerivatives) override;
+        void getEventIndicatorsInternal(real_type * eventIndicators) override;
+
+        void getValuesInternal(vector<real_type> & out, const vector<size_type> & references) const override;
+        void getValuesInternal(vector<int_type> & out, const vector<size_type> & references) const override;
+        void getValuesInternal(vector<bool_type> & out, const vector<size_type> & references) const override;
+        void getValuesInternal(vector<string_type> & out, const vector<size_type> & references) const override;
+
+        void setValuesInternal(const vector<real_type> & in, const vector<size_type> & references) override;
+        void setValuesInternal(const vector<int_type> & in, const vector<size_type> & references) override;
+        void setValuesInternal(const vector<bool_type> & in, const vector<size_type> & references) override;
+        void setValuesInternal(const vector<string_type> & in, const vector<size_type> & references) override;
+
+     private:
+        /// Metadata of the loaded models by path. Guarded by _typeInfosMutex.
+        static map<string_type, weak_ptr<const FmuTypeInfo>> _typeInfos;
+        static std::mutex _typeInfosMutex;
+
+        /// Empty, until the FMU is loaded.
+        shared_ptr<NativeModel> _model;
+
+        /**
+         * Returns the metadata of the model, which is created by the first instance of the path.
+         */
+        FmuTypeInfoSPtr shareTypeInfo(const string_type & path, const NativeModel & model);
+
+        template<typename T>
+        void readValues(vector<T> & out, const vector<size_type> & references, const vector<T> & values) const
+        {
+            for (size_type i = 0; i < references.size(); ++i)
+                out[i] = values.at(references[i]);
+        }
+
+        template<typename T>
+        void writeValues(const vector<T> & in, const vector<size_type> & references, vector<T> & values)
+        {
+            for (size_type i = 0; i < references.size(); ++i)
+                values.at(references[i]) = in[i];
+        }
+    };
+
+} /* namespace FMI */
+
+#endif /* INCLUDE_FMI_NATIVEFMU_HPP_ */
+/**
+ * @}
+ */
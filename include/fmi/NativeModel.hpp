@@ -0,0 +1,127 @@
+/** @addtogroup FMI
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_FMI_NATIVEMODEL_HPP_
+#define INCLUDE_FMI_NATIVEMODEL_HPP_
+
+#include "Stdafx.hpp"
+#include "fmi/FmuTypeInfo.hpp"
+#include <xml_parser.h>
+
+namespace FMI
+{
+
+    /**
+     * A model exchange model compiled into the program, which NativeFmu (loader "native") simulates without a FMU
+     * file. The variables are kept in one vector per type and the value reference of a variable is its index. The
+     * continuous states are the first real variables.
+     */
+    class NativeModel
+    {
+     public:
+        typedef std::function<NativeModel * (const map<string_type, real_type> & parameters)> Factory;
+
+        NativeModel(const size_type & numStates, const size_type & numEventIndicators);
+
+        virtual ~NativeModel() = default;
+
+        /**
+         * Adds the variables, their start values and the numbers of states and event indicators to the type info.
+         */
+        virtual void describe(FmuTypeInfo & info) const = 0;
+
+        virtual void getDerivatives(real_type * derivatives) const = 0;
+
+        virtual void getEventIndicators(real_type * eventIndicators) const = 0;
+
+        /**
+         * Handles the event at the current time.
+         * @return True, if the states were changed.
+         */
+        virtual bool_type eventUpdate() = 0;
+
+        /**
+         * Updates the variables computed from the states, the inputs and the time.
+         */
+        virtual void computeOutputs() = 0;
+
+        real_type getTime() const;
+
+        void setTime(const real_type & time);
+
+        size_type getNumStates() const;
+
+        size_type getNumEventIndicators() const;
+
+        vector<real_type> & getReals();
+
+        vector<int_type> & getInts();
+
+        vector<bool_type> & getBools();
+
+        vector<string_type> & getStrings();
+
+        /**
+         * Makes a model available for the loader "native". Models have to be registered before the FMUs are loaded.
+         * The model "synthetic" is always available.
+         */
+        static void registerModel(const string_type & name, const Factory & factory);
+
+        /**
+         * Creates a model from the path of a FMU plan, which is the name of the model followed by the numerical
+         * parameters in the form "name?parameter=value&parameter=value".
+         * @throw runtime_error If the model isn't registered or a parameter isn't a number.
+         */
+        static NativeModel * create(const string_type & path);
+
+     protected:
+        real_type _time;
+        size_type _numStates;
+        size_type _numEventIndicators;
+
+        vector<real_type> _reals;
+        vector<int_type> _ints;
+        vector<bool_type> _bools;
+        vector<string_type> _strings;
+
+        /**
+         * Adds the variable of type T with the value reference valueReference to the type info. Its start value is
+         * the current value.
+         * @param continuous True for continuous variables, false for discrete ones.
+         */
+        template<typename T>
+        void addVariable(FmuTypeInfo & info, const string_type & name, const size_type & valueReference,
+                         const T & start, const bool_type & continuous, const VarCausality & causality =
+                                 VarCausality::varCausalityInternal) const
+        {
+            info.valueInfo.addNameReferencePair<T>(name, valueReference);
+            info.allValueReferences.getValues<T>().push_back(valueReference);
+            if (continuous)
+                info.continousValueReferences.getValues<T>().push_back(valueReference);
+            info.eventValueReferences.getValues<T>().push_back(valueReference);
+            info.startValueReferences.getValues<T>().push_back(valueReference);
+            info.startValues.getValues<T>().push_back(start);
+            if (causality == VarCausality::varCausalityInput)
+            {
+                info.valueInfo.addInputNameReferencePair<T>(name, valueReference);
+                info.inputValueReferences.getValues<T>().push_back(valueReference);
+            }
+            else if (causality == VarCausality::varCausalityOutput)
+                info.outputValueReferences.getValues<T>().push_back(valueReference);
+        }
+
+     private:
+        /**
+         * Registered models by name, initialized with the built-in models on first use.
+         */
+        static map<string_type, Factory> & getFactories();
+    };
+
+} /* namespace FMI */
+
+#endif /* INCLUDE_FMI_NATIVEMODEL_HPP_ */
+/**
+ * @}
+ */
@@ -42,17 +42,19 @@ namespace FMI
 
         size_type size() const;
 
+        /**
+         * Looks up the value reference of a variable in constant time.
+         * @return The value reference or std::numeric_limits<size_type>::max(), if there's no variable of type T with
+         * the given name. If several references share the name, the smallest one is returned.
+         */
         template<typename T>
         size_type getReference(const std::string & varName) const
         {
-            const map<size_type, vector<string_type>> & values = _valueReferenceToNamesMapping[dataIndex<T>()];
-            for(const auto & p : values)
-            {
-                for(const auto name : p.second)
-                    if(name == varName)
-                        return p.first;
-            }
-            return std::numeric_limits<size_type>::max();
+            const unordered_map<string_type, size_type> & names = _nameToValueReferenceMapping[dataIndex<T>()];
+            auto iter = names.find(varName);
+            if (iter == names.end())
+                return std::numeric_limits<size_type>::max();
+            return iter->second;
         }
 
         template<typename T>
@@ -70,6 +72,11 @@ namespace FMI
             }
             else
                 iter->second.push_back(name);
+
+            auto nameIter = _nameToValueReferenceMapping[dataIndex<T>()].insert(
+                    pair<string_type, size_type>(name, valueReference)).first;
+            if (valueReference < nameIter->second)
+                nameIter->second = valueReference;
         }
 
         template<typename T>
@@ -135,6 +142,8 @@ namespace FMI
         vector<map<size_type, vector<string_type>>> _valueReferenceToNamesMapping;
         vector<map<size_type, string_type>> _valueInputReferenceToNamesMapping;
         vector<map<size_type, vector<string_type>>> _valueReferenceToDescriptionMapping;
+        /// Index of _valueReferenceToNamesMapping by name, so name lookups don't scan all variables.
+        vector<unordered_map<string_type, size_type>> _nameToValueReferenceMapping;
     };
 
 } /* namespace FMI */
@@ -0,0 +1,114 @@
+/** @addtogroup FMI
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_FMI_VALUESUBSET_HPP_
+#define INCLUDE_FMI_VALUESUBSET_HPP_
+
+#include <algorithm>
+
+#include "Stdafx.hpp"
+#include "fmi/InputMapping.hpp"
+#include "fmi/ValueReferenceCollection.hpp"
+#include "fmi/ValueSwitch.hpp"
+
+namespace FMI
+{
+
+    /**
+     * Selects some variables of the collection of all values of a FMU, e.g., the outputs read by connections. The
+     * indices in the collection are kept sorted together with their value references, so the subset is read from the
+     * FMU by one call per type and scattered into the collection.
+     */
+    class ValueSubset : protected ValueSwitch
+    {
+     public:
+        /**
+         * Create an empty subset.
+         * @param allReferences The references of all values of the FMU, which the indices refer to.
+         */
+        ValueSubset(const ValueReferenceCollection & allReferences = ValueReferenceCollection());
+
+        ValueSubset(const ValueSubset & in);
+
+        virtual ~ValueSubset() = default;
+
+        ValueSubset & operator=(const ValueSubset & in);
+
+        /**
+         * Adds the variable of type T at the given index of the collection of all values. Adding it twice has no
+         * effect.
+         */
+        template<typename T>
+        void add(const size_type & index)
+        {
+            const vector<size_type> & allReferences = _allReferences.getValues<T>();
+            if (index >= allReferences.size())
+                throw runtime_error("ValueSubset: Index " + to_string(index) + " out of range.");
+            vector<size_type> & indices = _indices[dataIndex<T>()];
+            vector<size_type>::iterator pos = std::lower_bound(indices.begin(), indices.end(), index);
+            if (pos != indices.end() && *pos == index)
+                return;
+            vector<size_type> & references = _references.getValues<T>();
+            references.insert(references.begin() + (pos - indices.begin()), allReferences[index]);
+            indices.insert(pos, index);
+        }
+
+        /**
+         * Adds the output variables of the mapping, i.e., the ones it packs.
+         */
+        void addOutputs(const InputMapping & mapping);
+
+        /**
+         * Adds the input variables of the mapping, i.e., the ones it unpacks into.
+         */
+        void addInputs(const InputMapping & mapping);
+
+        /**
+         * @return The sorted indices of the variables of type T in the collection of all values.
+         */
+        template<typename T>
+        const vector<size_type> & getIndices() const
+        {
+            return _indices[dataIndex<T>()];
+        }
+
+        /**
+         * @return The value references of the variables, in the order of their indices.
+         */
+        const ValueReferenceCollection & getReferences() const;
+
+        /**
+         * @return True, if every variable of type T is selected, so the collection can be read as a whole.
+         */
+        template<typename T>
+        bool_type isComplete() const
+        {
+            return _indices[dataIndex<T>()].size() == _allReferences.getValues<T>().size();
+        }
+
+        /**
+         * @return The number of selected variables.
+         */
+        size_type size() const;
+
+     private:
+        ValueReferenceCollection _allReferences;
+        ValueReferenceCollection _references;
+        vector<vector<size_type>> _indices;
+
+        template<typename T>
+        void addMapping(const InputMapping & mapping, const bool_type & outputs)
+        {
+            for (const tuple<size_type, size_type> & con : mapping.getValues<T>())
+                add<T>((outputs) ? get<0>(con) : get<1>(con));
+        }
+    };
+
+} /* namespace FMI */
+
+#endif /* INCLUDE_FMI_VALUESUBSET_HPP_ */
+/**
+ * @}
+ */
@@ -13,12 +13,15 @@
 
 #include "fmi/AbstractFmu.hpp"
 #include "fmi/FmuSdkFmu.hpp"
+#include "fmi/NativeFmu.hpp"
 #ifdef USE_FMILIB
 #include "fmi/FmiLibFmu.hpp"
+#include "fmi/Fmi2LibFmu.hpp"
 #endif
 
 #include "solver/Euler.hpp"
 #include "solver/Ros2.hpp"
+#include "solver/CoSimulation.hpp"
 
 #include "writer/CSVFileWriter.hpp"
 #include "writer/MatFileWriter.hpp"
@@ -29,8 +32,10 @@
 
 #include "synchronization/DataManager.hpp"
 #include "synchronization/SerialConnection.hpp"
+#include "synchronization/SHMConnection.hpp"
 #include "synchronization/SerialDataHistory.hpp"
 #include "simulation/SerialSimulation.hpp"
+#include "simulation/TaskSimulation.hpp"
 
 #ifdef USE_OPENMP
 #include "synchronization/openmp/OpenMPConnection.hpp"
@@ -40,6 +45,8 @@
 
 #ifdef USE_MPI
 #include "synchronization/mpi/MPIConnection.hpp"
+#include "synchronization/mpi/MPIRMAConnection.hpp"
+#include "synchronization/mpi/MPISHMConnection.hpp"
 #endif
 
 #ifdef USE_NETWORK_OFFLOADER
@@ -77,6 +84,10 @@ namespace Initialization
             {
                 res = new Solver::Ros2<DataManagerClass, FmuClass>(in, FmuClass(*in.fmu), dm);
             }
+            else if (in.kind == "cosim")
+            {
+                res = new Solver::CoSimulation<DataManagerClass, FmuClass>(in, FmuClass(*in.fmu), dm);
+            }
             else
             {
                 throw runtime_error("MainFactory: Unknown solver type " + in.kind);
@@ -94,11 +105,19 @@ namespace Initialization
             {
                 res = createSolverWithKnownFmu<DataManagerClass, FMI::FmuSdkFmu>(dm, in);
             }
+            else if (in.fmu->loader == "native")
+            {
+                res = createSolverWithKnownFmu<DataManagerClass, FMI::NativeFmu>(dm, in);
+            }
 #ifdef USE_FMILIB
             else if (in.fmu->loader == "fmiLib")
             {
                 res = createSolverWithKnownFmu<DataManagerClass, FMI::FmiLibFmu>(dm, in);
             }
+            else if (in.fmu->loader == "fmi2")
+            {
+                res = createSolverWithKnownFmu<DataManagerClass, FMI::Fmi2LibFmu>(dm, in);
+            }
 #endif
 #ifdef USE_NETWORK_OFFLOADER
             else if (in.fmu->loader == "network")
@@ -0,0 +1,46 @@
+/*
+ * PlanSerializer.hpp
+ */
+
+#ifndef INCLUDE_INITIALIZATION_PLANSERIALIZER_HPP_
+#define INCLUDE_INITIALIZATION_PLANSERIALIZER_HPP_
+
+#include "initialization/Plans.hpp"
+
+namespace Initialization
+{
+
+    /**
+     * Packs plans into one compact binary buffer and back, so the MPI process reading the configuration can
+     * distribute them with a single broadcast.
+     * ConnectionPlans are shared between the solvers at both ends and the data managers. They are stored once and
+     * referenced by their id, so the unpacked plan shares them the same way. The communicator and the global virtual
+     * time of a node are created anew for every node of the unpacked plan.
+     * @note New fields of the plans have to be added here as well.
+     */
+    class PlanSerializer
+    {
+     public:
+
+        PlanSerializer() = delete;
+
+        static vector<char> serialize(const ProgramPlan & plan);
+
+        /**
+         * @throw runtime_error If the buffer is truncated.
+         */
+        static ProgramPlan deserializeProgramPlan(const vector<char> & buffer);
+
+#ifdef USE_NETWORK_OFFLOADER
+        /**
+         * Packs the FMU information of the plan. The server is only known by the process it runs on.
+         */
+        static vector<char> serialize(const Network::NetworkPlan & plan);
+
+        static Network::NetworkPlan deserializeNetworkPlan(const vector<char> & buffer);
+#endif
+    };
+
+} /* namespace Initialization */
+
+#endif /* INCLUDE_INITIALIZATION_PLANSERIALIZER_HPP_ */
@@ -24,6 +24,8 @@ namespace Initialization
         string name;
         string path;
         string workingPath;
+        /// Directory of the FMU extraction cache, the default one if empty.
+        string cachePath;
         string version;
 
         size_type id;
@@ -34,6 +36,8 @@ namespace Initialization
         real_type relTol;
 
         bool logEnabled;
+        /// The FMU is driven via doStep by the solver "cosim".
+        bool coSimulation;
 
         int solverId;
     };
@@ -42,6 +46,31 @@ namespace Initialization
     {
         string kind;
         size_type bufferSize;
+        /**
+         * Maximal number of entries and bytes coalesced into one message of a MPI connection.
+         */
+        size_type batchSize;
+        size_type maxBatchBytes;
+        /**
+         * Kind of the connection, if source and destination are on different nodes: "mpi" or "mpirma".
+         */
+        string remoteKind;
+        /**
+         * If true, a "mpi" or "mpirma" connection between ranks of the same node is turned into a "mpishm" connection,
+         * unless it uses batching or delta encoding.
+         */
+        bool sharedMemory;
+        /**
+         * Encoding of the entries of a "mpi" connection: "full" or "delta". With "delta" only values which changed
+         * since the last sent value are sent, reals only if they differ by more than their deadband.
+         */
+        string encoding;
+        /// Deadband of every connected real variable, in the order of the real mapping.
+        vector<real_type> deadbands;
+        /**
+         * Byte offset of the ring of a "mpishm" connection in the shared memory segment of the destination rank.
+         */
+        size_type shmOffset;
 
         size_type sourceRank;
         size_type destRank;
@@ -49,6 +78,9 @@ namespace Initialization
         string sourceFmu;
         string destFmu;
 
+        /// Unique number of the connection in the program.
+        size_type id;
+        /// Number of the connection among the MPI connections between its two ranks, see MPIChannels.
         size_type startTag;
 
         FMI::InputMapping inputMapping;
@@ -126,11 +158,21 @@ namespace Initialization
      * == solverIdToCore ==
      * This structure holds for all solvers on which node and core a particular solver runs.
      * For example, solverIdToCore[0] = (1, 3) means, that solver with ID 0 runs on core 3 of node 1.
+     *
+     * == coreToCpu ==
+     * Has the same node/core layout as nodeStructure and holds the physical CPU a core (i.e., the thread simulating
+     * it) is pinned to. A negative value means the thread isn't pinned.
+     *
+     * == implicitCpu ==
+     * Has the same layout as coreToCpu and is true for the cores, which "pinThreads" pinned to their index in the node,
+     * since the configuration didn't give an explicit CPU.
      */
     struct SchedulePlan
     {
         vector<vector<vector<size_type>>> nodeStructure;     ///< node -> core -> solverIDs
         vector<tuple<size_type, size_type>> solverIdToCore;  ///< solverID -> (node,core)
+        vector<vector<int>> coreToCpu;                       ///< node -> core -> physical CPU
+        vector<vector<bool>> implicitCpu;                    ///< node -> core -> CPU is the index of the core
     };
 
     /*! \brief A SimulationPlan holds the settings for a particular simulation.
@@ -147,6 +189,30 @@ namespace Initialization
         real_type defaultMaxError;
         real_type defaultTolerance;
 
+        /// Physical CPU the simulation thread is pinned to. Negative, if the thread isn't pinned.
+        int cpuId;
+        /// True, if cpuId is only the index of the core in its node. MPI processes sharing a machine offset it by
+        /// the cores of the processes before them on the machine.
+        bool implicitCpu;
+
+        /// Number of polls of a thread with only blocked solvers before it is parked.
+        size_type idleSpins;
+        /// Maximal time in seconds a parked thread sleeps before polling remote connections again.
+        real_type maxIdleParkTime;
+        /// Maximal number of steps a solver does per solve call.
+        size_type maxSolveQuantum;
+
+        /// "free": every solver runs as far as its inputs allow. "gaussSeidel": all solvers of a core advance in
+        /// macro steps, consumers after their producers.
+        string coupling;
+        /// Length of a macro step in the Gauss-Seidel coupling.
+        real_type macroStepSize;
+
+        /// Number of iterations between two reports of the solver times to the global virtual time.
+        size_type globalTimeInterval;
+        /// Global virtual time, shared by all simulations of a node.
+        Synchronization::GlobalVirtualTimeSPtr globalTime;
+
         DataManagerPlan dataManager;
     };
 
@@ -161,6 +227,8 @@ namespace Initialization
     {
         //vec2D represents node/thread mapping. simPlans[nodeNum][threadNum]
         vector<vector<SimulationPlan>> simPlans; //for mpi
+        /// If true, every core of the node is simulated by an own worker process instead of a thread.
+        bool useProcesses;
     };
 
 } // namespace Initialization
@@ -12,6 +12,8 @@
 #include "CommandLineArgs.hpp"
 #include "Plans.hpp"
 
+#include <sys/types.h>
+
 namespace Initialization
 {
 
@@ -32,8 +34,8 @@ namespace Initialization
         virtual ~Program();
 
         /** \brief Initializes the program.
-         * The ProgramPlan is created from the configuration file.
-         * MPI is initialized, if used.
+         * MPI is initialized, if the program was launched with several MPI processes or the plan uses several nodes.
+         * The ProgramPlan is created from the configuration file by the first MPI process and broadcasted.
          * Network connection is established, if ParallelFMU is used as server.
          * The simulations are created (but not initialized!).
          */
@@ -43,7 +45,9 @@ namespace Initialization
 
         /** \brief Runs the simulations.
          *
-         * The simulations are initialized and than run/executed.
+         * Every simulation thread is pinned to the CPU given by the scheduling, initializes its own simulation and
+         * than runs/executes it. If the scheduling requests processes, every simulation is run by a forked worker
+         * process instead.
          */
         void simulate();
 
@@ -67,6 +71,9 @@ namespace Initialization
         bool _usingMPI;
         bool _usingOMP;
 
+        /*! \brief Thread support level provided by MPI_Init_thread. */
+        int _mpiThreadLevel;
+
         CommandLineArgs _commandLineArgs;
         ProgramPlan _progPlan;
 
@@ -80,9 +87,69 @@ namespace Initialization
          */
         bool initMPI(int & rank, int & numRanks);
 
+        /*! \brief Throws, if MPI doesn't support the threads of the plan.
+         *
+         * Several simulation threads of a process call MPI concurrently, e.g., by their connections and the global
+         * virtual time, which needs MPI_THREAD_MULTIPLE. A single simulation thread needs MPI_THREAD_FUNNELED.
+         */
+        void checkMPIThreadLevel() const;
+
+        /*! \brief Offsets the CPUs, which "pinThreads" gave the cores of the process, by the cores of the processes
+         * before it on the same machine.
+         *
+         * Otherwise all processes of a machine pin their i-th core to the same CPU. Needs to be called by all
+         * processes.
+         *
+         * \param rank The MPI rank of the process.
+         */
+        void offsetImplicitCpus(const int & rank);
+
+        /*! \brief Returns the number of processes started by the MPI launcher, read from its environment variables.
+         *
+         * Returns 1, if the program wasn't started by a known launcher.
+         */
+        static int getNumLaunchedRanks();
+
+        /*! \brief Distributes the ProgramPlan of the first MPI process to all others.
+         *
+         * The plan is packed into one buffer by PlanSerializer, so the other processes neither parse the configuration
+         * file nor need more than one broadcast.
+         */
+        void broadcastProgramPlan(const int & rank);
+
+        /*! \brief Broadcasts the buffer of the first MPI process. The buffers of the others are resized. */
+        static void broadcast(vector<char> & buffer);
+
         bool initNetworkConnection(const int & rank);
 
+        /*! \brief Sets up everything the MPI connections need collectively, after the plan is complete.
+         *
+         * Connections between ranks of the same node are turned into shared memory connections, the tags and
+         * communicators of the remaining MPI connections are assigned and the window for one-sided connections is
+         * created.
+         */
+        void initMPIConnections(const int & rank);
+
         void deinitMPI();
+
+        /*! \brief Loads and instantiates the FMUs of all simulations.
+         *
+         * If the scheduling pins the simulations to CPUs, every simulation thread pins itself before it loads the FMUs
+         * of its simulation, so their memory is placed on the NUMA node of the CPU running them. Otherwise, one thread
+         * pool loads all FMUs.
+         */
+        void loadFmus();
+
+        /*! \brief Forks one worker process per simulation and waits for them.
+         *
+         * Used for FMUs, which aren't thread-safe. Every worker initializes and runs its simulation. Connections between
+         * the workers use the shared memory segment of SHMConnection. If a worker fails, the others are terminated.
+         */
+        void simulateInProcesses();
+
+        /*! \brief Terminates the given worker processes and waits for them.
+         */
+        static void stopWorkers(const vector<pid_t> & workers);
     };
 
 } /* namespace Initialization */
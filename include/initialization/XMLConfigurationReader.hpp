@@ -67,7 +67,13 @@ namespace Initialization
 
         list<ConnectionPlan> getConnectionPlans();
 
-        vector<vector<size_type>> getNodeSchedule(ptree::value_type & nodeElem);
+        /*! \brief Reads the cores of a single node of the scheduling.
+         *
+         * @param nodeElem The node element of the configuration file.
+         * @param cpus     Is extended by the physical CPU of each read core (-1 if the core isn't pinned).
+         * @return         core -> solver slots of the node.
+         */
+        vector<vector<size_type>> getNodeSchedule(ptree::value_type & nodeElem, vector<int> & cpus);
 
         SchedulePlan getSchedulePlan();
 
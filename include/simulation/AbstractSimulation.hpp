@@ -36,10 +36,18 @@ namespace Simulation
         virtual void simulate() = 0;
 
         /**
-         * Initialize all solvers, data-managers and FMUs.
+         * Initialize all solvers, data-managers and FMUs. The FMUs are loaded in parallel by loadFmus() first, the
+         * solvers are registered at their data managers serially afterwards.
          */
         virtual void initialize();
 
+        /**
+         * Loads and instantiates the FMUs of the given solvers in parallel, if they aren't loaded yet. FMUs of the same
+         * type are extracted and parsed only once.
+         * @throw runtime_error The first error of a FMU, after all FMUs were tried.
+         */
+        static void loadFmus(const vector<shared_ptr<Solver::ISolver>> & solver);
+
         /**
          * Get all solvers that are part of the simulation.
          * @return The list of solvers that are connected to the simulation.
@@ -56,6 +64,12 @@ namespace Simulation
 
         void setMaxIterations(const size_type num);
 
+        /**
+         * Returns the physical CPU the thread running the simulation should be pinned to.
+         * @return The CPU id or a negative value, if the simulation thread shouldn't be pinned.
+         */
+        int getCpuId() const;
+
         /**
          * Returns if a simulation is a MPI, OpenMP or Serial simulation
          * @return string_type One of: {"serial", "openmp", "mpi"}
@@ -84,6 +98,11 @@ namespace Simulation
          * Maximal number of iterations that should be executed.
          */
         size_type _maxIterations;
+
+        /**
+         * Physical CPU the simulation thread is pinned to.
+         */
+        int _cpuId;
     };
 
 } /* namespace Simulation */
@@ -35,6 +35,12 @@ namespace Simulation
          */
         virtual ~SerialSimulation();
 
+        /**
+         * Initializes all solvers and orders them by their dependencies, i.e., producers are solved before
+         * their consumers.
+         */
+        void initialize() override;
+
         /**
          * As long as the simulation end time is not reached, this method calls
          * the solve methods (time integration) for all solvers.
@@ -46,6 +52,94 @@ namespace Simulation
          * @return string_type One of: {"serial", "openmp", "mpi"}
          */
         virtual string_type getSimulationType() const;
+
+        /**
+         * @return Indices of the solvers in the order they are solved, available after initialize().
+         */
+        const vector<size_type> & getSolveOrder() const;
+
+     protected:
+        /**
+         * Calculates how many steps a solver can do before it runs out of inputs, i.e., the distance between its
+         * current time and its input horizon divided by its step size.
+         * @param solver The solver to calculate the quantum for.
+         * @return The number of steps for the next solve call, between 1 and the maximal solve quantum.
+         */
+        size_type getSolveQuantum(const Solver::ISolver & solver) const;
+
+        /**
+         * Calls solve once for every solver in dependency order.
+         * @param progress Set to true, if at least one solver did an iteration.
+         * @return False, if the simulation has to be aborted.
+         */
+        bool_type solveAll(bool & progress);
+
+        /**
+         * Reports the time of the slowest solver of this simulation to the global virtual time every
+         * globalTimeInterval iterations.
+         * @param iterationCount Number of iterations done so far.
+         */
+        void reportGlobalTime(const size_type & iterationCount);
+
+        /**
+         * Called after all solvers of this simulation reached the end time. Keeps taking part in the reduction of
+         * the global virtual time until the solvers of all nodes are finished, so every process stops at the
+         * same reduction and no process finalizes MPI while others still send to it.
+         */
+        void waitForGlobalEnd();
+
+        /**
+         * Indices of the solvers in topological order of their connections.
+         */
+        vector<size_type> _solveOrder;
+
+        /**
+         * For every solver the indices of the solvers of this simulation consuming its outputs.
+         */
+        vector<vector<size_type>> _consumers;
+
+     private:
+        /**
+         * Upper bound of steps per solve call. Used for solvers without inputs.
+         */
+        size_type _maxSolveQuantum;
+
+        /**
+         * Coupling of the solvers: "free" or "gaussSeidel".
+         */
+        string_type _coupling;
+
+        /**
+         * Length of the macro steps in the Gauss-Seidel coupling.
+         */
+        real_type _macroStepSize;
+
+        /**
+         * Global virtual time shared by the simulations of this node.
+         */
+        Synchronization::GlobalVirtualTimeSPtr _globalTime;
+
+        /**
+         * Id of this simulation in _globalTime.
+         */
+        size_type _globalTimeId;
+
+        /**
+         * Number of iterations between two reports to _globalTime.
+         */
+        size_type _globalTimeInterval;
+
+        /**
+         * All solvers advance in macro steps. In each macro step the solvers are solved in dependency order up to
+         * the end of the macro step, so consumers use the values their producers calculated for this macro step.
+         */
+        void simulateGaussSeidel();
+
+        /**
+         * Creates _solveOrder from the connections of the FMUs. Connections to FMUs of other simulations are ignored.
+         * The in-connections, which close a dependency cycle, are delayed by one step (IDataManager::setDelayedInput).
+         */
+        void createSolveOrder();
     };
 
 } /* namespace Simulation */
@@ -0,0 +1,53 @@
+/** @addtogroup Simulation
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_SIMULATION_TASKSIMULATION_HPP_
+#define INCLUDE_SIMULATION_TASKSIMULATION_HPP_
+
+#include "Stdafx.hpp"
+#include "simulation/SerialSimulation.hpp"
+
+namespace Simulation
+{
+
+    /**
+     * This class represents a simulation, which treats its solvers as tasks. Instead of visiting all solvers
+     * round-robin, only ready solvers are solved. A solver blocked by its inputs is suspended until an entry arrives
+     * on one of its in-connections or one of its producers on the same core made progress. If no solver is ready,
+     * the thread sleeps until a connection of the node changes. Suspended solvers keep their continuation in the
+     * solver state, so they simply continue with the next solve call.
+     */
+    class TaskSimulation : public SerialSimulation
+    {
+     public:
+        TaskSimulation(const Initialization::SimulationPlan & in, const vector<shared_ptr<Solver::ISolver>> & solver);
+
+        virtual ~TaskSimulation();
+
+        /**
+         * Solves ready solvers, until all solvers reached the simulation end time.
+         */
+        void simulate() override;
+
+        /**
+         * Returns if a simulation is a MPI, OpenMP or Serial simulation
+         * @return string_type One of: {"serial", "openmp", "mpi", "task"}
+         */
+        string_type getSimulationType() const override;
+
+     private:
+        /**
+         * Moves all suspended solvers with new inputs to the ready queue. If none of them has new inputs, all are
+         * moved, since solvers can also be blocked by full out-connections.
+         */
+        void resumeSuspended(deque<size_type> & ready, set<size_type> & suspended);
+    };
+
+} /* namespace Simulation */
+
+#endif /* INCLUDE_SIMULATION_TASKSIMULATION_HPP_ */
+/**
+ * @}
+ */
@@ -100,10 +100,15 @@ namespace Solver
             _fmu.unload();
         }
 
-        virtual void initialize() override
+        virtual void loadFmu() override
         {
             if (!_fmu.isLoaded())
                 _fmu.load();
+        }
+
+        virtual void initialize() override
+        {
+            loadFmu();
 
             _dataManager->addFmu(&_fmu);
             _sEventInfo = SolverEventInfo();
@@ -216,13 +221,14 @@ namespace Solver
         /**
          * Time integration algorithm of the solver.
          * @param numSteps Number of steps to perform.
+         * @return The number of steps done. It is 0, if the solver is blocked by missing inputs or full out-connections.
          */
         virtual size_type solve(const size_type & numSteps = 1) override
         {
             std::cout << "AbstractSolver::solve()\n";
-            size_type count = 0, rCount = 0;
+            size_type count = 0;
 
-            while (!isFinished() && count++ < numSteps)
+            while (!isFinished() && count < numSteps)
             {
                 if (!_savedStep)
                 {
@@ -232,12 +238,19 @@ namespace Solver
                             if (_sEventInfo.eventOccured)
                             {
                                 doEventStepping();
+                                ++count;
                             }
                             else
                             {
                                 _savedStep = _dataManager->saveSolverStep(&_fmu, _stepInfo, getSolverOrder());
                                 if (_savedStep)
                                     _stepInfo.clear();
+                                else
+                                {
+                                    // the out-connections are full, the consumers wake the thread when they receive
+                                    _dataManager->flushOutputs(&_fmu);
+                                    return count;
+                                }
                             }
                             break;
                         case DependencyStatus::EVENT:
@@ -249,7 +262,9 @@ namespace Solver
                             break;
 
                         case DependencyStatus::BLOCKED:
-                            return rCount;
+                            // consumers might wait for outputs coalesced by the out-connections
+                            _dataManager->flushOutputs(&_fmu);
+                            return count;
                             break;
                         case DependencyStatus::ABORT_SIM:
                             return std::numeric_limits<size_type>::max();
@@ -271,8 +286,10 @@ namespace Solver
                     doSolverStepErrorHandled(std::min(_curStepSize, _endTime - _currentTime));
                     handleEvents();
                     _savedStep = false;
+                    ++count;
                 }
             }
+            _dataManager->flushOutputs(&_fmu);
             return count;
         }
 
@@ -380,6 +397,11 @@ namespace Solver
             return _eventCounter;
         }
 
+        real_type getInputHorizon() const override
+        {
+            return _dataManager->getInputHorizon(&_fmu);
+        }
+
      protected:
         /**
          * This struct provides information concerning events during solver steps.
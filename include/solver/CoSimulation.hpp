@@ -0,0 +1,225 @@
+/** @addtogroup Solver
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_SOLVER_COSIMULATION_HPP_
+#define INCLUDE_SOLVER_COSIMULATION_HPP_
+
+#include <thread>
+
+#include "solver/AbstractSolver.hpp"
+
+namespace Solver
+{
+
+    /**
+     * This class drives a co-simulation FMU, which integrates itself with its own solver, through its communication
+     * steps (solver kind "cosim"). The inputs are set at the beginning of every communication step and the outputs
+     * are sent at its end, so the FMU is coupled via the data manager like the FMUs of the other solvers.
+     * If the FMU can handle variable step sizes, a step ends where the known inputs end, if that is earlier than the
+     * default step size. A step which the FMU computes asynchronously doesn't block the calling thread; solve()
+     * returns and polls it on the next call.
+     */
+    template<class DataManagerClass, class FmuClass>
+    class CoSimulation : public AbstractSolver<DataManagerClass, FmuClass>
+    {
+     public:
+        typedef typename AbstractSolver<DataManagerClass, FmuClass>::vector1D vector1D;
+
+        CoSimulation(const Initialization::SolverPlan & in, const FmuClass & fmu, std::shared_ptr<DataManagerClass> & dm)
+                : AbstractSolver<DataManagerClass, FmuClass>(in, fmu, dm),
+                  _stepPending(false)
+        {
+        }
+
+        /**
+         * Aborts a pending communication step, before the FMU is unloaded.
+         */
+        virtual ~CoSimulation()
+        {
+            try
+            {
+                cancelPendingStep();
+            }
+            catch (const std::exception & ex)
+            {
+                LOGGER_WRITE(string_type("CoSimulation: ") + ex.what(), Util::LC_SOLVER, Util::LL_WARNING);
+            }
+        }
+
+        virtual void initialize() override
+        {
+            AbstractSolver<DataManagerClass, FmuClass>::initialize();
+            if (!_fmu.isCoSimulation())
+                throw runtime_error("CoSimulation: The FMU " + _fmu.getFmuName() + " isn't loaded for co-simulation.");
+        }
+
+        /**
+         * Alternates between sending the outputs, respectively setting the inputs, and communication steps.
+         * @param numSteps Number of communication steps to perform.
+         * @return The number of finished communication steps. It is 0, while a step is pending or the solver is
+         *         blocked.
+         */
+        virtual size_type solve(const size_type & numSteps = 1) override
+        {
+            Synchronization::IDataManager * dataManager = this->getDataManager();
+            size_type count = 0;
+
+            while (!this->isFinished() && count < numSteps)
+            {
+                if (_stepPending)
+                {
+                    FMI::CoSimulationStepStatus status = _fmu.getStepStatus();
+                    if (status == FMI::CoSimulationStepStatus::PENDING)
+                        break;  // the thread can solve other FMUs meanwhile
+                    finishStep(status);
+                    ++count;
+                }
+                else if (!_savedStep)
+                {
+                    switch ((_dependencyInfo = dataManager->getDependencyInfo(&_fmu)).depStatus)
+                    {
+                        case DependencyStatus::FREE:
+                            _savedStep = dataManager->saveSolverStep(&_fmu, _stepInfo, getSolverOrder());
+                            if (_savedStep)
+                                _stepInfo.clear();
+                            else
+                            {
+                                // the out-connections are full, the consumers wake the thread when they receive
+                                dataManager->flushOutputs(&_fmu);
+                                return count;
+                            }
+                            break;
+                        case DependencyStatus::EVENT:
+                            // the FMU can't go back to the event, it gets the inputs after the event on the next step
+                            LOGGER_WRITE("Input event at t0=" + to_string(_dependencyInfo.eventTimeStart),
+                                         Util::LC_SOLVER, Util::LL_DEBUG);
+                            ++_eventCounter;
+                            break;
+                        case DependencyStatus::BLOCKED:
+                            dataManager->flushOutputs(&_fmu);
+                            return count;
+                        case DependencyStatus::ABORT_SIM:
+                            cancelPendingStep();
+                            return std::numeric_limits<size_type>::max();
+                        default:
+                            throw runtime_error("CoSimulation: Unknown dependency");
+                    }
+                }
+                else
+                {
+                    startStep(getCommunicationStepSize(dataManager));
+                    if (!_stepPending)
+                        ++count;
+                }
+            }
+            dataManager->flushOutputs(&_fmu);
+            return count;
+        }
+
+        /**
+         * Does a communication step and waits for it, if the FMU computes it asynchronously.
+         */
+        virtual void doSolverStep(const real_type & h) override
+        {
+            startStep(h);
+            while (_stepPending)
+            {
+                std::this_thread::yield();
+                FMI::CoSimulationStepStatus status = _fmu.getStepStatus();
+                if (status != FMI::CoSimulationStepStatus::PENDING)
+                    finishStep(status);
+            }
+        }
+
+        virtual ErrorInfo getErrorInfo() const override
+        {
+            return ErrorInfo(_curStepSize);
+        }
+
+        /// The outputs are interpolated linearly between the communication points.
+        virtual size_type getSolverOrder() const override
+        {
+            return 1;
+        }
+
+     protected:
+        using AbstractSolver<DataManagerClass, FmuClass>::_fmu;
+        using AbstractSolver<DataManagerClass, FmuClass>::_currentTime;
+        using AbstractSolver<DataManagerClass, FmuClass>::_prevTime;
+        using AbstractSolver<DataManagerClass, FmuClass>::_curStepSize;
+        using AbstractSolver<DataManagerClass, FmuClass>::_initStepSize;
+        using AbstractSolver<DataManagerClass, FmuClass>::_endTime;
+        using AbstractSolver<DataManagerClass, FmuClass>::_tolerance;
+        using AbstractSolver<DataManagerClass, FmuClass>::_eventCounter;
+        using AbstractSolver<DataManagerClass, FmuClass>::_dependencyInfo;
+        using AbstractSolver<DataManagerClass, FmuClass>::_savedStep;
+        using AbstractSolver<DataManagerClass, FmuClass>::_stepInfo;
+
+     private:
+        bool_type _stepPending;
+
+        /**
+         * Chooses the size of the next communication step. It ends at the next output time at the latest.
+         */
+        real_type getCommunicationStepSize(Synchronization::IDataManager * dataManager)
+        {
+            real_type h = std::min(_initStepSize, _endTime - _currentTime);
+            if (_fmu.canHandleVariableStepSize())
+            {
+                // meet the time up to which the producers are known, instead of holding their outputs beyond it
+                real_type horizon = dataManager->getInputHorizon(&_fmu);
+                if (horizon - _currentTime > _tolerance)
+                    h = std::min(h, horizon - _currentTime);
+            }
+            real_type nextOutputTime = std::min(dataManager->getNextOutputTime(_currentTime), _endTime);
+            if (_currentTime + h >= nextOutputTime)
+            {
+                h = nextOutputTime - _currentTime;
+                _stepInfo.setWriteStep(true);
+            }
+            return h;
+        }
+
+        void startStep(const real_type & h)
+        {
+            _curStepSize = h;
+            _stepPending = true;
+            FMI::CoSimulationStepStatus status = _fmu.doStep(h);
+            if (status != FMI::CoSimulationStepStatus::PENDING)
+                finishStep(status);
+        }
+
+        void finishStep(const FMI::CoSimulationStepStatus & status)
+        {
+            _stepPending = false;
+            _prevTime = _currentTime;
+            _currentTime = _fmu.getTime();
+            if (status == FMI::CoSimulationStepStatus::DISCARDED)
+            {
+                if (_currentTime <= _prevTime)
+                    throw runtime_error("CoSimulation: The FMU " + _fmu.getFmuName() + " discarded the step at "
+                                        + to_string(_prevTime) + " without progress.");
+                // the step ended before the output time
+                _stepInfo.setWriteStep(false);
+            }
+            _savedStep = false;
+        }
+
+        void cancelPendingStep()
+        {
+            if (_stepPending && _fmu.canCancelStep())
+            {
+                _fmu.cancelStep();
+                _stepPending = false;
+            }
+        }
+    };
+
+} /* namespace Solver */
+
+#endif /* INCLUDE_SOLVER_COSIMULATION_HPP_ */
+/**
+ * @}
+ */
@@ -24,6 +24,12 @@ namespace Solver
         }
 
         virtual size_type solve(const size_type & numSteps) = 0;
+
+        /**
+         * Loads and instantiates the FMU of the solver, if it isn't loaded yet. In contrast to initialize(), it doesn't
+         * touch the data manager, so solvers of different FMUs can load them in parallel.
+         */
+        virtual void loadFmu() = 0;
         virtual void initialize() = 0;
         virtual void setEndTime(const real_type & simTime) = 0;
         virtual void setTolerance(const real_type & tolerance) = 0;
@@ -52,6 +58,11 @@ namespace Solver
         virtual void setMaxError(const real_type & maxError) = 0;
 
         virtual size_type getEventCounter() const = 0;
+
+        /**
+         * @return The time up to which the inputs of the solver's FMU are known. Infinity, if it has no inputs.
+         */
+        virtual real_type getInputHorizon() const = 0;
     };
 
 } /* namespace Solver */
@@ -54,64 +54,63 @@ namespace Solver
         {
         }
 
+        /**
+         * Does one step of the ROS2 method, see the reference above:
+         *   (I - gamma h J) k1 = f(t, y) + gamma h df/dt
+         *   (I - gamma h J) k2 = f(t + h, y + h k1) - gamma h df/dt - 2 k1
+         *   y' = y + 3/2 h k1 + 1/2 h k2
+         * The difference to the embedded first order solution y + h k1 estimates the error.
+         */
         virtual void doSolverStep(const real_type & h)
         {
-            //LOGGER_WRITE("in step size: " + to_string(h) + " time: " + to_string(_currentTime), Util::LC_SOLVER,Util::LL_DEBUG);
+            // the step starts at the previous time, also if the event stepping has already moved the current time
+            _fmu.setTime(_prevTime);
             _fmu.setStates(_prevStates);
             calcJacobi(-_gamma * h);
             calcDFDT(_gamma * h);
 
             dgetrf_(&_numStates, &_numStates, (real_type *) _jacobi[0], &_numStates, _pivot.data(), &_info);
+            checkInfo("dgetrf");
 
-            _fmu.getStateDerivatives(_stateDerivatives);
             for (size_type i = 0; i < _stateDerivatives.size(); ++i)
                 _stateDerivatives[i] += _dfdt[i];
-
             dgetrs_(&_lapackTrans, &_numStates, &_dimRHS, (real_type*) _jacobi[0], &_numStates, _pivot.data(),
-                    _stateDerivatives.data(), &_numStates, &_info);  //3
-            for (size_type i = 0; i < _stateDerivatives.size(); ++i)
-                _states[i] += h * _stateDerivatives[i];
+                    _stateDerivatives.data(), &_numStates, &_info);
+            checkInfo("dgetrs");
 
-            _fmu.setTime(_currentTime + h);
+            for (size_type i = 0; i < _stateDerivatives.size(); ++i)
+                _states[i] = _prevStates[i] + h * _stateDerivatives[i];
+            _fmu.setTime(_prevTime + h);
             _fmu.setStates(_states);
             _fmu.getStateDerivatives(_stateDerivatives2);
-
             for (size_type i = 0; i < _stateDerivatives.size(); ++i)
-                _stateDerivatives2[i] += _dfdt[i] - 2.0 * _stateDerivatives[i];
-
+                _stateDerivatives2[i] -= _dfdt[i] + 2.0 * _stateDerivatives[i];
             dgetrs_(&_lapackTrans, &_numStates, &_dimRHS, (real_type *) _jacobi[0], &_numStates, _pivot.data(),
                     _stateDerivatives2.data(), &_numStates, &_info);
-
+            checkInfo("dgetrs");
+            _fmu.setTime(_prevTime);
             _fmu.setStates(_prevStates);
-            double error = 0, tmpError;
+
+            // ERROR HANDLING START
+            real_type error = 0.0;
             for (size_type i = 0; i < _stateDerivatives.size(); ++i)
             {
-                _states[i] += h * std::abs(0.5 * _stateDerivatives[i] + 0.5 * _stateDerivatives2[i]);
-                tmpError = (_stateDerivatives[i] + _stateDerivatives2[i]);
-                tmpError /= (_prevStates[i]
-                        - std::max(0.0, h * (1.5 * _stateDerivatives[i] + 0.5 * _stateDerivatives2[i])) + 1.0)
-                        * _maxError;
-                if (tmpError > error)
-                    error = tmpError;
+                _states[i] = _prevStates[i] + h * (1.5 * _stateDerivatives[i] + 0.5 * _stateDerivatives2[i]);
+                real_type scale = _maxError + _tolerance * std::max(std::abs(_prevStates[i]), std::abs(_states[i]));
+                error = std::max(error, 0.5 * h * std::abs(_stateDerivatives[i] + _stateDerivatives2[i]) / scale);
             }
-
-            error *= 0.5 * h;
-
-            if (error > _maxError)
+            // the error is of second order in h
+            real_type factor = (error > 0.0) ? 0.9 / std::sqrt(error) : 2.0;
+            factor = std::min(2.0, std::max(0.2, factor));
+            if (error > 1.0)
             {
-                double newS = 0.95 * sqrt(_maxError / (error + _maxError / 100)) * h;
-                std::cout << "Step from " << h << " to " << newS << std::endl;
-                _errorInfo = ErrorInfo(newS, error);
+                LOGGER_WRITE("Ros2: Reject step " + to_string(h) + " at " + to_string(_prevTime), Util::LC_SOLVER,
+                             Util::LL_DEBUG);
+                _errorInfo = ErrorInfo(factor * h, error);
             }
             else
-            {
-                if (0.95 * sqrt(_maxError / (error + _maxError / 100)) > 2.0)
-                    _errorInfo = ErrorInfo(2 * h);
-                else
-                    _errorInfo = ErrorInfo(h);
-            }
+                _errorInfo = ErrorInfo(factor * h);
             // ERROR HANDLING END
-
         }
 
         /// Return error info.
@@ -134,6 +133,8 @@ namespace Solver
         using AbstractSolver<DataManagerClass, FmuClass>::_prevStates;
         using AbstractSolver<DataManagerClass, FmuClass>::_stateDerivatives;
         using AbstractSolver<DataManagerClass, FmuClass>::_currentTime;
+        using AbstractSolver<DataManagerClass, FmuClass>::_prevTime;
+        using AbstractSolver<DataManagerClass, FmuClass>::_tolerance;
         using AbstractSolver<DataManagerClass, FmuClass>::_maxError;
 
         /// Initializes the solver.
@@ -142,12 +143,13 @@ namespace Solver
             AbstractSolver<DataManagerClass, FmuClass>::initialize();
             _jacobi = vector<double *>(_numStates, nullptr);
             _jacobiSpace = shared_ptr<real_type>(new real_type[_numStates * _numStates],
-                                                 std::default_delete<real_type>());
+                                                 std::default_delete<real_type[]>());
             for (size_type i = 0; i < _jacobi.size(); ++i)
                 _jacobi[i] = &_jacobiSpace.get()[i * _jacobi.size()];
             _dfdt = vector1D(_numStates, 0.0);
 
             _stateDerivatives2 = vector1D(_numStates);
+            _tmpStates = vector1D(_numStates);
 
             _pivot = Util::vector<int_type>(_numStates);
 
@@ -155,40 +157,26 @@ namespace Solver
             _gamma = 1.0 - sqrt(2.0) / 2.0;
         }
 
-        /// Compute Jacobian matrix for the given step size.
+        /// Compute the matrix I + h J at the current states of the FMU.
         void calcJacobi(const real_type & h)
         {
-            real_type delta;
-            throw runtime_error("Ros2 isn't implemented.");
-            _fmu.getStates(_states);
-            _tmpStates = _states;
-            _fmu.getStateDerivatives(_stateDerivatives);
-
-            for (size_type i = 0; i < _states.size(); ++i)
+            // exact columns from directional derivatives, if the FMU provides them
+            _fmu.getJacobian(_jacobiSpace.get());
+            for (size_type i = 0; i < _jacobi.size(); ++i)
             {
-                delta = _diffQuotiant * _tmpStates[i] + _diffQuotiant;
-                _tmpStates[i] += delta;
-                _fmu.setStates(_tmpStates);
-                _fmu.getStateDerivatives(_jacobi[i]);
-                for (size_type j = 0; j < _stateDerivatives.size(); ++j)
-                {
-                    _jacobi[i][j] -= _stateDerivatives[j];
+                for (size_type j = 0; j < _jacobi.size(); ++j)
                     _jacobi[i][j] *= h;
-                    _jacobi[i][j] /= delta;
-                }
                 _jacobi[i][i] += 1.0;
-                _tmpStates[i] -= delta;
             }
         }
 
+        /// Compute h df/dt and the derivatives at the start of the step by a forward difference in time.
         void calcDFDT(const real_type & h)
         {
-            _fmu.setTime(_currentTime);
-            _fmu.setStates(_states);
+            _fmu.setTime(_prevTime);
             _fmu.getStateDerivatives(_stateDerivatives);
 
-            _fmu.setTime(_currentTime + _diffQuotiant);
-            _fmu.setStates(_states);
+            _fmu.setTime(_prevTime + _diffQuotiant);
             _fmu.getStateDerivatives(_tmpStates);
             for (size_type i = 0; i < _dfdt.size(); ++i)
             {
@@ -198,6 +186,13 @@ namespace Solver
             }
         }
 
+        void checkInfo(const string_type & routine) const
+        {
+            if (_info != 0)
+                throw runtime_error("Ros2: " + routine + " failed with info " + to_string(_info) + " for the FMU "
+                                    + _fmu.getFmuName() + " at " + to_string(_prevTime) + ".");
+        }
+
         /******************
          *   Attributes   *
          ******************/
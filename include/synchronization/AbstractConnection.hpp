@@ -11,6 +11,7 @@
 #include "initialization/Plans.hpp"
 #include "synchronization/HistoryEntry.hpp"
 #include "synchronization/HistoryEntryBuffer.hpp"
+#include "synchronization/ConnectionNotifier.hpp"
 #include "fmi/ValueCollection.hpp"
 #include "fmi/InputMapping.hpp"
 #include "Stdafx.hpp"
@@ -36,6 +37,7 @@ namespace Synchronization
                   _currentReceiveIndex(0),
                   _currentSendIndex(0),
                   _localId(0),
+                  _notifier(nullptr),
                   _plan(in)
         {
         }
@@ -66,6 +68,40 @@ namespace Synchronization
          */
         virtual int_type hasFreeBuffer() = 0;
 
+        /**
+         * Checks, without receiving it, if a new entry arrived. Used to find solvers which can be resumed and to poll
+         * connections which don't notify the ConnectionNotifier on changes.
+         * @return True, if recv() would return a valid entry.
+         */
+        virtual bool_type pollReady()
+        {
+            return false;
+        }
+
+        /**
+         * @return True, if send() and recv() signal the notifier, so waiting threads don't need to poll the connection.
+         */
+        virtual bool_type notifies() const
+        {
+            return false;
+        }
+
+        /**
+         * Sends entries, which were buffered to be coalesced into one message. Called when the source solver stops
+         * solving, since its consumer might wait for them.
+         */
+        virtual void flush()
+        {
+        }
+
+        /**
+         * Sets the notifier, which is signaled after successful send and receive operations.
+         */
+        void setNotifier(ConnectionNotifier * notifier)
+        {
+            _notifier = notifier;
+        }
+
         virtual void initialize(const std::string & fmuName)
         {
         }
@@ -75,6 +111,11 @@ namespace Synchronization
             return _plan.sourceFmu == fmuName;
         }
 
+        const std::string & getSourceFmu() const
+        {
+            return _plan.sourceFmu;
+        }
+
         virtual bool isShared() const
         {
             return false;
@@ -95,6 +136,11 @@ namespace Synchronization
             return _plan.inputMapping;
         }
 
+        const size_type & getId() const
+        {
+            return _plan.id;
+        }
+
         const size_type & getStartTag() const
         {
             return _plan.startTag;
@@ -105,8 +151,15 @@ namespace Synchronization
         size_type _currentReceiveIndex;
         size_type _currentSendIndex;
         size_type _localId;
+        ConnectionNotifier * _notifier;
         const Initialization::ConnectionPlan _plan;
 
+        void notify()
+        {
+            if (_notifier != nullptr)
+                _notifier->notify();
+        }
+
         size_t nextSendIndex() const
         {
             if (_currentSendIndex == _buffer.size() - 1)
@@ -53,8 +53,10 @@ namespace Synchronization
          * @param names Name of the FMUs that call this communicator instance.
          * @param outConnectionIds
          * @param inConnectionIds
+         * @param numIdleSpins     Number of polls before an idle thread is parked, see ConnectionNotifier.
+         * @param maxIdleParkTime  Maximal time in seconds a parked thread sleeps before polling again.
          */
-        Communicator();
+        Communicator(const size_type & numIdleSpins = 1000, const real_type & maxIdleParkTime = 1.0e-3);
 
         /**
          * Destroy the communicator.
@@ -73,6 +75,12 @@ namespace Synchronization
          */
         bool_type send(const HistoryEntry & in, size_type communicationId);
 
+        /**
+         * Sends all buffered entries of the given out-connections.
+         * @param conIds Out-connections to flush.
+         */
+        void flush(const vector<size_type> & conIds);
+
         /**
          * Return DataHistoryElement
          * @param communicationId
@@ -111,6 +119,26 @@ namespace Synchronization
          */
         size_type getNumOutConnections() const;
 
+        /**
+         * Checks, without receiving, if one of the given connections has a new entry.
+         * @param conIds In-connections to check.
+         * @return True, if an entry arrived on one of the connections.
+         */
+        bool_type hasReadyConnection(const vector<size_type> & conIds);
+
+        /**
+         * @return Number of state changes of the connections so far. Needs to be read before waitForInputs is called.
+         */
+        size_type getNotificationCount() const;
+
+        /**
+         * Blocks the calling thread until a connection changed its state since notificationCount was read or an entry
+         * arrived on one of the given connections, which don't notify.
+         * @param notificationCount Value of getNotificationCount() read before the caller's solvers were blocked.
+         * @param conIds            The in-connections of the caller's FMUs.
+         */
+        void waitForInputs(const size_type & notificationCount, const vector<size_type> & conIds);
+
      protected:
 
         /**
@@ -133,6 +161,11 @@ namespace Synchronization
 
         map<size_type, size_type> _knownConIds;
 
+        /**
+         * Signaled by the connections of this node. Parks threads which have only blocked solvers.
+         */
+        ConnectionNotifier _notifier;
+
         //Todo: Create buffer for communication, i.e., to store received values (later transfered to DataManager::DataHistory).
     };
 
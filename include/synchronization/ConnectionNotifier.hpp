@@ -0,0 +1,71 @@
+/** @addtogroup Synchronization
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_SYNCHRONIZATION_CONNECTIONNOTIFIER_HPP_
+#define INCLUDE_SYNCHRONIZATION_CONNECTIONNOTIFIER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "Stdafx.hpp"
+
+namespace Synchronization
+{
+
+    /**
+     * Wakes up threads whose solvers are all blocked, as soon as some connection of the node changed its state.
+     * Connections in shared memory call notify() after each successful send or receive. A waiting thread
+     * spins for a short while and parks on a condition variable afterwards. Connections which can't notify (e.g. MPI)
+     * are polled by the passed predicate. Since remote messages don't wake the thread, parking is done with a timeout
+     * that grows up to the given maximum.
+     */
+    class ConnectionNotifier
+    {
+     public:
+        /**
+         * @param numSpins     Number of checks before a waiting thread is parked.
+         * @param maxParkTime  Maximal time in seconds a parked thread sleeps before it polls again.
+         */
+        ConnectionNotifier(const size_type & numSpins, const real_type & maxParkTime);
+
+        ConnectionNotifier(const ConnectionNotifier &) = delete;
+
+        ConnectionNotifier & operator=(const ConnectionNotifier &) = delete;
+
+        /**
+         * Signals that the state of a connection changed and wakes up all parked threads.
+         */
+        void notify();
+
+        /**
+         * @return Number of notifications so far. Pass it to wait() to detect notifications happening in between.
+         */
+        size_type getCount() const;
+
+        /**
+         * Blocks until notify() was called after the given count was read or until isReady returns true.
+         * @param lastCount Value of getCount() before the caller detected that it has to wait.
+         * @param isReady   Polls the connections which can't notify.
+         */
+        void wait(const size_type & lastCount, const function<bool_type()> & isReady);
+
+     private:
+        std::atomic<size_type> _count;
+        std::atomic<size_type> _numParked;
+        std::mutex _mutex;
+        std::condition_variable _cond;
+
+        size_type _numSpins;
+        std::chrono::microseconds _maxParkTime;
+    };
+
+} /* namespace Synchronization */
+
+#endif /* INCLUDE_SYNCHRONIZATION_CONNECTIONNOTIFIER_HPP_ */
+/**
+ * @}
+ */
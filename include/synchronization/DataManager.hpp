@@ -74,11 +74,22 @@ namespace Synchronization
 
             this->setFmuInputValuesAtT(fmu->getTime(), fmu);
 
-            FMI::ValueCollection newValues = fmu->getValues(FMI::ReferenceContainerType::ALL);  // Collection in where inputs are set
+            // the connected outputs are needed every step, all values only at output times
+            FMI::ValueCollection & newValues = _fmuValues[fmu->getLocalId()];  // Collection in where inputs are set
+            const FMI::ValueSubset & connectedOutputs = _connectedOutputs[fmu->getLocalId()];
+            if (stepInfo.hasWriteStep())
+            {
+                fmu->getAllValues(newValues);
+                // getAllValues() skips strings
+                if (!connectedOutputs.getIndices<string_type>().empty())
+                    fmu->getValues(newValues, connectedOutputs);
+            }
+            else
+                fmu->getValues(newValues, connectedOutputs);
             /////////////////////////////////////////////////////////
             ///////////////////// SEND OUTPUTS //////////////////////
             /////////////////////////////////////////////////////////
-            if (!sendOutputs(fmu->getTime(), solveOrder, fmu, stepInfo))
+            if (!sendOutputs(fmu->getTime(), solveOrder, fmu, stepInfo, newValues))
                 return false;
 
             //////////////////////////////////////////////////////////
@@ -89,7 +100,12 @@ namespace Synchronization
                 _history.insert(HistoryEntry(stepInfo.getEventTime<0>(), solveOrder, stepInfo.getEventValues<0>()), fmu->getLocalId(), WriteInfo::EVENTWRITE);  // event save slightly before event
                 _history.insert(HistoryEntry(stepInfo.getEventTime<1>(), solveOrder, stepInfo.getEventValues<1>()), fmu->getLocalId(), WriteInfo::EVENTWRITE);  // event save slightly after event
             }
-            _history.insert(HistoryEntry(fmu->getTime(), solveOrder, newValues), fmu->getLocalId(), (stepInfo.hasWriteStep()) ? WriteInfo::WRITE : WriteInfo::NOWRITE);  //normal save
+            // the other rows interpolate between the output times, so steps in between aren't saved
+            if (stepInfo.hasWriteStep())
+                _history.insert(HistoryEntry(fmu->getTime(), solveOrder, newValues), fmu->getLocalId(), WriteInfo::WRITE);  //normal save
+            _lastSaveTime[fmu->getLocalId()] = fmu->getTime();
+
+            _lastSaveTime[fmu->getLocalId()] = fmu->getTime();
 
             while (_history.hasWriteOutput())
             {
@@ -105,13 +121,22 @@ namespace Synchronization
          */
         void setFmuInputValuesAtT(const real_type & t, FMI::AbstractFmu* fmu) override
         {
-            FMI::ValueCollection fmuValues = fmu->getValues(FMI::ReferenceContainerType::ALL);
+            FMI::ValueCollection & fmuValues = _fmuValues[fmu->getLocalId()];
             for (const size_type conId : _communicator.getInConnectionIds(fmu))
             {
-                FMI::ValueCollection tmpColl = _history.getInputValues(conId, t);  // Implicit interpolation for time [curTime]
+                real_type inputTime = t;
+                if (_delayedInputs[conId])
+                {
+                    // hold the newest values, before the first entry the FMU keeps its start values
+                    const RingBufferSubHistory & inputHistory = _history.getInputHistory(conId);
+                    if (inputHistory.size() == 0)
+                        continue;
+                    inputTime = std::min(t, inputHistory.getNewestTime());
+                }
+                FMI::ValueCollection tmpColl = _history.getInputValues(conId, inputTime);  // Implicit interpolation for time [curTime]
                 _valuePacking[conId].unpack(fmuValues, tmpColl);
             }
-            fmu->setValues(fmuValues);
+            fmu->setValues(fmuValues, _connectedInputs[fmu->getLocalId()]);
         }
 
         /**
@@ -138,16 +163,17 @@ namespace Synchronization
         {
             if (_communicator.getInConnectionIds(fmu).size() > 0)
             {
+                std::list<Solver::DependencySolverInfo> & upcomingEvents = _upcomingEvents[fmu->getLocalId()];
                 Solver::DependencySolverInfo dsi = collectInputs(fmu->getTime(), fmu);
                 if (dsi.depStatus == Solver::DependencyStatus::BLOCKED)
                     return dsi;
                 else if (dsi.depStatus == Solver::DependencyStatus::EVENT)
-                    _upcomingEvents.push_back(dsi);
-                if (!_upcomingEvents.empty())
-                    if (_upcomingEvents.front().eventTimeEnd <= fmu->getTime())
+                    upcomingEvents.push_back(dsi);
+                if (!upcomingEvents.empty())
+                    if (upcomingEvents.front().eventTimeEnd <= fmu->getTime())
                     {
-                        dsi = _upcomingEvents.front();
-                        _upcomingEvents.pop_front();
+                        dsi = upcomingEvents.front();
+                        upcomingEvents.pop_front();
                         return dsi;
                     }
             }
@@ -164,14 +190,31 @@ namespace Synchronization
         {
             fmu->setLocalId(_numManagedFmus++);
             size_type numNewCons = _communicator.addFmu(fmu, _valuePacking);
+            const vector<size_type> & inConIds = _communicator.getInConnectionIds(fmu);
+            _inConnectionIds.insert(_inConnectionIds.end(), inConIds.begin(), inConIds.end());
 
             _lastCommTime.resize(_lastCommTime.size() + numNewCons, -1.0 * std::numeric_limits<real_type>::infinity());
             _lastEventWritten.resize(_lastEventWritten.size() + numNewCons, -1.0 * std::numeric_limits<real_type>::infinity());
             _lastEventRead.resize(_lastEventRead.size() + numNewCons, -1.0 * std::numeric_limits<real_type>::infinity());
             _lastEventReadState.resize(_lastEventReadState.size() + numNewCons, true);
             _lastEventWriteState.resize(_lastEventReadState.size() + numNewCons, true);
+            _delayedInputs.resize(_delayedInputs.size() + numNewCons, false);
             _history.addFmu(fmu, fmu->getConnections());
 
+            FMI::ValueSubset outputs(fmu->getAllValueReferences()), inputs(fmu->getAllValueReferences());
+            for (const size_type conId : _communicator.getOutConnectionIds(fmu))
+                outputs.addOutputs(_valuePacking[conId]);
+            for (const size_type conId : inConIds)
+                inputs.addInputs(_valuePacking[conId]);
+            _connectedOutputs.resize(_numManagedFmus);
+            _connectedOutputs[fmu->getLocalId()] = outputs;
+            _connectedInputs.resize(_numManagedFmus);
+            _connectedInputs[fmu->getLocalId()] = inputs;
+            _upcomingEvents.resize(_numManagedFmus);
+            _lastSaveTime.resize(_numManagedFmus, -1.0 * std::numeric_limits<real_type>::infinity());
+            _fmuValues.resize(_numManagedFmus);
+            _fmuValues[fmu->getLocalId()] = fmu->getValues(FMI::ReferenceContainerType::ALL);
+
             if (!_writer.isInitialized())
             {
                 _writer.initialize();
@@ -185,10 +228,52 @@ namespace Synchronization
             return &_history;
         }
 
+        real_type getInputHorizon(const FMI::AbstractFmu * fmu) const override
+        {
+            real_type res = std::numeric_limits<real_type>::infinity();
+            for (const size_type conId : _communicator.getInConnectionIds(fmu))
+            {
+                if (_delayedInputs[conId])
+                    continue;
+                const RingBufferSubHistory & inputHistory = _history.getInputHistory(conId);
+                if (inputHistory.size() == 0)
+                    return fmu->getTime();
+                res = std::min(res, inputHistory.getNewestTime());
+            }
+            return res;
+        }
+
+        size_type getNotificationCount() const override
+        {
+            return _communicator.getNotificationCount();
+        }
+
+        bool_type hasNewInputs(const FMI::AbstractFmu * fmu) override
+        {
+            return _communicator.hasReadyConnection(_communicator.getInConnectionIds(fmu));
+        }
+
+        void waitForInputs(const size_type & notificationCount) override
+        {
+            _communicator.waitForInputs(notificationCount, _inConnectionIds);
+        }
+
+        void flushOutputs(const FMI::AbstractFmu * fmu) override
+        {
+            _communicator.flush(_communicator.getOutConnectionIds(fmu));
+        }
+
+        void setDelayedInput(const size_type & conId) override
+        {
+            _delayedInputs[conId] = true;
+        }
+
         // dirty, passes interface
         bool sendSingleOutput(real_type curTime, size_type solveOrder, const FMI::AbstractFmu* fmu, const size_type & conId)
         {
-            if (_communicator.send(HistoryEntry(curTime, solveOrder, _valuePacking[conId].pack(fmu->getValues(FMI::ReferenceContainerType::ALL)), true), conId))
+            FMI::ValueCollection & fmuValues = _fmuValues[fmu->getLocalId()];
+            fmu->getValues(fmuValues, _connectedOutputs[fmu->getLocalId()]);
+            if (_communicator.send(HistoryEntry(curTime, solveOrder, _valuePacking[conId].pack(fmuValues), true), conId))
                 _lastCommTime[conId] = curTime;
             else
                 return false;
@@ -228,6 +313,30 @@ namespace Synchronization
         vector<bool> _lastEventReadState;
         vector<bool> _lastEventWriteState;
 
+        /**
+         * If true, the destination FMU of the connection only waits for the entry of its last saved step, see
+         * setDelayedInput. Accessible via connectionId.
+         */
+        vector<bool> _delayedInputs;
+
+        /**
+         * Time of the last saved step of the FMUs, accessible via localId.
+         */
+        vector<real_type> _lastSaveTime;
+
+        /**
+         * Last known values of the FMUs, accessible via localId. The connected outputs are refreshed every step, all
+         * values only at output times.
+         */
+        vector<FMI::ValueCollection> _fmuValues;
+
+        /**
+         * Outputs of the FMUs read by their out-connections and inputs set by their in-connections, accessible via
+         * localId. They are read and set by one call per type.
+         */
+        vector<FMI::ValueSubset> _connectedOutputs;
+        vector<FMI::ValueSubset> _connectedInputs;
+
      private:
         WriterClass _writer;
 
@@ -236,19 +345,35 @@ namespace Synchronization
 
         size_type _numManagedFmus;
 
-        std::list<Solver::DependencySolverInfo> _upcomingEvents;
+        /**
+         * Events received by the FMUs, which they haven't reached yet, accessible via localId.
+         */
+        vector<std::list<Solver::DependencySolverInfo>> _upcomingEvents;
+
+        /**
+         * In-connections of all FMUs handled by this DataManager. Polled while waiting for inputs.
+         */
+        vector<size_type> _inConnectionIds;
 
         Solver::DependencySolverInfo collectInputs(real_type curTime, FMI::AbstractFmu* fmu)
         {
             Solver::DependencySolverInfo res = { Solver::DependencyStatus::FREE, std::numeric_limits<real_type>::max(), std::numeric_limits<real_type>::max() };
             for (const size_type conId : _communicator.getInConnectionIds(fmu))  // Checking all connections
             {
-                while (_history.getInputHistory(conId).size() == 0 || _history.getInputHistory(conId).getNewestTime() < curTime)  // while till outputs were send by predecessor FMU
+                bool required = true;
+                // a delayed input is only required up to the last saved step, nothing before the first one
+                const real_type requiredTime = _delayedInputs[conId] ? _lastSaveTime[fmu->getLocalId()] : curTime;
+                const bool_type hasRequiredTime = requiredTime > -1.0 * std::numeric_limits<real_type>::infinity();
+                // Receive till outputs were send by predecessor FMU. Already arrived outputs beyond are received as
+                // well, as long as the input history can store them. They extend the input horizon of the FMU.
+                while ((required = (hasRequiredTime && (_history.getInputHistory(conId).size() == 0 || _history.getInputHistory(conId).getNewestTime() < requiredTime)))
+                        || _history.getInputHistory(conId).getNumFreeEntries() > 0)
                 {
                     HistoryEntry dhe = _communicator.recv(conId);
                     if (dhe.isValid())
                     {
-                        if (dhe.hasEvent())
+                        // the values of a delayed input are held, so its events aren't stepped
+                        if (dhe.hasEvent() && !_delayedInputs[conId])
                         {
                             if (!_lastEventReadState[conId])
                             {
@@ -270,7 +395,8 @@ namespace Synchronization
                                     _lastEventReadState[conId] = false;
                                     _lastEventRead[conId] = dhe.getTime();
                                     _history.insertInputs(dhe, conId);
-                                    res.depStatus = Solver::DependencyStatus::BLOCKED;
+                                    if (required)
+                                        res.depStatus = Solver::DependencyStatus::BLOCKED;
                                     break;
                                 }
                                 else
@@ -298,7 +424,8 @@ namespace Synchronization
                     }
                     else
                     {
-                        res.depStatus = Solver::DependencyStatus::BLOCKED;
+                        if (required)
+                            res.depStatus = Solver::DependencyStatus::BLOCKED;
                         break;
                     }
                 }
@@ -308,46 +435,36 @@ namespace Synchronization
             return res;
         }
 
-        bool sendOutputs(real_type curTime, size_type solveOrder, FMI::AbstractFmu* fmu, const Solver::SolverStepInfo & stepInfo)
+        bool sendOutputs(real_type curTime, size_type solveOrder, FMI::AbstractFmu* fmu, const Solver::SolverStepInfo & stepInfo,
+                         const FMI::ValueCollection & fmuValues)
         {
-            const FMI::ValueCollection fmuValues = fmu->getValues(FMI::ReferenceContainerType::ALL);
             for (size_type conId : _communicator.getOutConnectionIds(fmu))
             {
-                if (_lastCommTime[conId] < curTime)  // check if the time wasn't already written
+                // a retry after a full connection skips the connections, which already got the current time
+                if (_lastCommTime[conId] >= curTime)
+                    continue;
+                if (stepInfo.hasEventWrite() && _lastEventWritten[conId] < stepInfo.getEventTime<0>())  // check for events and if there weren't already written
                 {
-                    if (stepInfo.hasEventWrite() && _lastEventWritten[conId] < stepInfo.getEventTime<0>())  // check for events and if there weren't already written
+                    // send event in two communications, a retry continues with the second one
+                    if (_lastEventWriteState[conId])
                     {
-                        // send event in two communications
                         if (!_communicator.send(HistoryEntry(stepInfo.getEventTime<0>(), solveOrder, _valuePacking[conId].pack(stepInfo.getEventValues<0>()), true), conId))
                             return false;
                         _lastEventWriteState[conId] = false;
-                        _lastCommTime[conId] = curTime;
-
-                        if (!_communicator.send(HistoryEntry(stepInfo.getEventTime<1>(), solveOrder, _valuePacking[conId].pack(stepInfo.getEventValues<1>()), true), conId))
-                            return false;
-                        _lastEventWritten[conId] = stepInfo.getEventTime<1>();
-                        _lastEventWriteState[conId] = true;
-                    }
-                    else
-                    {
-                        if (!_communicator.send(HistoryEntry(curTime, solveOrder, _valuePacking[conId].pack(fmuValues), false), conId))
-                            return false;
-                        _lastCommTime[conId] = curTime;
                     }
+                    if (!_communicator.send(HistoryEntry(stepInfo.getEventTime<1>(), solveOrder, _valuePacking[conId].pack(stepInfo.getEventValues<1>()), true), conId))
+                        return false;
+                    _lastEventWritten[conId] = stepInfo.getEventTime<1>();
+                    _lastEventWriteState[conId] = true;
                 }
-                else
+                // The current time follows the event. Otherwise the inputs of the consumers would end at the event
+                // until the next step, which blocks them, if they are producers of this FMU as well.
+                if (curTime > _lastEventWritten[conId])
                 {
-                    if (!_lastEventWriteState[conId])
-                    {
-                        if (!_communicator.send(HistoryEntry(stepInfo.getEventTime<1>(), solveOrder, _valuePacking[conId].pack(stepInfo.getEventValues<1>()), true), conId))
-                            return false;
-                        _lastEventWritten[conId] = stepInfo.getEventTime<1>();
-                        _lastEventWriteState[conId] = true;
-                    }
-                    else
-                        throw std::runtime_error("DataManager: Already send inputs.\n");
-
+                    if (!_communicator.send(HistoryEntry(curTime, solveOrder, _valuePacking[conId].pack(fmuValues), false), conId))
+                        return false;
                 }
+                _lastCommTime[conId] = curTime;
             }
             return true;
         }
@@ -0,0 +1,63 @@
+/** @addtogroup Synchronization
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_SYNCHRONIZATION_DELTAENCODING_HPP_
+#define INCLUDE_SYNCHRONIZATION_DELTAENCODING_HPP_
+
+#include "initialization/Plans.hpp"
+#include "synchronization/HistoryEntry.hpp"
+
+namespace Synchronization
+{
+
+    /**
+     * Delta encoding of the entries of a connection ("encoding" = "delta"). An encoded entry consists of the time, the
+     * solver order, the event flag, a bitmask of the changed values and the changed values. A real value only counts
+     * as changed, if it differs by more than its deadband from the value last sent. At events every change is sent.
+     * The first entry is sent in full. The source and the destination each keep an own instance, which holds the
+     * values as last sent or received, so both need to see the same sequence of entries.
+     */
+    class DeltaEncoding
+    {
+     public:
+        DeltaEncoding(const Initialization::ConnectionPlan & in);
+
+        /**
+         * @return Size in bytes of an entry, in which all values are sent.
+         */
+        size_type getMaxEntrySize() const;
+
+        /**
+         * Packs the time, the changed values and the bitmask of an entry and updates the last values.
+         * @param out Needs getMaxEntrySize() bytes.
+         * @return Number of bytes written.
+         */
+        size_type pack(const HistoryEntry & in, char * out);
+
+        /**
+         * Reconstructs an entry from the changed values and the last values.
+         * @param numBytes Will hold the number of bytes read.
+         */
+        HistoryEntry unpack(const char * in, size_type & numBytes);
+
+     private:
+        size_type _numReals;
+        size_type _numInts;
+        size_type _numBools;
+        size_type _maskSize;
+
+        /**
+         * Deadbands of the real values and the values as last sent (source) or received (destination).
+         */
+        vector<real_type> _deadbands;
+        FMI::ValueCollection _lastValues;
+        bool_type _hasLastValues;
+    };
+
+} /* namespace Synchronization */
+#endif /* INCLUDE_SYNCHRONIZATION_DELTAENCODING_HPP_ */
+/**
+ * @}
+ */
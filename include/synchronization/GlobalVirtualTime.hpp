@@ -0,0 +1,107 @@
+/** @addtogroup Synchronization
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_SYNCHRONIZATION_GLOBALVIRTUALTIME_HPP_
+#define INCLUDE_SYNCHRONIZATION_GLOBALVIRTUALTIME_HPP_
+
+#include <algorithm>
+#include <mutex>
+
+#include "Stdafx.hpp"
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+namespace Synchronization
+{
+
+    /**
+     * Global virtual time (GVT) of the program, i.e., the minimal current time of all solvers on all nodes. No
+     * solver will ever need an input older than the GVT, and the program is finished as soon as the GVT reaches
+     * the end time.
+     * One object is shared by all simulations of a node. The simulations report the minimal time of their solvers
+     * from time to time. The node minimum is reduced over all MPI processes with a non-blocking MPI_Iallreduce, so
+     * the GVT lags behind by a few reports but never blocks the simulation. All processes start the same number of
+     * reductions, since a new one is only started while the last result is below the end time.
+     */
+    class GlobalVirtualTime
+    {
+     public:
+        /**
+         * @param startTime Start time of the simulation.
+         * @param endTime   End time of the simulation.
+         */
+        GlobalVirtualTime(const real_type & startTime, const real_type & endTime);
+
+        GlobalVirtualTime(const GlobalVirtualTime &) = delete;
+
+        GlobalVirtualTime & operator=(const GlobalVirtualTime &) = delete;
+
+        /**
+         * Registers a simulation. Has to be called before the simulation reports its time the first time.
+         * @return The id the simulation passes to update().
+         */
+        size_type addSimulation();
+
+        /**
+         * Reports the minimal solver time of a simulation and advances the reduction over the MPI processes
+         * without blocking.
+         * @param id        Id returned by addSimulation().
+         * @param localTime Minimal current time of the solvers of the simulation.
+         * @return The current GVT.
+         */
+        real_type update(const size_type & id, const real_type & localTime);
+
+        /**
+         * @return The last known GVT.
+         */
+        real_type getTime();
+
+        /**
+         * @return True, if all solvers of the program reached the end time.
+         */
+        bool_type isFinished();
+
+        /**
+         * @return True, if the GVT is reduced over several MPI processes. Otherwise, it's the node minimum.
+         */
+        static bool_type isDistributed();
+
+     private:
+        std::mutex _mutex;
+
+        /**
+         * Last reported time of every registered simulation.
+         */
+        vector<real_type> _localTimes;
+
+        real_type _time;
+        real_type _startTime;
+        real_type _endTime;
+
+        /**
+         * Fraction of the simulated time span which was logged last.
+         */
+        int_type _loggedProgress;
+
+#ifdef USE_MPI
+        MPI_Request _request;
+        real_type _sendTime;
+        real_type _reducedTime;
+#endif
+
+        /**
+         * Increases the GVT and logs the progress in steps of ten percent.
+         */
+        void setTime(const real_type & time);
+    };
+
+} /* namespace Synchronization */
+
+#endif /* INCLUDE_SYNCHRONIZATION_GLOBALVIRTUALTIME_HPP_ */
+/**
+ * @}
+ */
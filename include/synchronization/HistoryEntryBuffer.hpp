@@ -58,6 +58,12 @@ namespace Synchronization
         size_type _bool_typeSize;
         bool_type * _bool_typeVals;
 
+        /**
+         * contains the string values of the value collection. They aren't part of the raw data, so only the
+         * connections, which copy the buffer itself instead of its data, pass them.
+         */
+        vector<string_type> _stringVals;
+
         /**
          * Contains number of bytes for all values
          */
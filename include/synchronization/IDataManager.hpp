@@ -38,6 +38,40 @@ namespace Synchronization
         virtual void addFmu(FMI::AbstractFmu * fmu) = 0;
         virtual const AbstractDataHistory* getHistory() const = 0;
 
+        /**
+         * @return The time up to which the inputs of the FMU are known, i.e., the oldest of the newest entries of its
+         *         input histories. Infinity, if the FMU has no inputs.
+         */
+        virtual real_type getInputHorizon(const FMI::AbstractFmu * fmu) const = 0;
+
+        /**
+         * @return Counter of connection state changes, read it before solving to pass it to waitForInputs.
+         */
+        virtual size_type getNotificationCount() const = 0;
+
+        /**
+         * @return True, if a new input entry arrived for the FMU, i.e., a solver blocked by its inputs can continue.
+         */
+        virtual bool_type hasNewInputs(const FMI::AbstractFmu * fmu) = 0;
+
+        /**
+         * Sleeps until one of the connections of the managed FMUs changed since notificationCount was read.
+         */
+        virtual void waitForInputs(const size_type & notificationCount) = 0;
+
+        /**
+         * Sends the outputs of the FMU, which are still buffered by its out-connections.
+         */
+        virtual void flushOutputs(const FMI::AbstractFmu * fmu) = 0;
+
+        /**
+         * Lets the destination FMU of the in-connection run one step ahead of it. Instead of the entry of its current
+         * time, the FMU only needs the entry of its last saved step and holds the newest received values. Used to
+         * break dependency cycles, which would block all of their FMUs otherwise.
+         * @param conId Id of the in-connection.
+         */
+        virtual void setDelayedInput(const size_type & conId) = 0;
+
     };
 }
 
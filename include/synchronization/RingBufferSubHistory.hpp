@@ -24,6 +24,12 @@ namespace Synchronization
 
         real_type getNewestTime() const;
 
+        /**
+         * @return Number of entries which can be inserted without overwriting entries that are needed for upcoming
+         *         interpolations.
+         */
+        size_type getNumFreeEntries() const;
+
         FMI::ValueCollection interpolate(const real_type & time);
 
         FMI::ValueCollection operator[](const real_type & time);
@@ -0,0 +1,52 @@
+/** @addtogroup Synchronization
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_SYNCHRONIZATION_SHMCONNECTION_HPP_
+#define INCLUDE_SYNCHRONIZATION_SHMCONNECTION_HPP_
+
+#include "synchronization/SharedMemoryConnection.hpp"
+
+namespace Synchronization
+{
+
+    /**
+     * This class implements a connection between two FMUs simulated by different worker processes of one node. The
+     * rings of all those connections lie in one POSIX shared memory segment, which is mapped before the workers are
+     * forked, so every worker sees it at the same address.
+     */
+    class SHMConnection : public SharedMemoryConnection
+    {
+     public:
+        SHMConnection(const Initialization::ConnectionPlan & in);
+
+        ~SHMConnection();
+
+        /**
+         * Turns the connections between the cores of the node into "shm" connections and maps the shared memory
+         * segment holding their rings. Needs to be called before the worker processes are forked.
+         * @param plan The plan of the program, the kind and shmOffset of its connection plans are set.
+         */
+        static void createSegment(Initialization::ProgramPlan & plan);
+
+        /**
+         * Unmaps the shared memory segment.
+         */
+        static void freeSegment();
+
+        /**
+         * Resolves the address of the ring in the shared memory segment.
+         */
+        void initialize(const std::string & fmuName) override;
+
+     private:
+        static char * _segment;
+        static size_type _segmentSize;
+    };
+
+} /* namespace Synchronization */
+#endif /* INCLUDE_SYNCHRONIZATION_SHMCONNECTION_HPP_ */
+/**
+ * @}
+ */
@@ -50,6 +50,13 @@ namespace Synchronization
          */
         int_type hasFreeBuffer() override;
 
+        bool_type pollReady() override;
+
+        bool_type notifies() const override
+        {
+            return true;
+        }
+
      private:
         vector<bool_type> _isFree;
     };
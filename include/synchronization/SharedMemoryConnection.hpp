@@ -0,0 +1,90 @@
+/** @addtogroup Synchronization
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_SYNCHRONIZATION_SHAREDMEMORYCONNECTION_HPP_
+#define INCLUDE_SYNCHRONIZATION_SHAREDMEMORYCONNECTION_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include "synchronization/AbstractConnection.hpp"
+
+namespace Synchronization
+{
+
+    /**
+     * Base class of connections between processes, which share memory. The entries are passed through a lock-free
+     * single producer single consumer ring of bufferSize entries. The source copies the entry into the next slot and
+     * publishes it by advancing the atomic tail counter, the destination copies it out and advances the atomic head
+     * counter. Derived classes provide the memory of the ring.
+     */
+    class SharedMemoryConnection : public AbstractConnection
+    {
+     public:
+        SharedMemoryConnection(const Initialization::ConnectionPlan & in);
+
+        virtual ~SharedMemoryConnection();
+
+        /**
+         * Copies the entry into the ring.
+         * @param in DataHistoryElement to send.
+         * @return False, if the ring is full.
+         */
+        bool send(const HistoryEntry & in) override;
+
+        /**
+         * Copies the next entry out of the ring.
+         * @return The received DataHistoryElement or an invalid one, if no entry is present.
+         */
+        HistoryEntry recv() override;
+
+        /**
+         * Checks if a free slot for send operations is present.
+         * @return 0 if a send operation would block, 2 if more than one slot is free.
+         */
+        int_type hasFreeBuffer() override;
+
+        /**
+         * @return True, if the ring holds an entry, which wasn't received yet.
+         */
+        bool_type pollReady() override;
+
+        /**
+         * @return Number of bytes of the ring of a connection, a multiple of the cache line size.
+         */
+        static size_type getRingSize(const Initialization::ConnectionPlan & in);
+
+        /**
+         * Constructs the counters of an empty ring. Needs to be called once, before the ring is used.
+         */
+        static void initializeRing(char * ring);
+
+     protected:
+        /**
+         * Sets the ring used by the connection.
+         */
+        void setRing(char * ring);
+
+     private:
+        /**
+         * Offsets of the counters and the slots in the ring. The counters are written by different processes, so they
+         * are placed on different cache lines.
+         */
+        static const size_type _cacheLineSize = 64;
+        static const size_type _tailOffset = 0;
+        static const size_type _headOffset = _cacheLineSize;
+        static const size_type _slotOffset = 2 * _cacheLineSize;
+
+        size_type _entrySize;
+
+        std::atomic<std::uint64_t> * _tail;
+        std::atomic<std::uint64_t> * _head;
+        char * _slots;
+    };
+
+} /* namespace Synchronization */
+#endif /* INCLUDE_SYNCHRONIZATION_SHAREDMEMORYCONNECTION_HPP_ */
+/**
+ * @}
+ */
@@ -0,0 +1,59 @@
+/** @addtogroup Synchronization
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_SYNCHRONIZATION_MPICHANNELS_HPP_
+#define INCLUDE_SYNCHRONIZATION_MPICHANNELS_HPP_
+
+#include <mpi.h>
+#include "initialization/Plans.hpp"
+#include "Stdafx.hpp"
+
+namespace Synchronization
+{
+
+    /**
+     * Manages the tags and communicators of the MPI connections. Messages are matched by source rank, so tags only
+     * need to be unique among the connections between two ranks. Every such connection gets the next free number of
+     * its rank pair as start tag. The numbers are split into the valid tags of a communicator and the index of a
+     * duplicate of MPI_COMM_WORLD, so any number of connections fits below MPI_TAG_UB.
+     */
+    class MPIChannels
+    {
+     public:
+        /**
+         * Assigns the start tags of the MPI connections of the plan and duplicates the needed communicators.
+         * Collective over MPI_COMM_WORLD, every rank needs to pass the same plan.
+         */
+        static void create(Initialization::ProgramPlan & plan);
+
+        /**
+         * Frees the duplicated communicators. Collective over MPI_COMM_WORLD.
+         */
+        static void free();
+
+        /**
+         * @return The communicator of the connection with the given start tag.
+         */
+        static MPI_Comm getComm(const size_type & startTag);
+
+        /**
+         * @return The MPI tag of the connection with the given start tag.
+         */
+        static int_type getTag(const size_type & startTag);
+
+     private:
+        static vector<MPI_Comm> _comms;
+
+        /**
+         * Number of valid tags of a communicator, i.e., MPI_TAG_UB + 1.
+         */
+        static size_type _numTags;
+    };
+
+} /* namespace Synchronization */
+#endif /* INCLUDE_SYNCHRONIZATION_MPICHANNELS_HPP_ */
+/**
+ * @}
+ */
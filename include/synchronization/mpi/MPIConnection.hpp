@@ -10,12 +10,23 @@
 
 #include <mpi.h>
 #include "synchronization/AbstractConnection.hpp"
+#include "synchronization/DeltaEncoding.hpp"
+#include "synchronization/mpi/MPIChannels.hpp"
 
 namespace Synchronization
 {
 
     /**
-     * This class implements a connection between two FMUs using OpenMP.
+     * This class implements a connection between two FMUs using MPI. Consecutive entries are coalesced into one
+     * message of up to batchSize entries (and maxBatchBytes bytes) of the connection plan. A message is sent when it
+     * is full or the connection is flushed. Each buffer slot holds one message. The entries are written directly into
+     * the slots and described by a derived datatype, which is fixed by the packing of the connection. Full messages
+     * are sent by persistent requests of the slots. The receiver keeps a persistent
+     * receive request posted on every slot, so the sender can have bufferSize messages in flight. All slots use the
+     * same tag: the messages of a sender don't overtake each other and the receives are restarted in slot order,
+     * so the i-th message always matches the receive of slot i modulo bufferSize.
+     * With delta encoding, the entries of a message have variable size and are sent as bytes, see DeltaEncoding.
+     * Since messages don't overtake each other, both sides see the same sequence of entries.
      */
     class MPIConnection : public AbstractConnection
     {
@@ -31,6 +42,9 @@ namespace Synchronization
          */
         bool send(const HistoryEntry & in) override;
 
+        /**
+         * Creates and starts the persistent receive requests of all buffer slots, if fmuName is the destination.
+         */
         void initialize(const std::string & fmuName) override;
 
         /**
@@ -45,9 +59,100 @@ namespace Synchronization
          */
         int_type hasFreeBuffer() override;
 
+        /**
+         * Tests the pending receive request without receiving the entry.
+         * @return True, if the next entry arrived.
+         */
+        bool_type pollReady() override;
+
+        /**
+         * Sends the partially filled message, if entries are buffered.
+         */
+        void flush() override;
+
      private:
+        /**
+         * Send requests of partial messages of the source or persistent receive requests of the destination, one
+         * per buffer slot.
+         */
         vector<MPI_Request> _isFree;
-        size_type _numOpenConns;
+        bool_type _isPersistent;
+
+        /**
+         * Persistent send requests of full messages of the source, one per buffer slot.
+         */
+        vector<MPI_Request> _fullSends;
+
+        /**
+         * Communicator and tag of the connection, see MPIChannels.
+         */
+        MPI_Comm _comm;
+        int_type _tag;
+
+        /**
+         * Layout of an entry in a message: the time, the real values, the integer values, the solver order, the
+         * bool values and the event flag. The offsets are in bytes, the size is the extent of _entryType.
+         */
+        size_type _numReals;
+        size_type _numInts;
+        size_type _numBools;
+        size_type _realOffset;
+        size_type _intOffset;
+        size_type _orderOffset;
+        size_type _boolOffset;
+        size_type _eventOffset;
+        size_type _entrySize;
+        MPI_Datatype _entryType;
+
+        /**
+         * True, if only changed values are sent. Then _entrySize is the maximal size of an entry.
+         */
+        bool_type _isDelta;
+
+        DeltaEncoding _delta;
+
+        /**
+         * Maximal number of entries in one message.
+         */
+        size_type _batchSize;
+
+        /**
+         * Message buffers, one per buffer slot.
+         */
+        vector<vector<char>> _batches;
+
+        /**
+         * Number of entries packed into the message of the current send slot.
+         */
+        size_type _numPacked;
+
+        /**
+         * Number of bytes packed into the message of the current send slot, if delta encoded.
+         */
+        size_type _numPackedBytes;
+
+        /**
+         * Number of entries in the received message of the current receive slot and how many were already unpacked.
+         * Counted in bytes, if delta encoded.
+         */
+        size_type _numReceived;
+        size_type _numUnpacked;
+
+        bool_type isCompleted(const size_type & index);
+
+        /**
+         * Computes the layout of an entry and creates the datatype describing it.
+         */
+        void createEntryType();
+
+        void packEntry(const HistoryEntry & in, char * out) const;
+
+        HistoryEntry unpackEntry(const char * in) const;
+
+        /**
+         * Tests the receive request of the current receive slot and stores the number of received entries.
+         */
+        bool_type testReceive();
     };
 
 } /* namespace Synchronization */
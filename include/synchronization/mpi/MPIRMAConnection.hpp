@@ -0,0 +1,125 @@
+/** @addtogroup Synchronization
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_SYNCHRONIZATION_MPIRMACONNECTION_HPP_
+#define INCLUDE_SYNCHRONIZATION_MPIRMACONNECTION_HPP_
+
+#include <mpi.h>
+#include <cstdint>
+#include "synchronization/AbstractConnection.hpp"
+#include "synchronization/mpi/MPIChannels.hpp"
+
+namespace Synchronization
+{
+
+    /**
+     * This class implements a connection between two FMUs on different nodes using MPI one-sided communication.
+     * The destination exposes its ring of bufferSize entries in a dynamic MPI window. The source writes an entry
+     * with MPI_Put into the next slot and advances the tail counter of the ring with MPI_Accumulate afterwards. The
+     * destination reads the entries from its local memory and publishes how many it consumed in the head counter,
+     * which the source fetches when the ring seems to be full. No message matching is involved.
+     * The window is shared by all connections of a process and needs to be created after MPI_Init via
+     * createWindow().
+     */
+    class MPIRMAConnection : public AbstractConnection
+    {
+     public:
+        MPIRMAConnection(const Initialization::ConnectionPlan & in);
+
+        ~MPIRMAConnection();
+
+        /**
+         * Creates the dynamic window of the process. Collective over MPI_COMM_WORLD.
+         */
+        static void createWindow();
+
+        /**
+         * Frees the dynamic window of the process. Collective over MPI_COMM_WORLD, needs to be called before
+         * MPI_Finalize.
+         */
+        static void freeWindow();
+
+        /**
+         * The destination attaches its ring to the window and sends the ring's address to the source.
+         */
+        void initialize(const std::string & fmuName) override;
+
+        /**
+         * Writes the entry into the destination's ring.
+         * @param in DataHistoryElement to send.
+         * @return False, if the ring is full or the address of the ring didn't arrive yet.
+         */
+        bool send(const HistoryEntry & in) override;
+
+        /**
+         * Reads the next entry from the local ring.
+         * @return The received DataHistoryElement or an invalid one, if no entry is present.
+         */
+        HistoryEntry recv() override;
+
+        /**
+         * Checks if a free slot for send operations is present.
+         * @return 0 if a send operation would block, 2 if more than one slot is free.
+         */
+        int_type hasFreeBuffer() override;
+
+        /**
+         * @return True, if the tail of the local ring is ahead of the consumed entries.
+         */
+        bool_type pollReady() override;
+
+     private:
+        /**
+         * Offsets of the counters and the slots in the ring.
+         */
+        static const MPI_Aint _tailOffset = 0;
+        static const MPI_Aint _headOffset = sizeof(std::uint64_t);
+        static const MPI_Aint _slotOffset = 2 * sizeof(std::uint64_t);
+
+        static MPI_Win _window;
+
+        size_type _entrySize;
+
+        /**
+         * Memory of the ring, only allocated by the destination.
+         */
+        char * _ring;
+
+        /**
+         * Address of the destination's ring in the window and the request receiving it.
+         */
+        MPI_Aint _ringAddress;
+        MPI_Request _addressRequest;
+        bool_type _hasRingAddress;
+
+        /**
+         * Number of entries sent by the source and the number of consumed entries last fetched from the destination.
+         */
+        std::uint64_t _numSent;
+        std::uint64_t _remoteHead;
+
+        /**
+         * Number of entries consumed by the destination.
+         */
+        std::uint64_t _numReceived;
+
+        bool_type testRingAddress();
+
+        /**
+         * @return Number of free slots of the destination's ring, refreshes the consumed counter if none is free.
+         */
+        size_type getNumFreeSlots();
+
+        /**
+         * @return The tail counter of the local ring.
+         */
+        std::uint64_t fetchTail();
+    };
+
+} /* namespace Synchronization */
+#endif /* INCLUDE_SYNCHRONIZATION_MPIRMACONNECTION_HPP_ */
+/**
+ * @}
+ */
@@ -0,0 +1,55 @@
+/** @addtogroup Synchronization
+ *  @{
+ *  \copyright TU Dresden ZIH. All rights reserved.
+ */
+
+#ifndef INCLUDE_SYNCHRONIZATION_MPISHMCONNECTION_HPP_
+#define INCLUDE_SYNCHRONIZATION_MPISHMCONNECTION_HPP_
+
+#include <mpi.h>
+#include "synchronization/SharedMemoryConnection.hpp"
+
+namespace Synchronization
+{
+
+    /**
+     * This class implements a connection between two FMUs of different MPI ranks on the same node. The ring of the
+     * connection lies in a MPI shared memory window of the destination rank. No MPI call is made while simulating.
+     */
+    class MPISHMConnection : public SharedMemoryConnection
+    {
+     public:
+        MPISHMConnection(const Initialization::ConnectionPlan & in);
+
+        ~MPISHMConnection();
+
+        /**
+         * Finds the ranks sharing a node and turns the connections between them into "mpishm" connections, except for
+         * connections with sharedMemory set to false or "mpi" connections with batching or delta encoding. Afterwards
+         * the shared memory window holding the rings of all those connections is allocated. Collective over
+         * MPI_COMM_WORLD, every rank needs to pass the same plan.
+         * @param plan The plan of the program, the kind and shmOffset of its connection plans are set.
+         * @param rank The rank of the calling process.
+         */
+        static void createWindow(Initialization::ProgramPlan & plan, const int & rank);
+
+        /**
+         * Frees the shared memory window. Collective over MPI_COMM_WORLD, needs to be called before MPI_Finalize.
+         */
+        static void freeWindow();
+
+        /**
+         * Resolves the address of the ring in the destination's shared memory segment.
+         */
+        void initialize(const std::string & fmuName) override;
+
+     private:
+        static MPI_Win _window;
+        static MPI_Comm _nodeComm;
+    };
+
+} /* namespace Synchronization */
+#endif /* INCLUDE_SYNCHRONIZATION_MPISHMCONNECTION_HPP_ */
+/**
+ * @}
+ */
@@ -48,6 +48,16 @@ namespace Synchronization
          */
         int_type hasFreeBuffer() override;
 
+        /**
+         * Checks if the next entry arrived. Waits for the lock, if the other thread holds it.
+         */
+        bool_type pollReady() override;
+
+        bool_type notifies() const override
+        {
+            return true;
+        }
+
      private:
         omp_lock_t _writersLock;
     };
@@ -0,0 +1,64 @@
+/*
+ * FmuCache.hpp
+ */
+
+#ifndef INCLUDE_UTIL_FMUCACHE_HPP_
+#define INCLUDE_UTIL_FMUCACHE_HPP_
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace Util
+{
+    /**
+     * Extracts FMUs into a cache directory, which is shared by all runs and processes on a machine. The directory of
+     * an extracted FMU is named by the hash and size of the FMU file, so a changed FMU gets a new directory and
+     * unchanged FMUs are extracted only once. The FMU is unzipped in-process into a temporary directory, which is
+     * renamed atomically, so concurrent processes never see a partially extracted FMU.
+     * The least recently used FMUs are evicted, if the cache holds more than maxEntries FMUs.
+     */
+    class FmuCache
+    {
+        FmuCache() = delete;
+        FmuCache(const FmuCache &) = delete;
+     public:
+        /// Maximal number of extracted FMUs kept in a cache directory.
+        static const std::size_t maxEntries = 64;
+
+        /// Minimal time in seconds an unused FMU is kept, so processes which just looked it up don't lose it.
+        static const std::time_t minUnusedTime = 3600;
+
+        /**
+         * Looks up the FMU in the cache and extracts it on a miss.
+         * @param fmuPath The FMU archive.
+         * @param cachePath The cache directory. If empty, getDefaultPath() is used.
+         * @return The absolute path of the extracted FMU, ending with a slash.
+         * @throw runtime_error If the FMU can't be read or isn't a valid zip archive.
+         */
+        static std::string extract(const std::string & fmuPath, const std::string & cachePath);
+
+        /**
+         * @return The directory "parallelfmu-fmus" in the temporary directory of the machine.
+         */
+        static std::string getDefaultPath();
+
+        /**
+         * 64 bit FNV-1a hash.
+         */
+        static std::uint64_t hash(const std::vector<char> & data);
+
+     private:
+
+        static void unzip(const std::vector<char> & zip, const std::string & outPath);
+
+        /**
+         * Removes the least recently used FMUs and left over temporary directories.
+         */
+        static void evict(const std::string & cachePath, const std::string & keep);
+    };
+
+}
+
+#endif /* INCLUDE_UTIL_FMUCACHE_HPP_ */
@@ -0,0 +1,27 @@
+/*
+ * ThreadHelper.hpp
+ */
+
+#ifndef INCLUDE_UTIL_THREADHELPER_HPP_
+#define INCLUDE_UTIL_THREADHELPER_HPP_
+
+namespace Util
+{
+    class ThreadHelper
+    {
+        ThreadHelper() = delete;
+        ThreadHelper(const ThreadHelper &) = delete;
+     public:
+
+        /**
+         * Pins the calling thread to the given physical CPU. Memory touched first by the thread afterwards is placed
+         * on the NUMA node of this CPU.
+         * @param cpuId The physical CPU. If negative, the thread isn't pinned.
+         * @return True, if the thread was pinned.
+         */
+        static bool pinCurrentThread(const int & cpuId);
+    };
+
+}
+
+#endif /* INCLUDE_UTIL_THREADHELPER_HPP_ */
@@ -70,20 +70,23 @@ namespace Network
         void addRefsToMapping(FMI::InputMapping & mapping, const vector<string> & inputs, const FMI::ValueInfo & vi,
                               const FMI::ValueReferenceCollection & refs, bool fromFmu)
         {
+            // index of the fmu by value reference, the first index wins like in a linear search
+            const vector<size_type> & fmuRefs = refs.getValues<T>();
+            unordered_map<size_type, size_type> refToIndex(fmuRefs.size());
+            for (size_type j = 0; j < fmuRefs.size(); ++j)
+                refToIndex.insert(pair<size_type, size_type>(fmuRefs[j], j));
+
             for (size_type i = 0; i < inputs.size(); ++i)  // i is index of network vars
             {
-                size_type ref = vi.getReference<T>(inputs[i]);
-                for (size_type j = 0; j < refs.getValues<T>().size(); ++j)  // j is index of fmu
+                auto iter = refToIndex.find(vi.getReference<T>(inputs[i]));
+                if (iter != refToIndex.end())
                 {
-                    if (refs.getValues<T>()[j] == ref)
-                    {
-                        mapping.push_back<T>(
-                                ((!fromFmu) ?
-                                        make_tuple(i + _offsets[dataIndex<T>()], j) :
-                                        make_tuple(j, i + _offsets[dataIndex<T>()])));
-                        ++_offsets[dataIndex<T>()];
-                        break;
-                    }
+                    size_type j = iter->second;  // j is index of fmu
+                    mapping.push_back<T>(
+                            ((!fromFmu) ?
+                                    make_tuple(i + _offsets[dataIndex<T>()], j) :
+                                    make_tuple(j, i + _offsets[dataIndex<T>()])));
+                    ++_offsets[dataIndex<T>()];
                 }
             }
         }
@@ -195,6 +195,12 @@ namespace Solver
             return 0;
         }
 
+        real_type getInputHorizon() const override
+        {
+            // driven by client requests, not by inputs
+            return std::numeric_limits<real_type>::infinity();
+        }
+
      private:
         size_type _id;
         shared_ptr<DataManagerClass> _dataManager;
@@ -56,7 +56,7 @@ namespace Network
                 networkToReal->destRank = toExtend.mpiPos;
                 networkToReal->sourceRank = netMpiRank;
                 networkToReal->inputMapping = toExtend.inputMap;
-                networkToReal->startTag = numCons;
+                networkToReal->id = numCons;
                 ++numCons;
             }
 
@@ -70,7 +70,7 @@ namespace Network
                 realToNetwork->destRank = netMpiRank;
                 realToNetwork->sourceRank = toExtend.mpiPos;
                 realToNetwork->inputMapping = toExtend.outputMap;
-                realToNetwork->startTag = numCons;
+                realToNetwork->id = numCons;
                 ++numCons;
             }
 
@@ -17,16 +17,18 @@ namespace FMI
           _name(in.name),
           _path(in.path),
           _workingPath(in.workingPath),
+          _cachePath(in.cachePath),
           _loaded(false),
           _relativeTolerance(in.relTol),
           _toleranceControlled(in.tolControlled),
           _loggingEnabled(in.logEnabled),
           _intermediateResults(in.intermediateResults),
+          _coSimulation(in.coSimulation),
           _eventInfo(),
+          _typeInfo(make_shared<FmuTypeInfo>()),
           _outputValueReferences(),
           _inputValueReferences(),
           _time(0.0),
-          _valueInfo(),
           _numberOfStates(-1),
           _numberOfEventIndicators(-1)
     {
@@ -45,6 +47,7 @@ namespace FMI
 
     void AbstractFmu::unload()
     {
+        _statePool.clear([this](FmuSnapshot & snapshot) { freeStateInternal(snapshot); });
         _loaded = false;
     }
 
@@ -125,12 +128,14 @@ namespace FMI
 
     const ValueReferenceCollection & AbstractFmu::getAllValueReferences() const
     {
-        return _allValueReferences;
+        return _typeInfo->allValueReferences;
     }
 
     void AbstractFmu::setAllValueReferences(const ValueReferenceCollection& valueReferences)
     {
-        _allValueReferences = valueReferences;
+        shared_ptr<FmuTypeInfo> typeInfo = make_shared<FmuTypeInfo>(*_typeInfo);
+        typeInfo->allValueReferences = valueReferences;
+        _typeInfo = typeInfo;
     }
 
     const ValueReferenceCollection & AbstractFmu::getOutputValueReferences() const
@@ -171,16 +176,16 @@ namespace FMI
         switch(refType)
         {
             case ReferenceContainerType::ALL:
-                refs = &_allValueReferences;
+                refs = &_typeInfo->allValueReferences;
                 break;
             case ReferenceContainerType::START:
-                refs = &_startValueReferences;
+                refs = &_typeInfo->startValueReferences;
                 break;
             case ReferenceContainerType::EVENT:
-                refs = &_eventValueReferences;
+                refs = &_typeInfo->eventValueReferences;
                 break;
             case ReferenceContainerType::CONTINIOUS:
-                refs = &_continousValueReferences;
+                refs = &_typeInfo->continousValueReferences;
                 break;
         }
         ValueCollection res(refs->getValues<real_type>().size(), refs->getValues<int_type>().size(),
@@ -225,10 +230,26 @@ namespace FMI
 
     void AbstractFmu::setValues(const ValueCollection & values)
     {
-        setValuesInternal(values.getValues<real_type>(), _eventValueReferences.getValues<real_type>());
-        setValuesInternal(values.getValues<int_type>(), _eventValueReferences.getValues<int_type>());
-        setValuesInternal(values.getValues<bool_type>(), _eventValueReferences.getValues<bool_type>());
-        setValuesInternal(values.getValues<string_type>(), _eventValueReferences.getValues<string_type>());
+        setValuesInternal(values.getValues<real_type>(), _typeInfo->eventValueReferences.getValues<real_type>());
+        setValuesInternal(values.getValues<int_type>(), _typeInfo->eventValueReferences.getValues<int_type>());
+        setValuesInternal(values.getValues<bool_type>(), _typeInfo->eventValueReferences.getValues<bool_type>());
+        setValuesInternal(values.getValues<string_type>(), _typeInfo->eventValueReferences.getValues<string_type>());
+    }
+
+    void AbstractFmu::getValues(ValueCollection & values, const ValueSubset & subset) const
+    {
+        getValueSubset(values.getValues<real_type>(), subset);
+        getValueSubset(values.getValues<int_type>(), subset);
+        getValueSubset(values.getValues<bool_type>(), subset);
+        getValueSubset(values.getValues<string_type>(), subset);
+    }
+
+    void AbstractFmu::setValues(const ValueCollection & values, const ValueSubset & subset)
+    {
+        setValueSubset(values.getValues<real_type>(), subset);
+        setValueSubset(values.getValues<int_type>(), subset);
+        setValueSubset(values.getValues<bool_type>(), subset);
+        setValueSubset(values.getValues<string_type>(), subset);
     }
 
     void AbstractFmu::setOutputValueReferences(const ValueReferenceCollection& outputValues)
@@ -268,12 +289,28 @@ namespace FMI
 
     const ValueInfo & AbstractFmu::getValueInfo() const
     {
-        return _valueInfo;
+        return _typeInfo->valueInfo;
     }
 
     void AbstractFmu::setValueInfo(const ValueInfo & valueInfo)
     {
-        _valueInfo = valueInfo;
+        shared_ptr<FmuTypeInfo> typeInfo = make_shared<FmuTypeInfo>(*_typeInfo);
+        typeInfo->valueInfo = valueInfo;
+        _typeInfo = typeInfo;
+    }
+
+    const FmuTypeInfo & AbstractFmu::getTypeInfo() const
+    {
+        return *_typeInfo;
+    }
+
+    void AbstractFmu::setTypeInfo(const FmuTypeInfoSPtr & typeInfo)
+    {
+        _typeInfo = typeInfo;
+        _numberOfStates = typeInfo->numberOfStates;
+        _numberOfEventIndicators = typeInfo->numberOfEventIndicators;
+        _outputValueReferences = typeInfo->outputValueReferences;
+        _inputValueReferences = typeInfo->inputValueReferences;
     }
 
     bool AbstractFmu::hasIntermediateResults() const
@@ -288,18 +325,18 @@ namespace FMI
 
     void AbstractFmu::getValues(ValueCollection & values) const
     {
-        getValuesInternal(values.getValues<real_type>(), _eventValueReferences.getValues<real_type>());
-        getValuesInternal(values.getValues<int_type>(), _eventValueReferences.getValues<int_type>());
-        getValuesInternal(values.getValues<bool_type>(), _eventValueReferences.getValues<bool_type>());
-        getValuesInternal(values.getValues<string_type>(), _eventValueReferences.getValues<string_type>());
+        getValuesInternal(values.getValues<real_type>(), _typeInfo->eventValueReferences.getValues<real_type>());
+        getValuesInternal(values.getValues<int_type>(), _typeInfo->eventValueReferences.getValues<int_type>());
+        getValuesInternal(values.getValues<bool_type>(), _typeInfo->eventValueReferences.getValues<bool_type>());
+        getValuesInternal(values.getValues<string_type>(), _typeInfo->eventValueReferences.getValues<string_type>());
     }
 
     void AbstractFmu::getAllValues(ValueCollection & values) const
     {
-        getValuesInternal(values.getValues<real_type>(), _allValueReferences.getValues<real_type>());
-        getValuesInternal(values.getValues<int_type>(), _allValueReferences.getValues<int_type>());
-        getValuesInternal(values.getValues<bool_type>(), _allValueReferences.getValues<bool_type>());
-        //getValuesInternal(values.getValues<string_type>(), _allValueReferences.getValues<string_type>());
+        getValuesInternal(values.getValues<real_type>(), _typeInfo->allValueReferences.getValues<real_type>());
+        getValuesInternal(values.getValues<int_type>(), _typeInfo->allValueReferences.getValues<int_type>());
+        getValuesInternal(values.getValues<bool_type>(), _typeInfo->allValueReferences.getValues<bool_type>());
+        //getValuesInternal(values.getValues<string_type>(), _typeInfo->allValueReferences.getValues<string_type>());
     }
 
     const FmuEventInfo& AbstractFmu::getEventInfo() const
@@ -341,5 +378,207 @@ namespace FMI
         assert(values.getValues<string_type>().size() == references.getValues<string_type>().size());
     }
 
+    bool_type AbstractFmu::providesDirectionalDerivative() const
+    {
+        return false;
+    }
+
+    void AbstractFmu::getDirectionalDerivativeInternal(const real_type * /*seed*/, real_type * /*result*/)
+    {
+        throw runtime_error("AbstractFmu: The FMU " + _name + " doesn't provide directional derivatives.");
+    }
+
+    const vector<vector<size_type>> & AbstractFmu::getJacobianPattern() const
+    {
+        return _jacobianPattern;
+    }
+
+    bool AbstractFmu::isCoSimulation() const
+    {
+        return _coSimulation;
+    }
+
+    CoSimulationStepStatus AbstractFmu::doStep(const real_type & /*stepSize*/)
+    {
+        throw runtime_error("AbstractFmu: The FMU " + _name + " doesn't support co-simulation.");
+    }
+
+    CoSimulationStepStatus AbstractFmu::getStepStatus()
+    {
+        throw runtime_error("AbstractFmu: The FMU " + _name + " doesn't support co-simulation.");
+    }
+
+    void AbstractFmu::cancelStep()
+    {
+        throw runtime_error("AbstractFmu: The FMU " + _name + " can't cancel communication steps.");
+    }
+
+    bool_type AbstractFmu::canCancelStep() const
+    {
+        return false;
+    }
+
+    bool_type AbstractFmu::canHandleVariableStepSize() const
+    {
+        return false;
+    }
+
+    bool_type AbstractFmu::canGetAndSetState() const
+    {
+        return false;
+    }
+
+    size_type AbstractFmu::saveState()
+    {
+        size_type res = _statePool.acquire();
+        saveState(res);
+        return res;
+    }
+
+    void AbstractFmu::saveState(const size_type & snapshot)
+    {
+        FmuSnapshot & state = _statePool.get(snapshot);
+        state.time = _time;
+        state.eventInfo = _eventInfo;
+        saveStateInternal(state);
+    }
+
+    void AbstractFmu::restoreState(const size_type & snapshot)
+    {
+        const FmuSnapshot & state = _statePool.get(snapshot);
+        restoreStateInternal(state);
+        _time = state.time;
+        _eventInfo = state.eventInfo;
+    }
+
+    void AbstractFmu::releaseState(const size_type & snapshot)
+    {
+        _statePool.release(snapshot);
+    }
+
+    vector<char> AbstractFmu::serializeState(const size_type & /*snapshot*/)
+    {
+        throw runtime_error("AbstractFmu: The FMU " + _name + " can't serialize its state.");
+    }
+
+    size_type AbstractFmu::deserializeState(const vector<char> & /*buffer*/)
+    {
+        throw runtime_error("AbstractFmu: The FMU " + _name + " can't serialize its state.");
+    }
+
+    void AbstractFmu::saveStateInternal(FmuSnapshot & snapshot)
+    {
+        snapshot.states.resize(getNumStates());
+        getStates(snapshot.states);
+        // resizing keeps the memory of a recycled snapshot
+        snapshot.values.getValues<real_type>().resize(_typeInfo->eventValueReferences.getValues<real_type>().size());
+        snapshot.values.getValues<int_type>().resize(_typeInfo->eventValueReferences.getValues<int_type>().size());
+        snapshot.values.getValues<bool_type>().resize(_typeInfo->eventValueReferences.getValues<bool_type>().size());
+        snapshot.values.getValues<string_type>().resize(_typeInfo->eventValueReferences.getValues<string_type>().size());
+        getValues(snapshot.values);
+    }
+
+    void AbstractFmu::restoreStateInternal(const FmuSnapshot & snapshot)
+    {
+        setTime(snapshot.time);
+        setStates(snapshot.states);
+        setValues(snapshot.values);
+    }
+
+    void AbstractFmu::freeStateInternal(FmuSnapshot & /*snapshot*/)
+    {
+    }
+
+    void AbstractFmu::setJacobianPattern(const vector<vector<size_type>> & pattern)
+    {
+        size_type numStates = getNumStates();
+        _jacobianPattern = pattern;
+        _jacobianRows = vector<vector<size_type>>(numStates);
+        _jacobianColumnGroups.clear();
+        if (_jacobianPattern.empty())
+        {
+            // dense, every column on its own
+            for (size_type j = 0; j < numStates; ++j)
+            {
+                _jacobianRows[j].resize(numStates);
+                for (size_type i = 0; i < numStates; ++i)
+                    _jacobianRows[j][i] = i;
+                _jacobianColumnGroups.push_back(vector<size_type>(1, j));
+            }
+            return;
+        }
+        for (size_type i = 0; i < _jacobianPattern.size(); ++i)
+            for (const size_type j : _jacobianPattern[i])
+                _jacobianRows[j].push_back(i);
+
+        // greedy coloring: a column joins the first group, which doesn't use any of its rows yet
+        vector<vector<bool_type>> usedRows;
+        for (size_type j = 0; j < numStates; ++j)
+        {
+            size_type group = 0;
+            for (; group < _jacobianColumnGroups.size(); ++group)
+            {
+                bool_type isFree = true;
+                for (const size_type i : _jacobianRows[j])
+                    isFree = isFree && !usedRows[group][i];
+                if (isFree)
+                    break;
+            }
+            if (group == _jacobianColumnGroups.size())
+            {
+                _jacobianColumnGroups.push_back(vector<size_type>());
+                usedRows.push_back(vector<bool_type>(numStates, false));
+            }
+            _jacobianColumnGroups[group].push_back(j);
+            for (const size_type i : _jacobianRows[j])
+                usedRows[group][i] = true;
+        }
+    }
+
+    void AbstractFmu::getJacobian(real_type * jacobian)
+    {
+        size_type numStates = getNumStates();
+        if (_jacobianRows.size() != numStates)
+            setJacobianPattern(_jacobianPattern);
+        std::fill(jacobian, jacobian + numStates * numStates, 0.0);
+
+        const bool_type exact = providesDirectionalDerivative();
+        vector<real_type> states, stateDerivatives, seed(numStates), result(numStates);
+        if (!exact)
+        {
+            states = getStates();
+            stateDerivatives = getStateDerivatives();
+        }
+        for (const auto & group : _jacobianColumnGroups)
+        {
+            std::fill(seed.begin(), seed.end(), 0.0);
+            if (exact)
+            {
+                for (const size_type j : group)
+                    seed[j] = 1.0;
+                getDirectionalDerivativeInternal(seed.data(), result.data());
+            }
+            else
+            {
+                vector<real_type> perturbed(states);
+                for (const size_type j : group)
+                {
+                    seed[j] = 1.0e-8 * std::abs(states[j]) + 1.0e-8;
+                    perturbed[j] += seed[j];
+                }
+                setStates(perturbed);
+                getStateDerivatives(result);
+                for (size_type i = 0; i < numStates; ++i)
+                    result[i] -= stateDerivatives[i];
+            }
+            // every row of the group belongs to exactly one of its columns
+            for (const size_type j : group)
+                for (const size_type i : _jacobianRows[j])
+                    jacobian[j * numStates + i] = result[i] / seed[j];
+        }
+        if (!exact)
+            setStates(states);
+    }
+
 } /* namespace FMI */
 
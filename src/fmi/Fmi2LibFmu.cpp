@@ -0,0 +1,588 @@
+#ifdef USE_FMILIB
+
+#include <boost/filesystem.hpp>
+#include "fmi/Fmi2LibFmu.hpp"
+#include "util/FmuCache.hpp"
+
+namespace FMI
+{
+    map<string_type, weak_ptr<const FmuTypeInfo>> Fmi2LibFmu::_typeInfos;
+    std::mutex Fmi2LibFmu::_typeInfosMutex;
+
+    void deleteFmi2LibContext(fmi_import_context_t * in)
+    {
+        fmi_import_free_context(in);
+    }
+
+    void deleteFmi2LibFmuHandle(fmi2_import_t * in)
+    {
+        fmi2_import_free_instance(in);
+        fmi2_import_destroy_dllfmu(in);
+        fmi2_import_free(in);
+    }
+
+    Fmi2LibFmu::Fmi2LibFmu(const Initialization::FmuPlan & in)
+            : AbstractFmu(in),
+              _callbacks(),
+              _fmuEventInfo(),
+              _inEventMode(false),
+              _providesDirectionalDerivative(false),
+              _canRunAsynchronously(false),
+              _canHandleVariableStepSize(false),
+              _canGetAndSetState(false),
+              _canSerializeState(false),
+              _stepEndTime(0.0)
+    {
+        _callbacks.malloc = malloc;
+        _callbacks.calloc = calloc;
+        _callbacks.realloc = realloc;
+        _callbacks.free = free;
+        _callbacks.logger = jm_default_logger;
+        _callbacks.log_level = jm_log_level_error;
+        _callbacks.context = 0;
+    }
+
+    Fmi2LibFmu::~Fmi2LibFmu()
+    {
+    }
+
+    AbstractFmu * Fmi2LibFmu::duplicate()
+    {
+        throw runtime_error("The FMI library is not able to duplicate a fmu instance!");
+    }
+
+    void Fmi2LibFmu::load(const bool & alsoInit)
+    {
+        if (isLoaded())
+        {
+            LOGGER_WRITE("FMU already loaded", Util::LC_LOADER, Util::LL_WARNING);
+            return;
+        }
+        _path = boost::filesystem::absolute(_path).string();
+        // the FMU is extracted into the cache instead of the working directory
+        _workingPath = Util::FmuCache::extract(_path, _cachePath);
+        LOGGER_WRITE(string_type("Try to load FMI 2.0 FMU from ") + _path + string_type(" and work on ") + _workingPath,
+                     Util::LC_LOADER, Util::LL_DEBUG);
+
+        _context = std::shared_ptr<fmi_import_context_t>(fmi_import_allocate_context(&_callbacks), deleteFmi2LibContext);
+        // without a file name, the FMU library uses the already extracted FMU
+        if (fmi_import_get_fmi_version(_context.get(), nullptr, _workingPath.c_str()) != fmi_version_2_0_enu)
+        {
+            throw runtime_error("Fmi2LibFmu: " + _path + " isn't a FMI 2.0 FMU.");
+        }
+
+        fmi2_import_t * fmu = fmi2_import_parse_xml(_context.get(), _workingPath.c_str(), nullptr);
+        if (fmu == nullptr)
+        {
+            throw runtime_error("Fmi2LibFmu: Error parsing XML in FMU " + _path);
+        }
+        const fmi2_fmu_kind_enu_t kind = (_coSimulation) ? fmi2_fmu_kind_cs : fmi2_fmu_kind_me;
+        if (fmi2_import_get_fmu_kind(fmu) != kind && fmi2_import_get_fmu_kind(fmu) != fmi2_fmu_kind_me_and_cs)
+        {
+            fmi2_import_free(fmu);
+            throw runtime_error("Fmi2LibFmu: " + _path + " doesn't support "
+                    + string_type((_coSimulation) ? "co-simulation." : "model exchange."));
+        }
+
+        fmi2_callback_functions_t callBackFunctions;
+        callBackFunctions.logger = fmi2_log_forwarding;
+        callBackFunctions.allocateMemory = calloc;
+        callBackFunctions.freeMemory = free;
+        // the end of asynchronous communication steps is polled by getStepStatus()
+        callBackFunctions.stepFinished = nullptr;
+        callBackFunctions.componentEnvironment = fmu;
+
+        if (fmi2_import_create_dllfmu(fmu, kind, &callBackFunctions) == jm_status_error)
+        {
+            fmi2_import_free(fmu);
+            throw runtime_error("Fmi2LibFmu: Could not create the DLL loading mechanism.");
+        }
+        if (fmi2_import_instantiate(fmu, _name.c_str(), (_coSimulation) ? fmi2_cosimulation : fmi2_model_exchange,
+                                    nullptr, fmi2_false) == jm_status_error)
+        {
+            fmi2_import_destroy_dllfmu(fmu);
+            fmi2_import_free(fmu);
+            throw runtime_error("Fmi2LibFmu: fmi2Instantiate failed.");
+        }
+        _fmu = std::shared_ptr<fmi2_import_t>(fmu, deleteFmi2LibFmuHandle);
+        fmi2_import_set_debug_logging(fmu, _loggingEnabled ? fmi2_true : fmi2_false, 0, nullptr);
+
+        // sorted by the original order, so indices in the ModelStructure address this list
+        fmi2_import_variable_list_t * vl = fmi2_import_get_variable_list(fmu, 0);
+        // the cache directory identifies the content of the FMU
+        const string_type typeKey = _workingPath + ((_coSimulation) ? "#cs" : "#me");
+        FmuTypeInfoSPtr typeInfo = findTypeInfo(typeKey);
+        if (!typeInfo)
+        {
+            shared_ptr<FmuTypeInfo> info = make_shared<FmuTypeInfo>();
+            info->modelIdentifier = (_coSimulation) ? fmi2_import_get_model_identifier_CS(fmu)
+                                                    : fmi2_import_get_model_identifier_ME(fmu);
+            info->guid = fmi2_import_get_GUID(fmu);
+            info->defaultStartTime = fmi2_import_get_default_experiment_start(fmu);
+            info->defaultStopTime = fmi2_import_get_default_experiment_stop(fmu);
+            for (size_t k = 0; k < fmi2_import_get_variable_list_size(vl); ++k)
+            {
+                fmi2_import_variable_t * var = fmi2_import_get_variable(vl, k);
+                switch (fmi2_import_get_variable_base_type(var))
+                {
+                    case fmi2_base_type_real:
+                        addVariable<real_type>(var, *info);
+                        break;
+                    case fmi2_base_type_int:
+                    case fmi2_base_type_enum:  // enums are treated as integers
+                        addVariable<int_type>(var, *info);
+                        break;
+                    case fmi2_base_type_bool:
+                        addVariable<bool_type>(var, *info);
+                        break;
+                    case fmi2_base_type_str:
+                        addVariable<string_type>(var, *info);
+                        break;
+                    default:
+                        break;
+                }
+            }
+            // the states of a co-simulation slave are internal to its solver
+            if (!_coSimulation)
+            {
+                info->numberOfStates = fmi2_import_get_number_of_continuous_states(fmu);
+                info->numberOfEventIndicators = fmi2_import_get_number_of_event_indicators(fmu);
+            }
+            typeInfo = shareTypeInfo(typeKey, info);
+        }
+        setTypeInfo(typeInfo);
+
+        if (_coSimulation)
+        {
+            _canRunAsynchronously = fmi2_import_get_capability(fmu, fmi2_cs_canRunAsynchronuously) != 0;
+            _canHandleVariableStepSize = fmi2_import_get_capability(fmu,
+                                                                    fmi2_cs_canHandleVariableCommunicationStepSize)
+                    != 0;
+        }
+        else
+        {
+            readModelStructure(vl);
+
+            _providesDirectionalDerivative = fmi2_import_get_capability(fmu, fmi2_me_providesDirectionalDerivatives)
+                    != 0 && _stateReferences.size() == getNumStates();
+            LOGGER_WRITE(_name + (_providesDirectionalDerivative ? " provides" : " doesn't provide")
+                    + string_type(" directional derivatives"), Util::LC_LOADER, Util::LL_DEBUG);
+        }
+        fmi2_import_free_variable_list(vl);
+        _canGetAndSetState = fmi2_import_get_capability(
+                fmu, (_coSimulation) ? fmi2_cs_canGetAndSetFMUstate : fmi2_me_canGetAndSetFMUstate) != 0;
+        _canSerializeState = _canGetAndSetState
+                && fmi2_import_get_capability(
+                        fmu, (_coSimulation) ? fmi2_cs_canSerializeFMUstate : fmi2_me_canSerializeFMUstate) != 0;
+
+        AbstractFmu::load(alsoInit);
+        if (alsoInit)
+            initialize();
+    }
+
+    void Fmi2LibFmu::readModelStructure(fmi2_import_variable_list_t * variables)
+    {
+        _stateReferences.clear();
+        _derivativeReferences.clear();
+        fmi2_import_variable_list_t * derivatives = fmi2_import_get_derivatives_list(_fmu.get());
+        if (derivatives == nullptr)
+            return;
+        map<fmi2_value_reference_t, size_type> stateIndices;
+        for (size_t i = 0; i < fmi2_import_get_variable_list_size(derivatives); ++i)
+        {
+            fmi2_import_real_variable_t * der = fmi2_import_get_variable_as_real(fmi2_import_get_variable(derivatives, i));
+            fmi2_import_real_variable_t * state = fmi2_import_get_real_variable_derivative_of(der);
+            if (state == nullptr)
+                throw runtime_error("Fmi2LibFmu: The derivative " + to_string(i) + " has no state.");
+            _derivativeReferences.push_back(fmi2_import_get_real_variable_vr(der));
+            _stateReferences.push_back(fmi2_import_get_real_variable_vr(state));
+            stateIndices[_stateReferences.back()] = i;
+        }
+        fmi2_import_free_variable_list(derivatives);
+
+        size_t * startIndex = nullptr, * dependency = nullptr;
+        char * factorKind = nullptr;
+        fmi2_import_get_derivatives_dependencies(_fmu.get(), &startIndex, &dependency, &factorKind);
+        if (startIndex == nullptr || _stateReferences.size() != getNumStates())
+        {
+            setJacobianPattern(vector<vector<size_type>>());
+            return;
+        }
+        vector<vector<size_type>> pattern(_stateReferences.size());
+        for (size_type i = 0; i < pattern.size(); ++i)
+        {
+            for (size_t k = startIndex[i]; k < startIndex[i + 1]; ++k)
+            {
+                // 1-based index into the model variables, 0 means the derivative depends on everything
+                if (dependency[k] == 0)
+                {
+                    setJacobianPattern(vector<vector<size_type>>());
+                    return;
+                }
+                fmi2_import_variable_t * var = fmi2_import_get_variable(variables, dependency[k] - 1);
+                auto it = stateIndices.find(fmi2_import_get_variable_vr(var));
+                // dependencies on inputs don't belong to the Jacobian of the states
+                if (fmi2_import_get_variable_base_type(var) == fmi2_base_type_real && it != stateIndices.end())
+                    pattern[i].push_back(it->second);
+            }
+        }
+        setJacobianPattern(pattern);
+    }
+
+    FmuTypeInfoSPtr Fmi2LibFmu::findTypeInfo(const string_type & key)
+    {
+        std::lock_guard<std::mutex> lock(_typeInfosMutex);
+        auto iter = _typeInfos.find(key);
+        return (iter != _typeInfos.end()) ? iter->second.lock() : FmuTypeInfoSPtr();
+    }
+
+    FmuTypeInfoSPtr Fmi2LibFmu::shareTypeInfo(const string_type & key, const FmuTypeInfoSPtr & typeInfo)
+    {
+        std::lock_guard<std::mutex> lock(_typeInfosMutex);
+        weak_ptr<const FmuTypeInfo> & known = _typeInfos[key];
+        FmuTypeInfoSPtr res = known.lock();
+        // another instance read the FMU meanwhile
+        if (res)
+            return res;
+        // drop the entries of FMU types without instances
+        for (auto iter = _typeInfos.begin(); iter != _typeInfos.end();)
+        {
+            if (iter->second.expired() && iter->first != key)
+                iter = _typeInfos.erase(iter);
+            else
+                ++iter;
+        }
+        known = typeInfo;
+        return typeInfo;
+    }
+
+    void Fmi2LibFmu::initialize()
+    {
+        fmi2_import_t * fmu = _fmu.get();
+        const FmuTypeInfo & info = getTypeInfo();
+        fmi2_import_set_real(fmu, info.startValueReferences.getValues<real_type>().data(),
+                             info.startValueReferences.getValues<real_type>().size(),
+                             info.startValues.getValues<real_type>().data());
+        fmi2_import_set_integer(fmu, info.startValueReferences.getValues<int_type>().data(),
+                                info.startValueReferences.getValues<int_type>().size(),
+                                info.startValues.getValues<int_type>().data());
+        setValuesInternal(info.startValues.getValues<bool_type>(), info.startValueReferences.getValues<bool_type>());
+
+        check(fmi2_import_setup_experiment(fmu, isToleranceControlled() ? fmi2_true : fmi2_false, getRelativeTolerance(),
+                                           getTime(), fmi2_false, 0.0),
+              "fmi2SetupExperiment");
+        check(fmi2_import_enter_initialization_mode(fmu), "fmi2EnterInitializationMode");
+        check(fmi2_import_exit_initialization_mode(fmu), "fmi2ExitInitializationMode");
+        _stepEndTime = getTime();
+        if (_coSimulation)
+            return;
+        // the FMU is in event mode after the initialization
+        _inEventMode = true;
+        _fmuEventInfo.newDiscreteStatesNeeded = fmi2_true;
+        while (_fmuEventInfo.newDiscreteStatesNeeded && !_fmuEventInfo.terminateSimulation)
+            eventUpdate();
+    }
+
+    FmuEventInfo Fmi2LibFmu::eventUpdate()
+    {
+        // co-simulation slaves handle their events internally
+        if (_coSimulation)
+            return _eventInfo;
+        if (!_inEventMode)
+        {
+            check(fmi2_import_enter_event_mode(_fmu.get()), "fmi2EnterEventMode");
+            _inEventMode = true;
+        }
+        do
+        {
+            check(fmi2_import_new_discrete_states(_fmu.get(), &_fmuEventInfo), "fmi2NewDiscreteStates");
+        }
+        while (!_intermediateResults && _fmuEventInfo.newDiscreteStatesNeeded && !_fmuEventInfo.terminateSimulation);
+
+        if (!_fmuEventInfo.newDiscreteStatesNeeded)
+        {
+            check(fmi2_import_enter_continuous_time_mode(_fmu.get()), "fmi2EnterContinuousTimeMode");
+            _inEventMode = false;
+        }
+        _eventInfo.assign(_fmuEventInfo);
+        return _eventInfo;
+    }
+
+    double Fmi2LibFmu::getDefaultStart() const
+    {
+        return fmi2_import_get_default_experiment_start(_fmu.get());
+    }
+
+    double Fmi2LibFmu::getDefaultStop() const
+    {
+        return fmi2_import_get_default_experiment_stop(_fmu.get());
+    }
+
+    bool_type Fmi2LibFmu::providesDirectionalDerivative() const
+    {
+        return _providesDirectionalDerivative;
+    }
+
+    CoSimulationStepStatus Fmi2LibFmu::doStep(const real_type & stepSize)
+    {
+        _stepEndTime = getTime() + stepSize;
+        return finishStep(fmi2_import_do_step(_fmu.get(), getTime(), stepSize, fmi2_true));
+    }
+
+    CoSimulationStepStatus Fmi2LibFmu::getStepStatus()
+    {
+        fmi2_status_t status;
+        check(fmi2_import_get_status(_fmu.get(), fmi2_do_step_status, &status), "fmi2GetStatus");
+        return finishStep(status);
+    }
+
+    void Fmi2LibFmu::cancelStep()
+    {
+        check(fmi2_import_cancel_step(_fmu.get()), "fmi2CancelStep");
+    }
+
+    bool_type Fmi2LibFmu::canCancelStep() const
+    {
+        // fmi2CancelStep is only defined for asynchronous communication steps
+        return _canRunAsynchronously;
+    }
+
+    bool_type Fmi2LibFmu::canHandleVariableStepSize() const
+    {
+        return _canHandleVariableStepSize;
+    }
+
+    CoSimulationStepStatus Fmi2LibFmu::finishStep(const fmi2_status_t & status)
+    {
+        switch (status)
+        {
+            case fmi2_status_pending:
+                return CoSimulationStepStatus::PENDING;
+            case fmi2_status_discard:
+            {
+                fmi2_real_t lastTime = getTime();
+                fmi2_import_get_real_status(_fmu.get(), fmi2_last_successful_time, &lastTime);
+                AbstractFmu::setTime(lastTime);
+                LOGGER_WRITE(_name + " discarded its step to " + to_string(_stepEndTime) + " at " + to_string(lastTime),
+                             Util::LC_SOLVER, Util::LL_WARNING);
+                return CoSimulationStepStatus::DISCARDED;
+            }
+            default:
+                check(status, "fmi2DoStep");
+                AbstractFmu::setTime(_stepEndTime);
+                return CoSimulationStepStatus::DONE;
+        }
+    }
+
+    bool_type Fmi2LibFmu::canGetAndSetState() const
+    {
+        return _canGetAndSetState;
+    }
+
+    void Fmi2LibFmu::saveStateInternal(FmuSnapshot & snapshot)
+    {
+        if (!_canGetAndSetState)
+            return AbstractFmu::saveStateInternal(snapshot);
+        fmi2_FMU_state_t state = snapshot.handle;
+        check(fmi2_import_get_fmu_state(_fmu.get(), &state), "fmi2GetFMUstate");
+        snapshot.handle = state;
+    }
+
+    void Fmi2LibFmu::restoreStateInternal(const FmuSnapshot & snapshot)
+    {
+        if (snapshot.handle == nullptr)
+            return AbstractFmu::restoreStateInternal(snapshot);
+        check(fmi2_import_set_fmu_state(_fmu.get(), snapshot.handle), "fmi2SetFMUstate");
+        // the event mode isn't part of the snapshot, but the state is only saved between events
+        _inEventMode = false;
+    }
+
+    void Fmi2LibFmu::freeStateInternal(FmuSnapshot & snapshot)
+    {
+        fmi2_FMU_state_t state = snapshot.handle;
+        fmi2_import_free_fmu_state(_fmu.get(), &state);
+        snapshot.handle = nullptr;
+    }
+
+    vector<char> Fmi2LibFmu::serializeState(const size_type & snapshot)
+    {
+        if (!_canSerializeState)
+            return AbstractFmu::serializeState(snapshot);
+        const FmuSnapshot & state = _statePool.get(snapshot);
+        size_t size = 0;
+        check(fmi2_import_serialized_fmu_state_size(_fmu.get(), state.handle, &size), "fmi2SerializedFMUstateSize");
+        vector<char> res(sizeof(real_type) + size);
+        std::memcpy(res.data(), &state.time, sizeof(real_type));
+        check(fmi2_import_serialize_fmu_state(_fmu.get(), state.handle, res.data() + sizeof(real_type), size),
+              "fmi2SerializeFMUstate");
+        return res;
+    }
+
+    size_type Fmi2LibFmu::deserializeState(const vector<char> & buffer)
+    {
+        if (!_canSerializeState)
+            return AbstractFmu::deserializeState(buffer);
+        if (buffer.size() < sizeof(real_type))
+            throw runtime_error("Fmi2LibFmu: The serialized state is truncated.");
+        fmi2_FMU_state_t handle = nullptr;
+        check(fmi2_import_de_serialize_fmu_state(_fmu.get(), buffer.data() + sizeof(real_type),
+                                                 buffer.size() - sizeof(real_type), &handle),
+              "fmi2DeSerializeFMUstate");
+        size_type res = _statePool.acquire();
+        FmuSnapshot & state = _statePool.get(res);
+        // fmi2DeSerializeFMUstate allocated a new state, so the one of a recycled snapshot isn't needed anymore
+        if (state.handle != nullptr)
+            freeStateInternal(state);
+        std::memcpy(&state.time, buffer.data(), sizeof(real_type));
+        state.eventInfo = FmuEventInfo();
+        state.handle = handle;
+        return res;
+    }
+
+    void Fmi2LibFmu::check(const fmi2_status_t & status, const string_type & function) const
+    {
+        if (status != fmi2_status_ok && status != fmi2_status_warning)
+            throw runtime_error("Fmi2LibFmu: " + function + " failed for " + _name);
+    }
+
+    void Fmi2LibFmu::getStatesInternal(real_type * states) const
+    {
+        if (_coSimulation)
+            return;
+        fmi2_import_get_continuous_states(_fmu.get(), states, getNumStates());
+    }
+
+    void Fmi2LibFmu::setStatesInternal(const real_type * states)
+    {
+        if (_coSimulation)
+            return;
+        fmi2_import_set_continuous_states(_fmu.get(), states, getNumStates());
+    }
+
+    void Fmi2LibFmu::getStateDerivativesInternal(real_type * stateDerivatives)
+    {
+        if (_coSimulation)
+            return;
+        fmi2_import_get_derivatives(_fmu.get(), stateDerivatives, getNumStates());
+    }
+
+    void Fmi2LibFmu::getEventIndicatorsInternal(real_type * eventIndicators)
+    {
+        if (_coSimulation)
+            return;
+        fmi2_import_get_event_indicators(_fmu.get(), eventIndicators, getNumEventIndicators());
+    }
+
+    void Fmi2LibFmu::getDirectionalDerivativeInternal(const real_type * seed, real_type * result)
+    {
+        check(fmi2_import_get_directional_derivative(_fmu.get(), _stateReferences.data(), _stateReferences.size(),
+                                                     _derivativeReferences.data(), _derivativeReferences.size(), seed,
+                                                     result),
+              "fmi2GetDirectionalDerivative");
+    }
+
+    void Fmi2LibFmu::unload()
+    {
+        AbstractFmu::unload();
+        _fmu.reset();
+        _context.reset();
+    }
+
+    void Fmi2LibFmu::getValuesInternal(vector<real_type> & out, const vector<size_type> & references) const
+    {
+        fmi2_import_get_real(_fmu.get(), references.data(), references.size(), out.data());
+    }
+
+    void Fmi2LibFmu::getValuesInternal(vector<int_type> & out, const vector<size_type> & references) const
+    {
+        fmi2_import_get_integer(_fmu.get(), references.data(), references.size(), out.data());
+    }
+
+    void Fmi2LibFmu::getValuesInternal(vector<bool_type> & out, const vector<size_type> & references) const
+    {
+        // fmi2Boolean is an int
+        vector<fmi2_boolean_t> values(references.size());
+        fmi2_import_get_boolean(_fmu.get(), references.data(), references.size(), values.data());
+        for (size_type i = 0; i < references.size(); ++i)
+            out[i] = static_cast<bool_type>(values[i] != fmi2_false);
+    }
+
+    void Fmi2LibFmu::getValuesInternal(vector<string_type> & out, const vector<size_type> & references) const
+    {
+        vector<fmi2_string_t> values(references.size());
+        fmi2_import_get_string(_fmu.get(), references.data(), references.size(), values.data());
+        for (size_type i = 0; i < references.size(); ++i)
+            out[i] = string_type(values[i]);
+    }
+
+    void Fmi2LibFmu::setValuesInternal(const vector<real_type> & in, const vector<size_type> & references)
+    {
+        fmi2_import_set_real(_fmu.get(), references.data(), references.size(), in.data());
+    }
+
+    void Fmi2LibFmu::setValuesInternal(const vector<int_type> & in, const vector<size_type> & references)
+    {
+        fmi2_import_set_integer(_fmu.get(), references.data(), references.size(), in.data());
+    }
+
+    void Fmi2LibFmu::setValuesInternal(const vector<bool_type> & in, const vector<size_type> & references)
+    {
+        vector<fmi2_boolean_t> values(references.size());
+        for (size_type i = 0; i < references.size(); ++i)
+            values[i] = in[i] ? fmi2_true : fmi2_false;
+        fmi2_import_set_boolean(_fmu.get(), references.data(), references.size(), values.data());
+    }
+
+    void Fmi2LibFmu::setValuesInternal(const vector<string_type> & in, const vector<size_type> & references)
+    {
+        vector<fmi2_string_t> values(references.size());
+        for (size_type i = 0; i < references.size(); ++i)
+            values[i] = in[i].c_str();
+        fmi2_import_set_string(_fmu.get(), references.data(), references.size(), values.data());
+    }
+
+    void Fmi2LibFmu::stepCompleted()
+    {
+        if (_coSimulation)
+            return;
+        fmi2_boolean_t enterEventMode = fmi2_false, terminateSimulation = fmi2_false;
+        fmi2_import_completed_integrator_step(_fmu.get(), fmi2_true, &enterEventMode, &terminateSimulation);
+    }
+
+    void Fmi2LibFmu::setTime(const double & time)
+    {
+        AbstractFmu::setTime(time);
+        if (!_coSimulation)
+            fmi2_import_set_time(_fmu.get(), time);
+    }
+
+    template<>
+    real_type Fmi2LibFmu::getStartValue<real_type>(fmi2_import_variable_t * variable)
+    {
+        return fmi2_import_get_real_variable_start(fmi2_import_get_variable_as_real(variable));
+    }
+
+    template<>
+    int_type Fmi2LibFmu::getStartValue<int_type>(fmi2_import_variable_t * variable)
+    {
+        if (fmi2_import_get_variable_base_type(variable) == fmi2_base_type_enum)
+            return fmi2_import_get_enum_variable_start(fmi2_import_get_variable_as_enum(variable));
+        return fmi2_import_get_integer_variable_start(fmi2_import_get_variable_as_integer(variable));
+    }
+
+    template<>
+    bool_type Fmi2LibFmu::getStartValue<bool_type>(fmi2_import_variable_t * variable)
+    {
+        return static_cast<bool_type>(fmi2_import_get_boolean_variable_start(fmi2_import_get_variable_as_boolean(variable))
+                != fmi2_false);
+    }
+
+    template<>
+    string_type Fmi2LibFmu::getStartValue<string_type>(fmi2_import_variable_t * variable)
+    {
+        return string_type(fmi2_import_get_string_variable_start(fmi2_import_get_variable_as_string(variable)));
+    }
+
+} /* namespace FMI */
+
+#endif
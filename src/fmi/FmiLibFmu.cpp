@@ -6,6 +6,7 @@
 namespace FMI
 {
     set<string_type> FmiLibFmu::_loadedFmuObjects;
+    std::mutex FmiLibFmu::_loadedFmuObjectsMutex;
 
     void deleteFmiLibContext(fmi_import_context_t * in)
     {
@@ -33,6 +34,7 @@ namespace FMI
 
     FmiLibFmu::~FmiLibFmu()
     {
+        std::lock_guard<std::mutex> lock(_loadedFmuObjectsMutex);
         if (_posPath != _loadedFmuObjects.end())
             _loadedFmuObjects.erase(_posPath);
     }
@@ -62,8 +64,13 @@ namespace FMI
         _path = boost::filesystem::absolute(_path).string();
         _workingPath = boost::filesystem::absolute(_workingPath).string();
 
-        if (_loadedFmuObjects.find(_path) != _loadedFmuObjects.end())
-            throw runtime_error("FMI Library is not able to load a FMU multiple times!");
+        {
+            // reserved right away, so instances loaded in parallel can't load the same FMU
+            std::lock_guard<std::mutex> lock(_loadedFmuObjectsMutex);
+            if (_loadedFmuObjects.find(_path) != _loadedFmuObjects.end())
+                throw runtime_error("FMI Library is not able to load a FMU multiple times!");
+            _posPath = _loadedFmuObjects.insert(_path).first;
+        }
 
         //version = fmi_import_get_fmi_version(_context.get(), _path.c_str(), _workingPath.c_str());
         if (version != fmi_version_1_enu)
@@ -93,6 +100,12 @@ namespace FMI
             throw runtime_error("fmi1_import_instantiate_model failed.");
         }
 
+        // the FMI Library loads every FMU only once, so the metadata isn't shared
+        shared_ptr<FmuTypeInfo> info = make_shared<FmuTypeInfo>();
+        info->modelIdentifier = fmi1_import_get_model_identifier(_fmu.get());
+        info->guid = fmi1_import_get_GUID(_fmu.get());
+        info->defaultStartTime = fmi1_import_get_default_experiment_start(_fmu.get());
+        info->defaultStopTime = fmi1_import_get_default_experiment_stop(_fmu.get());
         fmi1_import_variable_t* var;
         fmi1_import_variable_list_t * vl = fmi1_import_get_variable_list(_fmu.get());
 
@@ -102,38 +115,38 @@ namespace FMI
             switch (fmi1_import_get_variable_base_type(var))
             {
                 case fmi1_base_type_real:
-                    addVariable<real_type>(var);
+                    addVariable<real_type>(var, *info);
                     break;
                 case fmi1_base_type_int:
-                    addVariable<int_type>(var);
+                    addVariable<int_type>(var, *info);
                     break;
                 case fmi1_base_type_bool:
-                    addVariable<bool_type>(var);
+                    addVariable<bool_type>(var, *info);
                     break;
                 case fmi1_base_type_str:
-                    addVariable<string_type>(var);
+                    addVariable<string_type>(var, *info);
                     break;
                 default:
                     break;
             }
         }
-        setNumStates(fmi1_import_get_number_of_continuous_states(_fmu.get()));
-        setNumEventIndicators(fmi1_import_get_number_of_event_indicators(_fmu.get()));
-        _posPath = _loadedFmuObjects.insert(_path).first;
+        info->numberOfStates = fmi1_import_get_number_of_continuous_states(_fmu.get());
+        info->numberOfEventIndicators = fmi1_import_get_number_of_event_indicators(_fmu.get());
         fmi1_import_free_variable_list(vl);
-        //AbstractFmu::load(alsoInit);
+        setTypeInfo(info);
+        AbstractFmu::load(alsoInit);
         if(alsoInit)
             initialize();
     }
 
     void FmiLibFmu::initialize()
     {
-        fmi1_import_set_real(_fmu.get(), (const unsigned int *) _startValueReferences.getValues<real_type>().data(),
-                             _startValueReferences.getValues<real_type>().size(), _startValues.getValues<real_type>().data());
-        fmi1_import_set_integer(_fmu.get(), (const unsigned int *) _startValueReferences.getValues<int_type>().data(),
-                                _startValueReferences.getValues<int_type>().size(), _startValues.getValues<int_type>().data());
-        fmi1_import_set_boolean(_fmu.get(), (const unsigned int *) _startValueReferences.getValues<bool_type>().data(),
-                                _startValueReferences.getValues<bool_type>().size(), _startValues.getValues<bool_type>().data());
+        fmi1_import_set_real(_fmu.get(), (const unsigned int *) _typeInfo->startValueReferences.getValues<real_type>().data(),
+                             _typeInfo->startValueReferences.getValues<real_type>().size(), _typeInfo->startValues.getValues<real_type>().data());
+        fmi1_import_set_integer(_fmu.get(), (const unsigned int *) _typeInfo->startValueReferences.getValues<int_type>().data(),
+                                _typeInfo->startValueReferences.getValues<int_type>().size(), _typeInfo->startValues.getValues<int_type>().data());
+        fmi1_import_set_boolean(_fmu.get(), (const unsigned int *) _typeInfo->startValueReferences.getValues<bool_type>().data(),
+                                _typeInfo->startValueReferences.getValues<bool_type>().size(), _typeInfo->startValues.getValues<bool_type>().data());
         //fmi1_import_set_string_type(_fmu.get(), _startValueReferences.getValues<string_type >().data(), _startValueReferences.getValues<string_type >().size(),_startValues.getValues<string_type >().data());
 
         fmi1_import_initialize(_fmu.get(), toFmi1Boolean(isToleranceControlled()), getRelativeTolerance(), &_fmuEventInfo);
@@ -97,6 +97,16 @@ namespace FMI
         setTerminateSimulation(eventInfoSource.terminateSimulation);
         setUpcomingTimeEvent(eventInfoSource.upcomingTimeEvent);
     }
+
+    void FmuEventInfo::assign(const fmi2_event_info_t & eventInfoSource)
+    {
+        setIterationConverged(!eventInfoSource.newDiscreteStatesNeeded);
+        setNextEventTime(eventInfoSource.nextEventTime);
+        setStateValueReferencesChanged(eventInfoSource.nominalsOfContinuousStatesChanged);
+        setStateValuesChanged(eventInfoSource.valuesOfContinuousStatesChanged);
+        setTerminateSimulation(eventInfoSource.terminateSimulation);
+        setUpcomingTimeEvent(eventInfoSource.nextEventTimeDefined);
+    }
 #endif
 
 } /* namespace FMI */
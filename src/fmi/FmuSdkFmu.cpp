@@ -1,12 +1,16 @@
 #include <boost/filesystem.hpp>
 #include "fmi/FmuSdkFmu.hpp"
+#include "fmi/ModelDescriptionCache.hpp"
 #include "fmi/ValueReferenceCollection.hpp"
+#include "util/FmuCache.hpp"
 #include <xml_parser.h>
 
 namespace FMI
 {
 
-    map<string_type, tuple<FMU *, size_type>> FmuSdkFmu::_knownFmus;
+    map<string_type, tuple<std::shared_future<pair<FMU *, FmuTypeInfoSPtr>>, size_type>> FmuSdkFmu::_knownFmus;
+    std::mutex FmuSdkFmu::_knownFmusMutex;
+    std::mutex FmuSdkFmu::_parserMutex;
 
     FmuSdkFmu::FmuSdkFmu(const Initialization::FmuPlan & in)
             : AbstractFmu(in),
@@ -26,68 +30,39 @@ namespace FMI
     {
         _path = boost::filesystem::absolute(_path).string();
 
-        _fmu = getFmuHandle(_path);
+        FmuTypeInfoSPtr typeInfo;
+        _fmu = getFmuHandle(_path, typeInfo);
+        setTypeInfo(typeInfo);
         _componentEventInfo = fmiEventInfo();
 
         _workingPath = boost::filesystem::absolute(_workingPath).string();
-        ModelDescription *modelDescription = _fmu->modelDescription;
-        string_type guid = string_type(getString(modelDescription, att_guid));
         LOGGER_WRITE(string_type("Try to load FMU from ") + _path + string_type(" and work on ") + _workingPath,
                      Util::LC_LOADER, Util::LL_DEBUG);
 
-        _component = _fmu->instantiateModel(getModelIdentifier(modelDescription), guid.c_str(), _callbacks,
+        _component = _fmu->instantiateModel(_typeInfo->modelIdentifier.c_str(), _typeInfo->guid.c_str(), _callbacks,
                                             _loggingEnabled);
 
         if (_component == nullptr)
             throw runtime_error("Could not instantiate FMU");
 
-        for (size_type i = 0; modelDescription->modelVariables[i] != nullptr; i++)
-        {
-            ScalarVariable *variable = modelDescription->modelVariables[i];
-
-            switch (getVariableType(variable))
-            {
-                case VarType::varReal:
-                    addVariable<real_type>(modelDescription->modelVariables[i]);
-                    break;
-                case VarType::varInt:
-                    addVariable<int_type>(modelDescription->modelVariables[i]);
-                    break;
-                case VarType::varBool:
-                    addVariable<bool_type>(modelDescription->modelVariables[i]);
-                    break;
-                case VarType::varString:
-                    addVariable<string_type>(modelDescription->modelVariables[i]);
-                    break;
-                case VarType::varEnum:
-                    addVariable<int_type>(modelDescription->modelVariables[i]);  // enums are treated as integers
-                    break;
-                default:
-                    throw runtime_error("FmuSdkFmu: VarType unknown.");
-            }
-        }
-
-        _numberOfStates = getNumberOfStates(modelDescription);
-        _numberOfEventIndicators = getNumberOfEventIndicators(modelDescription);
-
         //std::cout << "start refs: [" << _startValueReferences << "]\n";
         //std::cout << "start vals: [" << _startValues << "]\n";
 
         AbstractFmu::load(alsoInit);
-        if (!_startValueReferences.getValues<real_type>().empty())
-            _fmu->setReal(_component, _startValueReferences.getValues<real_type>().data(),
-                          _startValueReferences.getValues<real_type>().size(),
-                          _startValues.getValues<real_type>().data());
+        if (!_typeInfo->startValueReferences.getValues<real_type>().empty())
+            _fmu->setReal(_component, _typeInfo->startValueReferences.getValues<real_type>().data(),
+                          _typeInfo->startValueReferences.getValues<real_type>().size(),
+                          _typeInfo->startValues.getValues<real_type>().data());
 
-        if (!_startValueReferences.getValues<bool_type>().empty())
-            _fmu->setBoolean(_component, _startValueReferences.getValues<real_type>().data(),
-                             _startValueReferences.getValues<real_type>().size(),
-                             _startValues.getValues<bool_type>().data());
+        if (!_typeInfo->startValueReferences.getValues<bool_type>().empty())
+            _fmu->setBoolean(_component, _typeInfo->startValueReferences.getValues<real_type>().data(),
+                             _typeInfo->startValueReferences.getValues<real_type>().size(),
+                             _typeInfo->startValues.getValues<bool_type>().data());
 
-        if (!_startValueReferences.getValues<int_type>().empty())
-            _fmu->setInteger(_component, _startValueReferences.getValues<real_type>().data(),
-                             _startValueReferences.getValues<real_type>().size(),
-                             _startValues.getValues<int_type>().data());
+        if (!_typeInfo->startValueReferences.getValues<int_type>().empty())
+            _fmu->setInteger(_component, _typeInfo->startValueReferences.getValues<real_type>().data(),
+                             _typeInfo->startValueReferences.getValues<real_type>().size(),
+                             _typeInfo->startValues.getValues<int_type>().data());
 
         if (alsoInit)
             initialize();
@@ -99,6 +74,7 @@ namespace FMI
         if (_fmu != nullptr)
         {
             _fmu->freeModelInstance(_component);
+            std::lock_guard<std::mutex> lock(_knownFmusMutex);
             --get<1>(_knownFmus.at(string(_fmu->path)));
             if (get<1>(_knownFmus.at(string(_fmu->path))) == 0)
             {
@@ -136,18 +112,12 @@ namespace FMI
 
     double FmuSdkFmu::getDefaultStart() const
     {
-        if (_fmu->modelDescription == nullptr)
-            runtime_error("FmuSdkFmu: No model description defined in FMU-structure.");
-
-        return getDefaultStartTime(_fmu->modelDescription);
+        return _typeInfo->defaultStartTime;
     }
 
     double FmuSdkFmu::getDefaultStop() const
     {
-        if (_fmu->modelDescription == nullptr)
-            runtime_error("FmuSdkFmu: No model description defined in FMU-structure.");
-
-        return getDefaultStopTime(_fmu->modelDescription);
+        return _typeInfo->defaultStopTime;
     }
 
     void FmuSdkFmu::getStatesInternal(real_type * states) const
@@ -186,18 +156,101 @@ namespace FMI
             runtime_error("Could not read event indicators from given FMU.");
     }
 
-    FMU* FmuSdkFmu::getFmuHandle(string_type fmuName) const
+    FMU* FmuSdkFmu::getFmuHandle(string_type fmuName, FmuTypeInfoSPtr & typeInfo)
     {
-        auto iter = _knownFmus.find(fmuName);
-        if (iter != _knownFmus.end())
+        std::promise<pair<FMU *, FmuTypeInfoSPtr>> loading;
+        std::shared_future<pair<FMU *, FmuTypeInfoSPtr>> known;
+        {
+            std::lock_guard<std::mutex> lock(_knownFmusMutex);
+            auto iter = _knownFmus.find(fmuName);
+            if (iter != _knownFmus.end())
+            {
+                ++get<1>(iter->second);
+                known = get<0>(iter->second);
+            }
+            else
+                _knownFmus.insert(std::make_pair(fmuName, make_tuple(loading.get_future().share(), size_type(1))));
+        }
+        // another instance loads the FMU, wait for it without holding the lock
+        if (known.valid())
+        {
+            typeInfo = known.get().second;
+            return known.get().first;
+        }
+
+        // extracted outside of the lock, so FMUs of other types are extracted meanwhile
+        FMU *fmu = nullptr;
+        try
         {
-            ++get<1>(iter->second);
-            return get<0>(iter->second);
+            string_type extractedPath = Util::FmuCache::extract(fmuName, _cachePath);
+            ModelDescriptionTable table;
+            if (ModelDescriptionCache::read(extractedPath, table))
+            {
+                fmu = loadExtractedFMUDll(fmuName.c_str(), extractedPath.c_str(), nullptr,
+                                          table.modelIdentifier.c_str());
+            }
+            else
+            {
+                {
+                    // the XML parser of the FMU SDK keeps its state in globals
+                    std::lock_guard<std::mutex> lock(_parserMutex);
+                    fmu = loadExtractedFMU(fmuName.c_str(), extractedPath.c_str());
+                }
+                table = ModelDescriptionCache::fromModelDescription(fmu->modelDescription);
+                ModelDescriptionCache::write(extractedPath, table);
+            }
+            typeInfo = createTypeInfo(table);
+            loading.set_value(std::make_pair(fmu, typeInfo));
+            return fmu;
+        }
+        catch (...)
+        {
+            if (fmu != nullptr)
+                unloadFMU(fmu);
+            // every waiting instance gets the error, so the next attempt starts over
+            {
+                std::lock_guard<std::mutex> lock(_knownFmusMutex);
+                _knownFmus.erase(fmuName);
+            }
+            loading.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    FmuTypeInfoSPtr FmuSdkFmu::createTypeInfo(const ModelDescriptionTable & table)
+    {
+        shared_ptr<FmuTypeInfo> info = make_shared<FmuTypeInfo>();
+        info->modelIdentifier = table.modelIdentifier;
+        info->guid = table.guid;
+        info->defaultStartTime = table.defaultStartTime;
+        info->defaultStopTime = table.defaultStopTime;
+        for (const ModelVariable & variable : table.variables)
+        {
+            switch (variable.type)
+            {
+                case VarType::varReal:
+                    addVariable<real_type>(variable, *info);
+                    break;
+                case VarType::varInt:
+                    addVariable<int_type>(variable, *info);
+                    break;
+                case VarType::varBool:
+                    addVariable<bool_type>(variable, *info);
+                    break;
+                case VarType::varString:
+                    addVariable<string_type>(variable, *info);
+                    break;
+                case VarType::varEnum:
+                    addVariable<int_type>(variable, *info);  // enums are treated as integers
+                    break;
+                default:
+                    throw runtime_error("FmuSdkFmu: VarType unknown.");
+            }
         }
 
-        FMU *fmu = loadFMU(fmuName.c_str());
-        _knownFmus.insert(pair<string_type, tuple<FMU*, size_type>>(fmuName, make_tuple(fmu, 1)));
-        return fmu;
+        info->numberOfStates = table.numberOfStates;
+        info->numberOfEventIndicators = table.numberOfEventIndicators;
+        return info;
     }
 
     void FmuSdkFmu::fillNameVector(vector<string_type> & valueNames, const map<int, string_type> & valueNamesIdx)
@@ -259,27 +312,27 @@ namespace FMI
     }
 
     template<>
-    real_type FmuSdkFmu::getStartValue<real_type>(ScalarVariable * variable, ValueStatus & vs)
+    real_type FmuSdkFmu::getStartValue<real_type>(const ModelVariable & variable)
     {
-        return getRealStartValue(variable, &vs);
+        return variable.realStart;
     }
 
     template<>
-    int_type FmuSdkFmu::getStartValue<int_type>(ScalarVariable * variable, ValueStatus & vs)
+    int_type FmuSdkFmu::getStartValue<int_type>(const ModelVariable & variable)
     {
-        return getIntStartValue(variable, &vs);
+        return variable.intStart;
     }
 
     template<>
-    bool_type FmuSdkFmu::getStartValue<bool_type>(ScalarVariable * variable, ValueStatus & vs)
+    bool_type FmuSdkFmu::getStartValue<bool_type>(const ModelVariable & variable)
     {
-        return getBoolStartValue(variable, &vs);
+        return variable.boolStart;
     }
 
     template<>
-    string_type FmuSdkFmu::getStartValue<string_type>(ScalarVariable * variable, ValueStatus & vs)
+    string_type FmuSdkFmu::getStartValue<string_type>(const ModelVariable & variable)
     {
-        return string_type(getStringStartValue(variable, &vs));
+        return variable.stringStart;
     }
 
     inline AbstractFmu* FmuSdkFmu::duplicate()
@@ -0,0 +1,77 @@
+#include "fmi/FmuStatePool.hpp"
+
+namespace FMI
+{
+
+    FmuStatePool::FmuStatePool()
+            : _snapshots(),
+              _used(),
+              _unused()
+    {
+    }
+
+    size_type FmuStatePool::acquire()
+    {
+        size_type id;
+        if (_unused.empty())
+        {
+            id = _snapshots.size();
+            _snapshots.push_back(FmuSnapshot());
+            _snapshots.back().time = 0.0;
+            _snapshots.back().handle = nullptr;
+            _used.push_back(true);
+        }
+        else
+        {
+            id = _unused.back();
+            _unused.pop_back();
+            _used[id] = true;
+        }
+        return id;
+    }
+
+    void FmuStatePool::release(const size_type & id)
+    {
+        if (!isUsed(id))
+            throw runtime_error("FmuStatePool: Snapshot " + to_string(id) + " isn't used.");
+        _used[id] = false;
+        _unused.push_back(id);
+    }
+
+    FmuSnapshot & FmuStatePool::get(const size_type & id)
+    {
+        if (!isUsed(id))
+            throw runtime_error("FmuStatePool: Snapshot " + to_string(id) + " isn't used.");
+        return _snapshots[id];
+    }
+
+    const FmuSnapshot & FmuStatePool::get(const size_type & id) const
+    {
+        if (!isUsed(id))
+            throw runtime_error("FmuStatePool: Snapshot " + to_string(id) + " isn't used.");
+        return _snapshots[id];
+    }
+
+    bool_type FmuStatePool::isUsed(const size_type & id) const
+    {
+        return id < _used.size() && _used[id];
+    }
+
+    size_type FmuStatePool::size() const
+    {
+        return _snapshots.size();
+    }
+
+    void FmuStatePool::clear(const std::function<void(FmuSnapshot &)> & freeHandle)
+    {
+        for (FmuSnapshot & snapshot : _snapshots)
+        {
+            if (snapshot.handle != nullptr)
+                freeHandle(snapshot);
+        }
+        _snapshots.clear();
+        _used.clear();
+        _unused.clear();
+    }
+
+} /* namespace FMI */
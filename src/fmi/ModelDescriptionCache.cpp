@@ -0,0 +1,362 @@
+#include "fmi/ModelDescriptionCache.hpp"
+#include "util/FmuCache.hpp"
+#include "util/Logger.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace FMI
+{
+    namespace
+    {
+        // increased, if the layout changes
+        const char magic[8] = {'P', 'F', 'M', 'U', 'M', 'D', '0', '3'};
+        // follow the magic, so a machine with another byte order or word size rejects the file, e.g., if the cache
+        // path is on a network file system
+        const std::uint32_t byteOrderMarker = 0x01020304u;
+        const std::uint8_t wordSize = sizeof(void *);
+
+        /**
+         * Appends the fields in native byte order. The file starts with the byte order marker and the word size of the
+         * writer, so other machines sharing the file don't read it.
+         */
+        class Writer
+        {
+         public:
+            template<typename T>
+            void put(const T & value)
+            {
+                const char * bytes = reinterpret_cast<const char *>(&value);
+                _data.insert(_data.end(), bytes, bytes + sizeof(T));
+            }
+
+            void putString(const string_type & value)
+            {
+                put(static_cast<std::uint32_t>(value.size()));
+                _data.insert(_data.end(), value.begin(), value.end());
+            }
+
+            const vector<char> & data() const
+            {
+                return _data;
+            }
+
+         private:
+            vector<char> _data;
+        };
+
+        class Reader
+        {
+         public:
+            Reader(const char * begin, const char * end)
+                    : _pos(begin),
+                      _end(end)
+            {
+            }
+
+            template<typename T>
+            T get()
+            {
+                T res;
+                std::memcpy(&res, take(sizeof(T)), sizeof(T));
+                return res;
+            }
+
+            string_type getString()
+            {
+                std::uint32_t size = get<std::uint32_t>();
+                return string_type(take(size), size);
+            }
+
+            bool atEnd() const
+            {
+                return _pos == _end;
+            }
+
+         private:
+            const char * _pos;
+            const char * _end;
+
+            const char * take(const std::size_t & size)
+            {
+                if (static_cast<std::size_t>(_end - _pos) < size)
+                    throw runtime_error("ModelDescriptionCache: Truncated file.");
+                const char * res = _pos;
+                _pos += size;
+                return res;
+            }
+        };
+
+        /**
+         * Read-only mapping of a whole file, unmapped on destruction.
+         */
+        class MappedFile
+        {
+         public:
+            MappedFile(const string_type & path)
+                    : _data(nullptr),
+                      _size(0)
+            {
+                int fd = open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                    return;
+                struct stat info;
+                if (fstat(fd, &info) == 0 && info.st_size > 0)
+                {
+                    void * data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (data != MAP_FAILED)
+                    {
+                        _data = static_cast<const char *>(data);
+                        _size = info.st_size;
+                    }
+                }
+                // the mapping stays valid without the descriptor
+                close(fd);
+            }
+
+            ~MappedFile()
+            {
+                if (_data != nullptr)
+                    munmap(const_cast<char *>(_data), _size);
+            }
+
+            const char * begin() const
+            {
+                return _data;
+            }
+
+            const char * end() const
+            {
+                return _data + _size;
+            }
+
+            bool isMapped() const
+            {
+                return _data != nullptr;
+            }
+
+         private:
+            MappedFile(const MappedFile &) = delete;
+            MappedFile & operator=(const MappedFile &) = delete;
+
+            const char * _data;
+            std::size_t _size;
+        };
+    }
+
+    const char * const ModelDescriptionCache::fileName = "modelDescription.bin";
+
+    bool ModelDescriptionCache::read(const string_type & extractedPath, ModelDescriptionTable & table)
+    {
+        MappedFile file(extractedPath + fileName);
+        if (!file.isMapped())
+            return false;
+        try
+        {
+            Reader in(file.begin(), file.end());
+            for (const char c : magic)
+                if (in.get<char>() != c)
+                    return false;
+            if (in.get<std::uint32_t>() != byteOrderMarker || in.get<std::uint8_t>() != wordSize)
+            {
+                LOGGER_WRITE(extractedPath + fileName + " has another byte order or word size. Rewriting it.",
+                             Util::LC_LOADER, Util::LL_INFO);
+                return false;
+            }
+            const std::uint64_t size = in.get<std::uint64_t>();
+            const std::int64_t modificationTime = in.get<std::int64_t>();
+            const std::uint64_t hash = in.get<std::uint64_t>();
+            std::uint64_t xmlSize;
+            std::int64_t xmlModificationTime;
+            if (!statXml(extractedPath, xmlSize, xmlModificationTime) || xmlSize != size)
+                return false;
+            // the XML is only hashed, if it was touched since the file was written, e.g., by extracting it again
+            if (xmlModificationTime != modificationTime && hashXml(extractedPath) != hash)
+                return false;
+
+            table.modelIdentifier = in.getString();
+            table.guid = in.getString();
+            table.defaultStartTime = in.get<double>();
+            table.defaultStopTime = in.get<double>();
+            table.numberOfStates = in.get<std::uint32_t>();
+            table.numberOfEventIndicators = in.get<std::uint32_t>();
+            table.variables.resize(in.get<std::uint32_t>());
+            for (ModelVariable & variable : table.variables)
+            {
+                variable.valueReference = in.get<std::uint32_t>();
+                variable.type = static_cast<VarType>(in.get<std::int8_t>());
+                variable.causality = static_cast<VarCausality>(in.get<std::int8_t>());
+                variable.variability = static_cast<Enu>(in.get<std::int8_t>());
+                variable.alias = static_cast<Enu>(in.get<std::int8_t>());
+                variable.startStatus = static_cast<ValueStatus>(in.get<std::int8_t>());
+                switch (variable.type)
+                {
+                    case VarType::varReal:
+                        variable.realStart = in.get<double>();
+                        break;
+                    case VarType::varInt:
+                    case VarType::varEnum:
+                        variable.intStart = in.get<std::int32_t>();
+                        break;
+                    case VarType::varBool:
+                        variable.boolStart = in.get<std::int8_t>();
+                        break;
+                    case VarType::varString:
+                        variable.stringStart = in.getString();
+                        break;
+                    default:
+                        throw runtime_error("ModelDescriptionCache: Unknown variable type.");
+                }
+                variable.name = in.getString();
+            }
+            if (!in.atEnd())
+                throw runtime_error("ModelDescriptionCache: Trailing data.");
+        }
+        catch (const std::exception & ex)
+        {
+            LOGGER_WRITE(string_type(ex.what()) + " Parsing " + extractedPath + "modelDescription.xml instead.",
+                         Util::LC_LOADER, Util::LL_WARNING);
+            return false;
+        }
+        return true;
+    }
+
+    void ModelDescriptionCache::write(const string_type & extractedPath, const ModelDescriptionTable & table)
+    {
+        namespace fs = boost::filesystem;
+        Writer out;
+        for (const char c : magic)
+            out.put(c);
+        out.put(byteOrderMarker);
+        out.put(wordSize);
+        std::uint64_t size;
+        std::int64_t modificationTime;
+        if (!statXml(extractedPath, size, modificationTime))
+            throw runtime_error("ModelDescriptionCache: Couldn't read " + extractedPath + "modelDescription.xml");
+        out.put(size);
+        out.put(modificationTime);
+        out.put(hashXml(extractedPath));
+
+        out.putString(table.modelIdentifier);
+        out.putString(table.guid);
+        out.put(static_cast<double>(table.defaultStartTime));
+        out.put(static_cast<double>(table.defaultStopTime));
+        out.put(static_cast<std::uint32_t>(table.numberOfStates));
+        out.put(static_cast<std::uint32_t>(table.numberOfEventIndicators));
+        out.put(static_cast<std::uint32_t>(table.variables.size()));
+        for (const ModelVariable & variable : table.variables)
+        {
+            out.put(static_cast<std::uint32_t>(variable.valueReference));
+            out.put(static_cast<std::int8_t>(variable.type));
+            out.put(static_cast<std::int8_t>(variable.causality));
+            out.put(static_cast<std::int8_t>(variable.variability));
+            out.put(static_cast<std::int8_t>(variable.alias));
+            out.put(static_cast<std::int8_t>(variable.startStatus));
+            switch (variable.type)
+            {
+                case VarType::varReal:
+                    out.put(static_cast<double>(variable.realStart));
+                    break;
+                case VarType::varInt:
+                case VarType::varEnum:
+                    out.put(static_cast<std::int32_t>(variable.intStart));
+                    break;
+                case VarType::varBool:
+                    out.put(static_cast<std::int8_t>(variable.boolStart));
+                    break;
+                case VarType::varString:
+                    out.putString(variable.stringStart);
+                    break;
+                default:
+                    throw runtime_error("ModelDescriptionCache: Unknown variable type.");
+            }
+            out.putString(variable.name);
+        }
+
+        // written to a temporary file first, so no process maps a partially written file
+        fs::path target = fs::path(extractedPath) / fileName;
+        fs::path tmp = target;
+        tmp += ".tmp-" + fs::unique_path().string();
+        std::ofstream file(tmp.string(), std::ios::binary);
+        file.write(out.data().data(), out.data().size());
+        file.close();
+        boost::system::error_code ec;
+        if (file)
+            fs::rename(tmp, target, ec);
+        if (!file || ec)
+        {
+            fs::remove(tmp, ec);
+            LOGGER_WRITE("Couldn't write " + target.string(), Util::LC_LOADER, Util::LL_WARNING);
+        }
+    }
+
+    ModelDescriptionTable ModelDescriptionCache::fromModelDescription(ModelDescription * modelDescription)
+    {
+        ModelDescriptionTable table;
+        table.modelIdentifier = getModelIdentifier(modelDescription);
+        table.guid = getString(modelDescription, att_guid);
+        table.defaultStartTime = getDefaultStartTime(modelDescription);
+        table.defaultStopTime = getDefaultStopTime(modelDescription);
+        table.numberOfStates = getNumberOfStates(modelDescription);
+        table.numberOfEventIndicators = getNumberOfEventIndicators(modelDescription);
+        for (size_type i = 0; modelDescription->modelVariables[i] != nullptr; i++)
+        {
+            ScalarVariable * scalarVariable = modelDescription->modelVariables[i];
+            ModelVariable variable = ModelVariable();
+            variable.name = getName(scalarVariable);
+            variable.valueReference = getValueReference(scalarVariable);
+            variable.type = getVariableType(scalarVariable);
+            variable.causality = getVariableCausality(scalarVariable);
+            variable.variability = getVariability(scalarVariable);
+            variable.alias = getAlias(scalarVariable);
+            switch (variable.type)
+            {
+                case VarType::varReal:
+                    variable.realStart = getRealStartValue(scalarVariable, &variable.startStatus);
+                    break;
+                case VarType::varInt:
+                case VarType::varEnum:
+                    variable.intStart = getIntStartValue(scalarVariable, &variable.startStatus);
+                    break;
+                case VarType::varBool:
+                    variable.boolStart = getBoolStartValue(scalarVariable, &variable.startStatus);
+                    break;
+                case VarType::varString:
+                {
+                    const char * start = getStringStartValue(scalarVariable, &variable.startStatus);
+                    if (start != nullptr)
+                        variable.stringStart = start;
+                    break;
+                }
+                default:
+                    throw runtime_error("ModelDescriptionCache: VarType unknown.");
+            }
+            table.variables.push_back(variable);
+        }
+        return table;
+    }
+
+    bool ModelDescriptionCache::statXml(const string_type & extractedPath, std::uint64_t & size,
+                                        std::int64_t & modificationTime)
+    {
+        struct stat info;
+        if (stat((extractedPath + "modelDescription.xml").c_str(), &info) != 0)
+            return false;
+        size = info.st_size;
+        modificationTime = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+        return true;
+    }
+
+    std::uint64_t ModelDescriptionCache::hashXml(const string_type & extractedPath)
+    {
+        std::ifstream file(extractedPath + "modelDescription.xml", std::ios::binary);
+        if (!file)
+            throw runtime_error("ModelDescriptionCache: Couldn't read " + extractedPath + "modelDescription.xml");
+        vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return Util::FmuCache::hash(data);
+    }
+
+} /* namespace FMI */
@@ -0,0 +1,154 @@
+#include "fmi/NativeFmu.hpp"
+
+namespace FMI
+{
+
+    map<string_type, weak_ptr<const FmuTypeInfo>> NativeFmu::_typeInfos;
+    std::mutex NativeFmu::_typeInfosMutex;
+
+    NativeFmu::NativeFmu(const Initialization::FmuPlan & in)
+            : AbstractFmu(in),
+              _model()
+    {
+    }
+
+    NativeFmu::~NativeFmu()
+    {
+    }
+
+    void NativeFmu::load(const bool & alsoInit)
+    {
+        LOGGER_WRITE("Create native model " + _path, Util::LC_LOADER, Util::LL_DEBUG);
+        _model = shared_ptr<NativeModel>(NativeModel::create(_path));
+        _model->setTime(_time);
+        setTypeInfo(shareTypeInfo(_path, *_model));
+
+        AbstractFmu::load(alsoInit);
+        if (alsoInit)
+            initialize();
+    }
+
+    void NativeFmu::unload()
+    {
+        AbstractFmu::unload();
+        _model.reset();
+    }
+
+    void NativeFmu::initialize()
+    {
+        _model->computeOutputs();
+    }
+
+    AbstractFmu * NativeFmu::duplicate()
+    {
+        throw runtime_error("NativeFmu: Duplication not available.");
+    }
+
+    void NativeFmu::stepCompleted()
+    {
+    }
+
+    FmuEventInfo NativeFmu::eventUpdate()
+    {
+        bool_type statesChanged = _model->eventUpdate();
+        _model->computeOutputs();
+        _eventInfo = FmuEventInfo(true, false, statesChanged);
+        return _eventInfo;
+    }
+
+    void NativeFmu::setTime(const double & time)
+    {
+        AbstractFmu::setTime(time);
+        _model->setTime(time);
+    }
+
+    double NativeFmu::getDefaultStart() const
+    {
+        return _typeInfo->defaultStartTime;
+    }
+
+    double NativeFmu::getDefaultStop() const
+    {
+        return _typeInfo->defaultStopTime;
+    }
+
+    void NativeFmu::getStatesInternal(real_type * states) const
+    {
+        std::copy(_model->getReals().begin(), _model->getReals().begin() + getNumStates(), states);
+    }
+
+    void NativeFmu::setStatesInternal(const real_type * states)
+    {
+        std::copy(states, states + getNumStates(), _model->getReals().begin());
+    }
+
+    void NativeFmu::getStateDerivativesInternal(real_type * stateDerivatives)
+    {
+        _model->getDerivatives(stateDerivatives);
+    }
+
+    void NativeFmu::getEventIndicatorsInternal(real_type * eventIndicators)
+    {
+        _model->getEventIndicators(eventIndicators);
+    }
+
+    void NativeFmu::getValuesInternal(vector<real_type> & out, const vector<size_type> & references) const
+    {
+        // the outputs depend on states and inputs set since the last read
+        _model->computeOutputs();
+        readValues(out, references, _model->getReals());
+    }
+
+    void NativeFmu::getValuesInternal(vector<int_type> & out, const vector<size_type> & references) const
+    {
+        readValues(out, references, _model->getInts());
+    }
+
+    void NativeFmu::getValuesInternal(vector<bool_type> & out, const vector<size_type> & references) const
+    {
+        readValues(out, references, _model->getBools());
+    }
+
+    void NativeFmu::getValuesInternal(vector<string_type> & out, const vector<size_type> & references) const
+    {
+        _model->computeOutputs();
+        readValues(out, references, _model->getStrings());
+    }
+
+    void NativeFmu::setValuesInternal(const vector<real_type> & in, const vector<size_type> & references)
+    {
+        writeValues(in, references, _model->getReals());
+    }
+
+    void NativeFmu::setValuesInternal(const vector<int_type> & in, const vector<size_type> & references)
+    {
+        writeValues(in, references, _model->getInts());
+    }
+
+    void NativeFmu::setValuesInternal(const vector<bool_type> & in, const vector<size_type> & references)
+    {
+        writeValues(in, references, _model->getBools());
+    }
+
+    void NativeFmu::setValuesInternal(const vector<string_type> & in, const vector<size_type> & references)
+    {
+        writeValues(in, references, _model->getStrings());
+    }
+
+    FmuTypeInfoSPtr NativeFmu::shareTypeInfo(const string_type & path, const NativeModel & model)
+    {
+        std::lock_guard<std::mutex> lock(_typeInfosMutex);
+        weak_ptr<const FmuTypeInfo> & known = _typeInfos[path];
+        FmuTypeInfoSPtr res = known.lock();
+        if (!res)
+        {
+            shared_ptr<FmuTypeInfo> info = make_shared<FmuTypeInfo>();
+            info->guid = path;
+            model.describe(*info);
+            res = info;
+            known = res;
+        }
+        return res;
+    }
+
+} /* namespace FMI */
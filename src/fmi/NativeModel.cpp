@@ -0,0 +1,216 @@
+#include "fmi/NativeModel.hpp"
+
+namespace FMI
+{
+    namespace
+    {
+        /**
+         * Synthetic benchmark model with the parameters "states" (default 1), "stiffness" (ratio of the fastest to
+         * the slowest time constant, default 1), "eventPeriod" (0: no events), "inputs" (default 0) and "outputs"
+         * (default 1). Every state relaxes towards a level plus one of the inputs:
+         *   der(x[i]) = -k[i] * (x[i] - level - u[(i-1) mod inputs + 1]), k[i] = stiffness^((i-1)/(states-1))
+         * The outputs are y[j] = x[(j-1) mod states + 1]. The level flips its sign, whenever the event indicator
+         * cos(pi * time / eventPeriod) crosses zero, i.e. every eventPeriod starting at eventPeriod / 2. Without
+         * eventPeriod, the level stays 1, even if the events of connected FMUs are handled.
+         */
+        class SyntheticModel : public NativeModel
+        {
+         public:
+            SyntheticModel(const map<string_type, real_type> & parameters)
+                    : NativeModel(getCount(parameters, "states", 1), (get(parameters, "eventPeriod", 0.0) > 0.0) ? 1 : 0),
+                      _numInputs(getCount(parameters, "inputs", 0)),
+                      _numOutputs(getCount(parameters, "outputs", 1)),
+                      _eventPeriod(get(parameters, "eventPeriod", 0.0)),
+                      _rates(_numStates, 1.0)
+            {
+                if (_numStates == 0)
+                    throw runtime_error("NativeModel: The model synthetic needs at least one state.");
+                real_type stiffness = get(parameters, "stiffness", 1.0);
+                if (stiffness < 1.0)
+                    throw runtime_error("NativeModel: The stiffness of the model synthetic can't be less than 1.");
+                for (size_type i = 1; i < _numStates; ++i)
+                    _rates[i] = std::pow(stiffness, static_cast<real_type>(i) / (_numStates - 1));
+
+                // x, u, y, level
+                _reals.resize(_numStates + _numInputs + _numOutputs + 1, 0.0);
+                std::fill(_reals.begin(), _reals.begin() + _numStates, 1.0);
+                _reals.back() = 1.0;
+                // number of events
+                _ints.resize(1, 0);
+                // level > 0
+                _bools.resize(1, 1);
+                computeOutputs();
+            }
+
+            void describe(FmuTypeInfo & info) const override
+            {
+                info.modelIdentifier = "synthetic";
+                info.defaultStartTime = 0.0;
+                info.defaultStopTime = 1.0;
+                info.numberOfStates = _numStates;
+                info.numberOfEventIndicators = _numEventIndicators;
+                for (size_type i = 0; i < _numStates; ++i)
+                    addVariable<real_type>(info, "x[" + to_string(i + 1) + "]", i, _reals[i], true);
+                for (size_type i = 0; i < _numInputs; ++i)
+                    addVariable<real_type>(info, "u[" + to_string(i + 1) + "]", inputIndex(i), 0.0, true,
+                                           VarCausality::varCausalityInput);
+                for (size_type i = 0; i < _numOutputs; ++i)
+                    addVariable<real_type>(info, "y[" + to_string(i + 1) + "]", outputIndex(i),
+                                           _reals[outputIndex(i)], true, VarCausality::varCausalityOutput);
+                addVariable<real_type>(info, "level", _reals.size() - 1, _reals.back(), false);
+                addVariable<int_type>(info, "events", 0, _ints[0], false);
+                addVariable<bool_type>(info, "high", 0, _bools[0], false);
+            }
+
+            void getDerivatives(real_type * derivatives) const override
+            {
+                const real_type level = _reals.back();
+                for (size_type i = 0; i < _numStates; ++i)
+                {
+                    real_type target = (_numInputs > 0) ? level + _reals[inputIndex(i % _numInputs)] : level;
+                    derivatives[i] = -_rates[i] * (_reals[i] - target);
+                }
+            }
+
+            void getEventIndicators(real_type * eventIndicators) const override
+            {
+                if (_numEventIndicators > 0)
+                    eventIndicators[0] = std::cos(M_PI * _time / _eventPeriod);
+            }
+
+            bool_type eventUpdate() override
+            {
+                if (_numEventIndicators == 0)
+                    return false;
+                _reals.back() = -_reals.back();
+                ++_ints[0];
+                _bools[0] = _reals.back() > 0.0;
+                return false;
+            }
+
+            void computeOutputs() override
+            {
+                for (size_type i = 0; i < _numOutputs; ++i)
+                    _reals[outputIndex(i)] = _reals[i % _numStates];
+            }
+
+         private:
+            size_type _numInputs;
+            size_type _numOutputs;
+            real_type _eventPeriod;
+            vector<real_type> _rates;
+
+            size_type inputIndex(const size_type & i) const
+            {
+                return _numStates + i;
+            }
+
+            size_type outputIndex(const size_type & i) const
+            {
+                return _numStates + _numInputs + i;
+            }
+
+            static real_type get(const map<string_type, real_type> & parameters, const string_type & name,
+                                 const real_type & defaultValue)
+            {
+                auto iter = parameters.find(name);
+                return (iter != parameters.end()) ? iter->second : defaultValue;
+            }
+
+            static size_type getCount(const map<string_type, real_type> & parameters, const string_type & name,
+                                      const real_type & defaultValue)
+            {
+                real_type res = get(parameters, name, defaultValue);
+                if (res < 0.0 || res != std::floor(res))
+                    throw runtime_error("NativeModel: The parameter " + name + " needs to be a count.");
+                return static_cast<size_type>(res);
+            }
+        };
+    }
+
+    NativeModel::NativeModel(const size_type & numStates, const size_type & numEventIndicators)
+            : _time(0.0),
+              _numStates(numStates),
+              _numEventIndicators(numEventIndicators)
+    {
+    }
+
+    real_type NativeModel::getTime() const
+    {
+        return _time;
+    }
+
+    void NativeModel::setTime(const real_type & time)
+    {
+        _time = time;
+    }
+
+    size_type NativeModel::getNumStates() const
+    {
+        return _numStates;
+    }
+
+    size_type NativeModel::getNumEventIndicators() const
+    {
+        return _numEventIndicators;
+    }
+
+    vector<real_type> & NativeModel::getReals()
+    {
+        return _reals;
+    }
+
+    vector<int_type> & NativeModel::getInts()
+    {
+        return _ints;
+    }
+
+    vector<bool_type> & NativeModel::getBools()
+    {
+        return _bools;
+    }
+
+    vector<string_type> & NativeModel::getStrings()
+    {
+        return _strings;
+    }
+
+    void NativeModel::registerModel(const string_type & name, const Factory & factory)
+    {
+        getFactories()[name] = factory;
+    }
+
+    NativeModel * NativeModel::create(const string_type & path)
+    {
+        size_t pos = path.find('?');
+        string_type name = path.substr(0, pos);
+        map<string_type, real_type> parameters;
+        while (pos != string_type::npos)
+        {
+            size_t next = path.find('&', pos + 1);
+            string_type parameter = path.substr(pos + 1, (next == string_type::npos) ? next : next - pos - 1);
+            size_t assign = parameter.find('=');
+            char * end = nullptr;
+            real_type value = (assign == string_type::npos) ? 0.0 : std::strtod(parameter.c_str() + assign + 1, &end);
+            if (end == nullptr || end == parameter.c_str() + assign + 1 || *end != '\0')
+                throw runtime_error("NativeModel: Invalid parameter \"" + parameter + "\" in " + path);
+            parameters[parameter.substr(0, assign)] = value;
+            pos = next;
+        }
+
+        const map<string_type, Factory> & factories = getFactories();
+        auto iter = factories.find(name);
+        if (iter == factories.end())
+            throw runtime_error("NativeModel: Unknown model " + name);
+        return iter->second(parameters);
+    }
+
+    map<string_type, NativeModel::Factory> & NativeModel::getFactories()
+    {
+        static map<string_type, Factory> factories = {
+            { "synthetic", [](const map<string_type, real_type> & parameters)
+            {   return new SyntheticModel(parameters);} } };
+        return factories;
+    }
+
+} /* namespace FMI */
@@ -7,7 +7,8 @@ namespace FMI
             : ValueSwitch(),
               _valueReferenceToNamesMapping(4, std::map<size_type, vector<string_type>>()),
               _valueInputReferenceToNamesMapping(4, std::map<size_type, string_type>()),
-              _valueReferenceToDescriptionMapping(4, std::map<size_type, vector<string_type>>())
+              _valueReferenceToDescriptionMapping(4, std::map<size_type, vector<string_type>>()),
+              _nameToValueReferenceMapping(4, unordered_map<string_type, size_type>())
     {
     }
 
@@ -15,7 +16,8 @@ namespace FMI
         : ValueSwitch(),
           _valueReferenceToNamesMapping(obj._valueReferenceToNamesMapping),
           _valueInputReferenceToNamesMapping(obj._valueInputReferenceToNamesMapping),
-          _valueReferenceToDescriptionMapping(obj._valueReferenceToDescriptionMapping)
+          _valueReferenceToDescriptionMapping(obj._valueReferenceToDescriptionMapping),
+          _nameToValueReferenceMapping(obj._nameToValueReferenceMapping)
     {
     }
 
@@ -0,0 +1,55 @@
+#include "fmi/ValueSubset.hpp"
+
+namespace FMI
+{
+
+    ValueSubset::ValueSubset(const ValueReferenceCollection & allReferences)
+            : _allReferences(allReferences),
+              _references(),
+              _indices(4, vector<size_type>())
+    {
+    }
+
+    ValueSubset::ValueSubset(const ValueSubset & in)
+            : ValueSwitch(),
+              _allReferences(in._allReferences),
+              _references(in._references),
+              _indices(in._indices)
+    {
+    }
+
+    ValueSubset & ValueSubset::operator=(const ValueSubset & in)
+    {
+        _allReferences = in._allReferences;
+        _references = in._references;
+        _indices = in._indices;
+        return *this;
+    }
+
+    void ValueSubset::addOutputs(const InputMapping & mapping)
+    {
+        addMapping<real_type>(mapping, true);
+        addMapping<int_type>(mapping, true);
+        addMapping<bool_type>(mapping, true);
+        addMapping<string_type>(mapping, true);
+    }
+
+    void ValueSubset::addInputs(const InputMapping & mapping)
+    {
+        addMapping<real_type>(mapping, false);
+        addMapping<int_type>(mapping, false);
+        addMapping<bool_type>(mapping, false);
+        addMapping<string_type>(mapping, false);
+    }
+
+    const ValueReferenceCollection & ValueSubset::getReferences() const
+    {
+        return _references;
+    }
+
+    size_type ValueSubset::size() const
+    {
+        return _references.size();
+    }
+
+} /* namespace FMI */
@@ -60,6 +60,7 @@ namespace Initialization
         res.intermediateResults = true;
         res.loader = "fmuSdk";
         res.logEnabled = false;
+        res.coSimulation = false;
         res.name = getUndefinedValue<decltype(res.name)>();
         res.path = getUndefinedValue<decltype(res.path)>();
         res.relTol = 1.0e-6;
@@ -67,6 +68,7 @@ namespace Initialization
         res.tolControlled = true;
         res.version = "1.0";
         res.workingPath = "./";
+        res.cachePath = "";
 
         //static_assert( sizeof(res.id) + sizeof(res.intermediateResults) + sizeof(res.loader) + sizeof(res.logEnabled) + sizeof(res) + sizeof(res.name) + sizeof(res.path) + sizeof(res.relTol)    + sizeof(res.solverId) + + sizeof(res.tolControlled) + sizeof(res.version) + + sizeof(res.workingPath)  == sizeof(res), "DefaultValues: Byte count mismatch. Maybe you haven't added a default value for FmuPlan in class DefaultValues.");
         return res;
@@ -101,12 +103,19 @@ namespace Initialization
     {
         Initialization::ConnectionPlan res;
         res.bufferSize = 100;
+        res.batchSize = 1;
+        res.maxBatchBytes = 65536;
+        res.remoteKind = "mpi";
+        res.sharedMemory = true;
+        res.encoding = "full";
+        res.shmOffset = 0;
         res.destFmu = getUndefinedValue<decltype(res.destFmu)>();
         res.destRank = 0;
         res.inputMapping = getUndefinedValue<decltype(res.inputMapping)>();
         res.kind = "serial";
         res.sourceFmu = getUndefinedValue<decltype(res.sourceFmu)>();
         res.sourceRank = 0;
+        res.id = getUndefinedValue<decltype(res.id)>();
         res.startTag = getUndefinedValue<decltype(res.startTag)>();
         //static_assert(sizeof(res.bufferSize) + sizeof(res.destFmu) + sizeof(res.destRank) + sizeof(res.inputMapping) + sizeof(res.kind) + sizeof(res.sourceFmu) + sizeof(res.sourceRank) + sizeof(res.startTag) == sizeof(res),"DefaultValues: Byte count mismatch. Maybe you haven't added a default value for ConnectionPlan in class DefaultValues.");
         return res;
@@ -123,6 +132,7 @@ namespace Initialization
     Initialization::ProgramPlan DefaultValues::programPlan()
     {
         Initialization::ProgramPlan res;
+        res.useProcesses = false;
         //static_assert(sizeof(res.simPlans)  == sizeof(res),"DefaultValues: Byte count mismatch. Maybe you haven't added a default value for ProgramPlan in class DefaultValues.");
         return res;
     }
@@ -141,6 +151,14 @@ namespace Initialization
         res.defaultMaxError = solverPlan().maxError;
         res.defaultStepSize = 1.0e-3;
         res.defaultTolerance = fmuPlan().relTol;
+        res.cpuId = -1;
+        res.implicitCpu = false;
+        res.idleSpins = 1000;
+        res.maxIdleParkTime = 1.0e-3;
+        res.maxSolveQuantum = 1000;
+        res.coupling = "free";
+        res.macroStepSize = 1.0e-2;
+        res.globalTimeInterval = 100;
         res.kind = "serial";
         res.startTime = solverPlan().startTime;
         res.endTime = solverPlan().endTime;
@@ -17,11 +17,19 @@ namespace Initialization
         {
             res = new FMI::FmuSdkFmu(plan);
         }
+        else if (plan.loader == "native")
+        {
+            res = new FMI::NativeFmu(plan);
+        }
 #ifdef USE_FMILIB
         else if (plan.loader == "fmiLib")
         {
             res = new FMI::FmiLibFmu(plan);
         }
+        else if (plan.loader == "fmi2")
+        {
+            res = new FMI::Fmi2LibFmu(plan);
+        }
 #endif
 #ifdef USE_NETWORK_OFFLOADER
         else if (plan.loader == "network")
@@ -43,6 +51,10 @@ namespace Initialization
         {
             res = Synchronization::ConnectionSPtr(new Synchronization::SerialConnection(in));
         }
+        else if (in.kind == "shm")
+        {
+            res = Synchronization::ConnectionSPtr(new Synchronization::SHMConnection(in));
+        }
 #ifdef USE_OPENMP
         else if (in.kind == "openmp")
         {
@@ -54,6 +66,14 @@ namespace Initialization
         {
             res = Synchronization::ConnectionSPtr(new Synchronization::MPIConnection(in));
         }
+        else if (in.kind == "mpirma")
+        {
+            res = Synchronization::ConnectionSPtr(new Synchronization::MPIRMAConnection(in));
+        }
+        else if (in.kind == "mpishm")
+        {
+            res = Synchronization::ConnectionSPtr(new Synchronization::MPISHMConnection(in));
+        }
 #endif
         else
         {
@@ -68,6 +88,10 @@ namespace Initialization
         {
             return createSimulationWithKnownType<Simulation::SerialSimulation>(in);
         }
+        else if (in.kind == "task")
+        {
+            return createSimulationWithKnownType<Simulation::TaskSimulation>(in);
+        }
         //else if(in.kind == "openmp")
         //    return createSimulationWithKnownType<Simulation::OpenMPSimulation>(in);
         else
@@ -0,0 +1,455 @@
+/*
+ * PlanSerializer.cpp
+ */
+
+#include "initialization/PlanSerializer.hpp"
+#include "synchronization/Communicator.hpp"
+#include "synchronization/GlobalVirtualTime.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+namespace Initialization
+{
+
+    namespace
+    {
+        /**
+         * Appends values in native byte order. All MPI processes run the same binary, so no conversion is needed.
+         */
+        class BufferWriter
+        {
+         public:
+            vector<char> buffer;
+
+            template<typename T>
+            void write(const T & value)
+            {
+                static_assert(std::is_arithmetic<T>::value, "BufferWriter: Only arithmetic values can be packed.");
+                const char * begin = reinterpret_cast<const char *>(&value);
+                buffer.insert(buffer.end(), begin, begin + sizeof(T));
+            }
+
+            void write(const bool & value)
+            {
+                write(static_cast<bool_type>(value));
+            }
+
+            void write(const string_type & value)
+            {
+                write(static_cast<size_type>(value.size()));
+                buffer.insert(buffer.end(), value.begin(), value.end());
+            }
+
+            void write(const FMI::InputMapping & mapping)
+            {
+                write(mapping.getValues<real_type>());
+                write(mapping.getValues<int_type>());
+                write(mapping.getValues<bool_type>());
+                write(mapping.getValues<string_type>());
+            }
+
+            void write(const vector<tuple<size_type, size_type>> & values)
+            {
+                write(static_cast<size_type>(values.size()));
+                for (const auto & value : values)
+                {
+                    write(get<0>(value));
+                    write(get<1>(value));
+                }
+            }
+
+            void write(const vector<real_type> & values)
+            {
+                write(static_cast<size_type>(values.size()));
+                for (const real_type & value : values)
+                    write(value);
+            }
+
+            template<typename Container>
+            void writeIds(const Container & connections)
+            {
+                write(static_cast<size_type>(connections.size()));
+                for (const auto & con : connections)
+                    write(con->id);
+            }
+        };
+
+        class BufferReader
+        {
+         public:
+            BufferReader(const vector<char> & buffer)
+                    : _buffer(buffer),
+                      _pos(0)
+            {
+            }
+
+            template<typename T>
+            void read(T & value)
+            {
+                static_assert(std::is_arithmetic<T>::value, "BufferReader: Only arithmetic values can be unpacked.");
+                std::memcpy(&value, take(sizeof(T)), sizeof(T));
+            }
+
+            void read(bool & value)
+            {
+                bool_type tmp;
+                read(tmp);
+                value = tmp != 0;
+            }
+
+            void read(string_type & value)
+            {
+                size_type size;
+                read(size);
+                const char * begin = take(size);
+                value.assign(begin, begin + size);
+            }
+
+            void read(FMI::InputMapping & mapping)
+            {
+                vector<tuple<size_type, size_type>> reals, ints, bools, strings;
+                read(reals);
+                read(ints);
+                read(bools);
+                read(strings);
+                mapping = FMI::InputMapping(reals, ints, bools, strings);
+            }
+
+            void read(vector<tuple<size_type, size_type>> & values)
+            {
+                size_type size;
+                read(size);
+                values.resize(size);
+                for (auto & value : values)
+                {
+                    read(get<0>(value));
+                    read(get<1>(value));
+                }
+            }
+
+            void read(vector<real_type> & values)
+            {
+                size_type size;
+                read(size);
+                values.resize(size);
+                for (real_type & value : values)
+                    read(value);
+            }
+
+            template<typename Container>
+            void readIds(Container & connections, const map<size_type, shared_ptr<ConnectionPlan>> & knownConnections)
+            {
+                size_type size, id;
+                read(size);
+                for (size_type i = 0; i < size; ++i)
+                {
+                    read(id);
+                    auto it = knownConnections.find(id);
+                    if (it == knownConnections.end())
+                        throw runtime_error("PlanSerializer: Unknown connection " + to_string(id));
+                    connections.push_back(it->second);
+                }
+            }
+
+            bool_type isEnd() const
+            {
+                return _pos == _buffer.size();
+            }
+
+         private:
+            const vector<char> & _buffer;
+            size_t _pos;
+
+            const char * take(const size_t & size)
+            {
+                if (_buffer.size() - _pos < size)
+                    throw runtime_error("PlanSerializer: Buffer is truncated.");
+                const char * res = _buffer.data() + _pos;
+                _pos += size;
+                return res;
+            }
+        };
+
+        void writeConnection(BufferWriter & out, const ConnectionPlan & con)
+        {
+            out.write(con.kind);
+            out.write(con.bufferSize);
+            out.write(con.batchSize);
+            out.write(con.maxBatchBytes);
+            out.write(con.remoteKind);
+            out.write(con.sharedMemory);
+            out.write(con.encoding);
+            out.write(con.deadbands);
+            out.write(con.shmOffset);
+            out.write(con.sourceRank);
+            out.write(con.destRank);
+            out.write(con.sourceFmu);
+            out.write(con.destFmu);
+            out.write(con.id);
+            out.write(con.startTag);
+            out.write(con.inputMapping);
+        }
+
+        void readConnection(BufferReader & in, ConnectionPlan & con)
+        {
+            in.read(con.kind);
+            in.read(con.bufferSize);
+            in.read(con.batchSize);
+            in.read(con.maxBatchBytes);
+            in.read(con.remoteKind);
+            in.read(con.sharedMemory);
+            in.read(con.encoding);
+            in.read(con.deadbands);
+            in.read(con.shmOffset);
+            in.read(con.sourceRank);
+            in.read(con.destRank);
+            in.read(con.sourceFmu);
+            in.read(con.destFmu);
+            in.read(con.id);
+            in.read(con.startTag);
+            in.read(con.inputMapping);
+        }
+
+        void writeSolver(BufferWriter & out, const SolverPlan & solver)
+        {
+            out.write(solver.kind);
+            out.write(solver.id);
+            const FmuPlan & fmu = *solver.fmu;
+            out.write(fmu.name);
+            out.write(fmu.path);
+            out.write(fmu.workingPath);
+            out.write(fmu.cachePath);
+            out.write(fmu.version);
+            out.write(fmu.id);
+            out.write(fmu.loader);
+            out.write(fmu.intermediateResults);
+            out.write(fmu.tolControlled);
+            out.write(fmu.relTol);
+            out.write(fmu.logEnabled);
+            out.write(fmu.coSimulation);
+            out.write(fmu.solverId);
+            out.write(solver.startTime);
+            out.write(solver.endTime);
+            out.write(solver.stepSize);
+            out.write(solver.maxError);
+            out.write(solver.eventInterval);
+            out.writeIds(solver.outConnections);
+            out.writeIds(solver.inConnections);
+        }
+
+        void readSolver(BufferReader & in, SolverPlan & solver,
+                        const map<size_type, shared_ptr<ConnectionPlan>> & knownConnections)
+        {
+            in.read(solver.kind);
+            in.read(solver.id);
+            solver.fmu = make_shared<FmuPlan>();
+            FmuPlan & fmu = *solver.fmu;
+            in.read(fmu.name);
+            in.read(fmu.path);
+            in.read(fmu.workingPath);
+            in.read(fmu.cachePath);
+            in.read(fmu.version);
+            in.read(fmu.id);
+            in.read(fmu.loader);
+            in.read(fmu.intermediateResults);
+            in.read(fmu.tolControlled);
+            in.read(fmu.relTol);
+            in.read(fmu.logEnabled);
+            in.read(fmu.coSimulation);
+            in.read(fmu.solverId);
+            in.read(solver.startTime);
+            in.read(solver.endTime);
+            in.read(solver.stepSize);
+            in.read(solver.maxError);
+            in.read(solver.eventInterval);
+            in.readIds(solver.outConnections, knownConnections);
+            in.readIds(solver.inConnections, knownConnections);
+        }
+
+        void writeSimulation(BufferWriter & out, const SimulationPlan & sim)
+        {
+            out.write(sim.kind);
+            out.write(sim.startTime);
+            out.write(sim.endTime);
+            out.write(sim.defaultStepSize);
+            out.write(sim.defaultEventInterval);
+            out.write(sim.defaultMaxError);
+            out.write(sim.defaultTolerance);
+            out.write(sim.cpuId);
+            out.write(sim.implicitCpu);
+            out.write(sim.idleSpins);
+            out.write(sim.maxIdleParkTime);
+            out.write(sim.maxSolveQuantum);
+            out.write(sim.coupling);
+            out.write(sim.macroStepSize);
+            out.write(sim.globalTimeInterval);
+
+            const DataManagerPlan & dm = sim.dataManager;
+            out.write(dm.writer.kind);
+            out.write(dm.writer.startTime);
+            out.write(dm.writer.endTime);
+            out.write(dm.writer.numSteps);
+            out.write(dm.writer.filePath);
+            out.write(dm.history.kind);
+            out.write(static_cast<size_type>(dm.solvers.size()));
+            for (const auto & solver : dm.solvers)
+                writeSolver(out, *solver);
+            out.writeIds(dm.outConnections);
+            out.writeIds(dm.inConnections);
+        }
+
+        void readSimulation(BufferReader & in, SimulationPlan & sim,
+                            const map<size_type, shared_ptr<ConnectionPlan>> & knownConnections)
+        {
+            in.read(sim.kind);
+            in.read(sim.startTime);
+            in.read(sim.endTime);
+            in.read(sim.defaultStepSize);
+            in.read(sim.defaultEventInterval);
+            in.read(sim.defaultMaxError);
+            in.read(sim.defaultTolerance);
+            in.read(sim.cpuId);
+            in.read(sim.implicitCpu);
+            in.read(sim.idleSpins);
+            in.read(sim.maxIdleParkTime);
+            in.read(sim.maxSolveQuantum);
+            in.read(sim.coupling);
+            in.read(sim.macroStepSize);
+            in.read(sim.globalTimeInterval);
+
+            DataManagerPlan & dm = sim.dataManager;
+            in.read(dm.writer.kind);
+            in.read(dm.writer.startTime);
+            in.read(dm.writer.endTime);
+            in.read(dm.writer.numSteps);
+            in.read(dm.writer.filePath);
+            in.read(dm.history.kind);
+            size_type numSolvers;
+            in.read(numSolvers);
+            dm.solvers.resize(numSolvers);
+            for (auto & solver : dm.solvers)
+            {
+                solver = make_shared<SolverPlan>();
+                readSolver(in, *solver, knownConnections);
+            }
+            in.readIds(dm.outConnections, knownConnections);
+            in.readIds(dm.inConnections, knownConnections);
+        }
+
+#ifdef USE_NETWORK_OFFLOADER
+        void writeNetworkFmu(BufferWriter & out, const Network::NetworkFmuInformation & fmu)
+        {
+            out.write(fmu.mpiPos);
+            out.write(fmu.corePos);
+            out.write(fmu.solverPos);
+            out.write(fmu.inputMap);
+            out.write(fmu.outputMap);
+        }
+
+        void readNetworkFmu(BufferReader & in, Network::NetworkFmuInformation & fmu)
+        {
+            in.read(fmu.mpiPos);
+            in.read(fmu.corePos);
+            in.read(fmu.solverPos);
+            in.read(fmu.inputMap);
+            in.read(fmu.outputMap);
+        }
+#endif
+    }
+
+    vector<char> PlanSerializer::serialize(const ProgramPlan & plan)
+    {
+        // every connection once, ordered by id
+        map<size_type, shared_ptr<ConnectionPlan>> connections;
+        for (const auto & node : plan.simPlans)
+            for (const auto & sim : node)
+                for (const auto & solver : sim.dataManager.solvers)
+                {
+                    for (const auto & con : solver->outConnections)
+                        connections[con->id] = con;
+                    for (const auto & con : solver->inConnections)
+                        connections[con->id] = con;
+                }
+
+        BufferWriter out;
+        out.write(plan.useProcesses);
+        out.write(static_cast<size_type>(connections.size()));
+        for (const auto & con : connections)
+            writeConnection(out, *con.second);
+        out.write(static_cast<size_type>(plan.simPlans.size()));
+        for (const auto & node : plan.simPlans)
+        {
+            out.write(static_cast<size_type>(node.size()));
+            for (const auto & sim : node)
+                writeSimulation(out, sim);
+        }
+        return std::move(out.buffer);
+    }
+
+    ProgramPlan PlanSerializer::deserializeProgramPlan(const vector<char> & buffer)
+    {
+        ProgramPlan res;
+        BufferReader in(buffer);
+        in.read(res.useProcesses);
+
+        map<size_type, shared_ptr<ConnectionPlan>> connections;
+        size_type size;
+        in.read(size);
+        for (size_type i = 0; i < size; ++i)
+        {
+            auto con = make_shared<ConnectionPlan>();
+            readConnection(in, *con);
+            connections[con->id] = con;
+        }
+
+        in.read(size);
+        res.simPlans.resize(size);
+        for (auto & node : res.simPlans)
+        {
+            in.read(size);
+            node.resize(size);
+            for (auto & sim : node)
+                readSimulation(in, sim, connections);
+            if (node.empty())
+                continue;
+            // shared by all cores of the node, like in XMLConfigurationReader
+            auto tmpCom = make_shared<Synchronization::Communicator>(node.front().idleSpins,
+                                                                     node.front().maxIdleParkTime);
+            auto tmpGvt = make_shared<Synchronization::GlobalVirtualTime>(node.front().startTime,
+                                                                          node.front().endTime);
+            for (auto & sim : node)
+            {
+                sim.dataManager.commnicator = tmpCom;
+                sim.globalTime = tmpGvt;
+            }
+        }
+        if (!in.isEnd())
+            throw runtime_error("PlanSerializer: Buffer is larger than the program plan.");
+        return res;
+    }
+
+#ifdef USE_NETWORK_OFFLOADER
+    vector<char> PlanSerializer::serialize(const Network::NetworkPlan & plan)
+    {
+        BufferWriter out;
+        out.write(static_cast<size_type>(plan.fmuNet.size()));
+        for (const auto & fmu : plan.fmuNet)
+            writeNetworkFmu(out, fmu);
+        return std::move(out.buffer);
+    }
+
+    Network::NetworkPlan PlanSerializer::deserializeNetworkPlan(const vector<char> & buffer)
+    {
+        Network::NetworkPlan res;
+        BufferReader in(buffer);
+        size_type size;
+        in.read(size);
+        res.fmuNet.resize(size);
+        for (auto & fmu : res.fmuNet)
+            readNetworkFmu(in, fmu);
+        return res;
+    }
+#endif
+
+} /* namespace Initialization */
@@ -6,12 +6,27 @@
  */
 
 #include "initialization/MainFactory.hpp"
+#include "initialization/PlanSerializer.hpp"
 #include "initialization/Program.hpp"
 #include "initialization/XMLConfigurationReader.hpp"
 #include "simulation/AbstractSimulation.hpp"
+#include "util/ThreadHelper.hpp"
+#include "synchronization/SHMConnection.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #ifdef USE_MPI
 #include <mpi.h>
+#include "synchronization/mpi/MPIRMAConnection.hpp"
+#include "synchronization/mpi/MPISHMConnection.hpp"
+#include "synchronization/mpi/MPIChannels.hpp"
 #endif
 
 #ifdef USE_NETWORK_OFFLOADER
@@ -26,6 +41,7 @@ namespace Initialization
             : _isInitialized(false),
               _usingMPI(false),
               _usingOMP(false),
+              _mpiThreadLevel(0),
               _commandLineArgs(std::move(cla)),
               _progPlan(),
               _simulations()
@@ -54,20 +70,55 @@ namespace Initialization
         }
 
         Util::Logger::initialize(_commandLineArgs.getLogSettings());
+        // MPI is initialized first, so only the first MPI process reads the config file. Runs, which weren't launched
+        // with several MPI processes, don't initialize MPI before they know that the plan needs it, since worker
+        // processes can't be forked after MPI_Init.
+        int rank = 0, numRanks = 1;
+        bool mpiInitialized = false;
+        if (getNumLaunchedRanks() > 1)
+        {
+            mpiInitialized = initMPI(rank, numRanks);
+        }
+
         // Create simulation plan(s). If MPI should be used we have several simulation plans (One plan for each MPI process).
-        // Read config file:
-        XMLConfigurationReader reader(_commandLineArgs.getConfigFilePath());
-        _progPlan = reader.getProgramPlan();
+        if (rank == 0)
+        {
+            XMLConfigurationReader reader(_commandLineArgs.getConfigFilePath());
+            _progPlan = reader.getProgramPlan();
+        }
+        if (numRanks > 1)
+        {
+            broadcastProgramPlan(rank);
+        }
 
-        // test for MPI initialization:
-        int rank = 0, numRanks = 1;
         if (_progPlan.simPlans.size() > 1)
         {
-            LOGGER_WRITE("Initialize MPI ...", Util::LC_LOADER, Util::LL_INFO);
-            if (!initMPI(rank, numRanks))
+            // the launcher wasn't recognized, every MPI process has read the config file itself
+            if (!mpiInitialized)
+            {
+                mpiInitialized = initMPI(rank, numRanks);
+            }
+            if (!mpiInitialized)
             {
                 throw runtime_error("Couldn't initialize simulation. MPI couldn't be initialized.");
             }
+            if (numRanks < static_cast<int>(_progPlan.simPlans.size()))
+            {
+                throw runtime_error("Program: Not enough mpi processes for given schedule.");
+            }
+            else if (numRanks > static_cast<int>(_progPlan.simPlans.size()))
+            {
+                LOGGER_WRITE("Program: More mpi process given than the simulation will use.", Util::LC_LOADER,
+                             Util::LL_WARNING);
+            }
+            checkMPIThreadLevel();
+            _usingMPI = true;
+            offsetImplicitCpus(rank);
+        }
+        else
+        {
+            // without a schedule for several nodes every process simulates the whole plan
+            rank = 0;
         }
 
         if (rank == 0)
@@ -84,35 +135,196 @@ namespace Initialization
             }
         }
 
+        if (_progPlan.useProcesses)
+        {
+            if (_progPlan.simPlans.size() > 1)
+            {
+                throw runtime_error("Program: Worker processes are only supported for simulations on one node.");
+            }
+            if (mpiInitialized)
+            {
+                throw runtime_error("Program: Worker processes can't be forked by MPI processes.");
+            }
+            // before the simulations are created, since the connections between the workers change their kind
+            Synchronization::SHMConnection::createSegment(_progPlan);
+        }
+
+        if (_usingMPI)
+        {
+            initMPIConnections(rank);
+        }
+
         // Let the factory create and initialize the simulation.
         MainFactory mf;
 
-        // Not in parallel because FmuSdkFMU::load and FmiLibFmu::load is not save to call in parallel!
         for (auto & i : _progPlan.simPlans[rank])
         {
             _simulations.push_back(mf.createSimulation(i));
         }
 
+        // Worker processes load their FMUs themselves, so no FMU instance is inherited by fork().
+        if (!_progPlan.useProcesses)
+        {
+            loadFmus();
+        }
+
         _isInitialized = true;
     }
 
-    void Program::simulate()
+    void Program::loadFmus()
     {
+        bool pinned = false;
+        for (auto & simulation : _simulations)
+            pinned = pinned || simulation->getCpuId() >= 0;
+        if (!pinned)
+        {
+            // The FMUs of all simulations are loaded by one thread pool, instead of serially by the simulation threads.
+            vector<Solver::SolverSPtr> solvers;
+            for (auto & simulation : _simulations)
+                solvers.insert(solvers.end(), simulation->getSolver().begin(), simulation->getSolver().end());
+            Simulation::AbstractSimulation::loadFmus(solvers);
+            return;
+        }
+
+        // An unpinned pool would first touch the memory of the FMU instances on arbitrary CPUs. So like in simulate(),
+        // every simulation thread pins itself and then loads the FMUs of its own simulation.
+        std::exception_ptr error;
         size_type threadNum = 0;
-        // not in parallel, Communicator::addFmu is not safe to call
-        for (auto & sim : _simulations)
+#pragma omp parallel num_threads(_simulations.size()) firstprivate(threadNum)
+        {
+#ifdef USE_OPENMP
+            threadNum = omp_get_thread_num();
+#endif
+            // exceptions must not leave the parallel region
+            try
+            {
+                Util::ThreadHelper::pinCurrentThread(_simulations[threadNum]->getCpuId());
+                Simulation::AbstractSimulation::loadFmus(_simulations[threadNum]->getSolver());
+            }
+            catch (...)
+            {
+#pragma omp critical (ProgramLoadFmus)
+                {
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void Program::simulate()
+    {
+        if (_progPlan.useProcesses)
         {
-            sim->initialize();
+            simulateInProcesses();
+            return;
         }
-#pragma omp parallel num_threads(_simulations.size())
+        size_type threadNum = 0;
+#pragma omp parallel num_threads(_simulations.size()) firstprivate(threadNum)
         {
 #ifdef USE_OPENMP
             threadNum = omp_get_thread_num();
 #endif
+            // Pin first and initialize afterwards, so histories and solver vectors are first touched by the thread
+            // working on them and end up in its local NUMA memory. The FMUs are already loaded by loadFmus().
+            Util::ThreadHelper::pinCurrentThread(_simulations[threadNum]->getCpuId());
+            // Serialized, since Communicator::addFmu is not safe to call in parallel.
+#pragma omp critical (ProgramSimulationInitialize)
+            {
+                _simulations[threadNum]->initialize();
+            }
+#pragma omp barrier
             _simulations[threadNum]->simulate();
         }
     }
 
+    void Program::simulateInProcesses()
+    {
+        vector<pid_t> workers;
+        // otherwise buffered output is written by every worker
+        std::cout.flush();
+        std::fflush(nullptr);
+        for (size_type i = 0; i < _simulations.size(); ++i)
+        {
+            pid_t pid = fork();
+            if (pid < 0)
+            {
+                stopWorkers(workers);
+                Synchronization::SHMConnection::freeSegment();
+                throw runtime_error("Program: Couldn't fork worker process.");
+            }
+            else if (pid == 0)
+            {
+                int status = EXIT_SUCCESS;
+                try
+                {
+                    Util::ThreadHelper::pinCurrentThread(_simulations[i]->getCpuId());
+                    _simulations[i]->initialize();
+                    _simulations[i]->simulate();
+                    // destroy the simulation, so its results are written
+                    _simulations[i].reset();
+                }
+                catch (std::exception & ex)
+                {
+                    LOGGER_WRITE("Program: Worker " + to_string(i) + " failed: " + ex.what(), Util::LC_LOADER,
+                                 Util::LL_ERROR);
+                    status = EXIT_FAILURE;
+                }
+                // The worker must neither run the atexit handlers nor the static destructors of the parent's copy,
+                // so it leaves via _exit and flushes its buffered output itself.
+                std::cout.flush();
+                std::clog.flush();
+                std::fflush(nullptr);
+                _exit(status);
+            }
+            workers.push_back(pid);
+        }
+
+        // Workers are reaped in the order they finish. The first failed worker stops the others, since they might
+        // wait forever for its outputs.
+        bool failed = false;
+        while (!workers.empty())
+        {
+            int status = 0;
+            pid_t pid = waitpid(-1, &status, 0);
+            if (pid < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                failed = true;
+                break;
+            }
+            auto it = std::find(workers.begin(), workers.end(), pid);
+            if (it == workers.end())
+                continue;
+            workers.erase(it);
+            if (!failed && (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS))
+            {
+                LOGGER_WRITE("Program: Worker process " + to_string(pid) + " failed, stopping the others.",
+                             Util::LC_LOADER, Util::LL_ERROR);
+                failed = true;
+                for (const pid_t other : workers)
+                    kill(other, SIGTERM);
+            }
+        }
+        Synchronization::SHMConnection::freeSegment();
+        if (failed)
+        {
+            throw runtime_error("Program: A worker process failed.");
+        }
+    }
+
+    void Program::stopWorkers(const vector<pid_t> & workers)
+    {
+        for (const pid_t pid : workers)
+            kill(pid, SIGTERM);
+        for (const pid_t pid : workers)
+            while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR)
+                ;
+    }
+
     void Program::deinitialize()
     {
         if (_isInitialized)
@@ -176,31 +388,121 @@ namespace Initialization
     {
 #ifdef USE_MPI
 
-        if (!(_commandLineArgs.getProgramArgs() == make_tuple<const int *, const char ***>(nullptr, nullptr))
-                && MPI_SUCCESS
-                        == MPI_Init(get<0>(_commandLineArgs.getProgramArgs()),
-                                    get<1>(_commandLineArgs.getProgramArgs())))
+        if (!(_commandLineArgs.getProgramArgs() == make_tuple<const int *, const char ***>(nullptr, nullptr)))
         {
-            MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
-            if (numRanks < static_cast<int>(_progPlan.simPlans.size()))
+            LOGGER_WRITE("Initialize MPI ...", Util::LC_LOADER, Util::LL_INFO);
+            // the provided level is checked against the plan by checkMPIThreadLevel(), which isn't known yet
+            if (MPI_SUCCESS
+                    == MPI_Init_thread(get<0>(_commandLineArgs.getProgramArgs()),
+                                       get<1>(_commandLineArgs.getProgramArgs()), MPI_THREAD_MULTIPLE,
+                                       &_mpiThreadLevel))
             {
-                deinitialize();
-                throw runtime_error("Program: Not enough mpi processes for given schedule.");
+                MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+                MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+                return true;
             }
-            else if (numRanks > static_cast<int>(_progPlan.simPlans.size()))
+        }
+        return false;
+#else
+        //throw std::runtime_error("Program: MPI not supported by this system.");
+        return false;
+#endif
+    }
+
+    void Program::checkMPIThreadLevel() const
+    {
+#ifdef USE_MPI
+        size_type maxNumCores = 0;
+        for (const auto & nodePlans : _progPlan.simPlans)
+            maxNumCores = std::max(maxNumCores, static_cast<size_type>(nodePlans.size()));
+        // the same on every process, so all of them fail instead of some waiting for the others
+        int requiredLevel = (maxNumCores > 1) ? MPI_THREAD_MULTIPLE : MPI_THREAD_FUNNELED;
+        if (_mpiThreadLevel < requiredLevel)
+        {
+            const map<int, string_type> names = {
+                { MPI_THREAD_SINGLE, "MPI_THREAD_SINGLE" },
+                { MPI_THREAD_FUNNELED, "MPI_THREAD_FUNNELED" },
+                { MPI_THREAD_SERIALIZED, "MPI_THREAD_SERIALIZED" },
+                { MPI_THREAD_MULTIPLE, "MPI_THREAD_MULTIPLE" } };
+            auto provided = names.find(_mpiThreadLevel);
+            throw runtime_error(
+                    "Program: The MPI library only provides "
+                            + ((provided != names.end()) ? provided->second : to_string(_mpiThreadLevel)) + ", but "
+                            + names.at(requiredLevel) + " is needed for " + to_string(maxNumCores)
+                            + " cores per node. Use an MPI library with thread support or one core per node.");
+        }
+#endif
+    }
+
+    void Program::offsetImplicitCpus(const int & rank)
+    {
+#ifdef USE_MPI
+        // processes without a plan take part with zero cores, since the split and the scan are collective
+        int numCores = (rank < static_cast<int>(_progPlan.simPlans.size())) ?
+                static_cast<int>(_progPlan.simPlans[rank].size()) : 0;
+        int offset = 0;
+        MPI_Comm nodeComm;
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+        MPI_Exscan(&numCores, &offset, 1, MPI_INT, MPI_SUM, nodeComm);
+        int nodeRank = 0;
+        MPI_Comm_rank(nodeComm, &nodeRank);
+        MPI_Comm_free(&nodeComm);
+        // the result of MPI_Exscan is undefined on the first process
+        if (nodeRank == 0 || numCores == 0)
+        {
+            return;
+        }
+        for (auto & simPlan : _progPlan.simPlans[rank])
+        {
+            if (simPlan.implicitCpu)
             {
-                LOGGER_WRITE("Program: More mpi process given than the simulation will use.", Util::LC_LOADER,
-                             Util::LL_WARNING);
+                simPlan.cpuId += offset;
+            }
+        }
+#else
+        (void) rank;
+#endif
+    }
+
+    int Program::getNumLaunchedRanks()
+    {
+        // set by the launchers of OpenMPI, MPICH/Intel MPI (Hydra) and MVAPICH
+        for (const char * name : { "OMPI_COMM_WORLD_SIZE", "PMI_SIZE", "MV2_COMM_WORLD_SIZE" })
+        {
+            const char * value = std::getenv(name);
+            if (value != nullptr)
+            {
+                return std::atoi(value);
             }
-            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-            _usingMPI = true;
-            return true;
         }
+        return 1;
+    }
+
+    void Program::broadcastProgramPlan(const int & rank)
+    {
+        vector<char> buffer;
+        if (rank == 0)
         {
-            return false;
+            buffer = PlanSerializer::serialize(_progPlan);
         }
-#else
-        //throw std::runtime_error("Program: MPI not supported by this system.");
+        broadcast(buffer);
+        if (rank != 0)
+        {
+            _progPlan = PlanSerializer::deserializeProgramPlan(buffer);
+        }
+    }
+
+    void Program::broadcast(vector<char> & buffer)
+    {
+#ifdef USE_MPI
+        unsigned long long size = buffer.size();
+        MPI_Bcast(&size, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+        if (size > static_cast<unsigned long long>(std::numeric_limits<int>::max()))
+        {
+            throw runtime_error("Program: Plan of " + to_string(size) + " bytes is too large for a broadcast.");
+        }
+        buffer.resize(size);
+        MPI_Bcast(buffer.data(), static_cast<int>(size), MPI_BYTE, 0, MPI_COMM_WORLD);
 #endif
     }
 
@@ -219,67 +521,8 @@ namespace Initialization
 #ifdef USE_MPI
             if (_usingMPI)
             {
-                int num = np.fmuNet.size();
-                MPI_Bcast(&num, 1, MPI_INT, 0, MPI_COMM_WORLD);
-                for (const auto & addFmu : np.fmuNet)
-                {
-                    // sim num
-                    MPI_Bcast((void*) (&addFmu.mpiPos), 1, MPI_UINT32_T, 0, MPI_COMM_WORLD);
-                    // core num
-                    MPI_Bcast((void*) (&addFmu.corePos), 1, MPI_UINT32_T, 0, MPI_COMM_WORLD);
-                    // solver num
-                    MPI_Bcast((void*) (&addFmu.solverPos), 1, MPI_UINT32_T, 0, MPI_COMM_WORLD);
-
-                    // inputs
-                    num = addFmu.inputMap.size<real_type>();
-                    MPI_Bcast(&num, 1, MPI_INT, 0, MPI_COMM_WORLD);
-                    MPI_Bcast((void*) addFmu.inputMap.data<real_type>(), 2 * addFmu.inputMap.size<real_type>(),
-                    MPI_UINT32_T,
-                              0, MPI_COMM_WORLD);
-
-                    num = addFmu.inputMap.size<int_type>();
-                    MPI_Bcast(&num, 1, MPI_INT, 0, MPI_COMM_WORLD);
-                    MPI_Bcast((void*) addFmu.inputMap.data<int_type>(), 2 * addFmu.inputMap.size<int_type>(),
-                    MPI_UINT32_T,
-                              0, MPI_COMM_WORLD);
-
-                    num = addFmu.inputMap.size<bool_type>();
-                    MPI_Bcast(&num, 1, MPI_INT, 0, MPI_COMM_WORLD);
-                    MPI_Bcast((void*) addFmu.inputMap.data<bool_type>(), 2 * addFmu.inputMap.size<bool_type>(),
-                    MPI_UINT32_T,
-                              0, MPI_COMM_WORLD);
-
-                    num = addFmu.inputMap.size<string_type>();
-                    MPI_Bcast(&num, 1, MPI_INT, 0, MPI_COMM_WORLD);
-                    MPI_Bcast((void*) addFmu.inputMap.data<string_type>(), 2 * addFmu.inputMap.size<string_type>(),
-                    MPI_UINT32_T,
-                              0, MPI_COMM_WORLD);
-
-                    //outputs
-                    num = addFmu.outputMap.size<real_type>();
-                    MPI_Bcast(&num, 1, MPI_INT, 0, MPI_COMM_WORLD);
-                    MPI_Bcast((void*) addFmu.outputMap.data<real_type>(), 2 * addFmu.outputMap.size<real_type>(),
-                    MPI_UINT32_T,
-                              0, MPI_COMM_WORLD);
-
-                    num = addFmu.outputMap.size<int_type>();
-                    MPI_Bcast(&num, 1, MPI_INT, 0, MPI_COMM_WORLD);
-                    MPI_Bcast((void*) addFmu.outputMap.data<int_type>(), 2 * addFmu.outputMap.size<int_type>(),
-                    MPI_UINT32_T,
-                              0, MPI_COMM_WORLD);
-
-                    num = addFmu.outputMap.size<bool_type>();
-                    MPI_Bcast(&num, 1, MPI_INT, 0, MPI_COMM_WORLD);
-                    MPI_Bcast((void*) addFmu.outputMap.data<bool_type>(), 2 * addFmu.outputMap.size<bool_type>(),
-                    MPI_UINT32_T,
-                              0, MPI_COMM_WORLD);
-
-                    num = addFmu.outputMap.size<string_type>();
-                    MPI_Bcast(&num, 1, MPI_INT, 0, MPI_COMM_WORLD);
-                    MPI_Bcast((void*) addFmu.outputMap.data<string_type>(), 2 * addFmu.outputMap.size<string_type>(),
-                    MPI_UINT32_T,
-                              0, MPI_COMM_WORLD);
-                }
+                vector<char> buffer = PlanSerializer::serialize(np);
+                broadcast(buffer);
             }
 #endif
         }
@@ -291,61 +534,9 @@ namespace Initialization
             {
                 throw runtime_error("Cannot start mpi simulation.");
             }
-            // quick and dirty bcast for the remote simulation data aka. for the NetworkPlan
-            int num = 0;
-            MPI_Recv(&num, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-            vector<tuple<size_type, size_type> > tmp1, tmp2, tmp3, tmp4;
-            for (int i = 0; i < num; ++i)
-            {
-                np.fmuNet.push_back(Network::NetworkFmuInformation());
-
-                // sim num
-                MPI_Recv((void*) (&np.fmuNet.back().mpiPos), 1, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                // core num
-                MPI_Recv((void*) (&np.fmuNet.back().corePos), 1, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                // solver num
-                MPI_Recv((void*) (&np.fmuNet.back().solverPos), 1, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD,
-                MPI_STATUS_IGNORE);
-
-                //inputs
-                MPI_Recv(&num, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                tmp1.resize(num);
-                MPI_Recv((void*) tmp1.data(), 2 * num, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-                MPI_Recv(&num, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                tmp2.resize(num);
-                MPI_Recv((void*) tmp2.data(), 2 * num, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-                MPI_Recv(&num, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                tmp3.resize(num);
-                MPI_Recv((void*) tmp3.data(), 2 * num, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-                MPI_Recv(&num, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                tmp4.resize(num);
-                MPI_Recv((void*) tmp4.data(), 2 * num, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-                np.fmuNet.back().inputMap = FMI::InputMapping(tmp1, tmp2, tmp3, tmp4);
-
-                //inputs
-                MPI_Recv(&num, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                tmp1.resize(num);
-                MPI_Recv((void*) tmp1.data(), 2 * num, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-                MPI_Recv(&num, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                tmp2.resize(num);
-                MPI_Recv((void*) tmp2.data(), 2 * num, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-                MPI_Recv(&num, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                tmp3.resize(num);
-                MPI_Recv((void*) tmp3.data(), 2 * num, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-                MPI_Recv(&num, 1, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-                tmp4.resize(num);
-                MPI_Recv((void*) tmp4.data(), 2 * num, MPI_UINT32_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-                np.fmuNet.back().outputMap = FMI::InputMapping(tmp1, tmp2, tmp3, tmp4);
-            }
-
+            vector<char> buffer;
+            broadcast(buffer);
+            np = PlanSerializer::deserializeNetworkPlan(buffer);
 #else
             // test if the rank is on default (0), if not something is wrong with @param rank.
             throw runtime_error("Internal error. Rank mismatch in network initialization.");
@@ -357,11 +548,32 @@ namespace Initialization
         return true;
     }
 
+    void Program::initMPIConnections(const int & rank)
+    {
+#ifdef USE_MPI
+        // connections between ranks of the same node use shared memory instead
+        Synchronization::MPISHMConnection::createWindow(_progPlan, rank);
+        Synchronization::MPIChannels::create(_progPlan);
+        // collective, so every rank creates the window, whether it uses mpirma connections or not
+        Synchronization::MPIRMAConnection::createWindow();
+#endif
+    }
+
     void Program::deinitMPI()
     {
         _isInitialized = false;
 #ifdef USE_MPI
         if (_usingMPI)
+        {
+            Synchronization::MPIRMAConnection::freeWindow();
+            Synchronization::MPISHMConnection::freeWindow();
+            Synchronization::MPIChannels::free();
+        }
+        // MPI is initialized for every process launched by mpirun, even if the plan doesn't use several nodes
+        int initialized = 0, finalized = 0;
+        MPI_Initialized(&initialized);
+        MPI_Finalized(&finalized);
+        if (initialized && !finalized)
         {
             MPI_Finalize();
         }
@@ -1,5 +1,6 @@
 #include "initialization/XMLConfigurationReader.hpp"
 #include "synchronization/Communicator.hpp"
+#include "synchronization/GlobalVirtualTime.hpp"
 
 #include <boost/optional/optional.hpp>
 
@@ -30,12 +31,18 @@ namespace Initialization
         res.version = fmuElem.second.get<string_type>("<xmlattr>.version", res.version);
         res.logEnabled = fmuElem.second.get<bool>("<xmlattr>.loggingEnabled", res.logEnabled);
         res.workingPath = fmuElem.second.get<string_type>("<xmlattr>.workingPath", res.workingPath);
+        res.cachePath = fmuElem.second.get<string_type>("<xmlattr>.cachePath", res.cachePath);
 
         checkForUndefinedValues(res.path, res.loader, res.name, res.version, res.workingPath);
 
-        if (res.version != "1.0")
+        if (res.loader == "fmi2")
         {
-            throw runtime_error("XMLConfigurationReader: FMUs with a version higher than 1.0 aren't supported yet.");
+            if (res.version != "2.0")
+                throw runtime_error("XMLConfigurationReader: The loader fmi2 needs FMUs of version 2.0.");
+        }
+        else if (res.version != "1.0")
+        {
+            throw runtime_error("XMLConfigurationReader: FMUs with a version higher than 1.0 need the loader fmi2.");
         }
 
         return res;
@@ -86,6 +93,12 @@ namespace Initialization
         {
             solv.fmu->id = id;
         }
+        if (solv.kind == "cosim")
+        {
+            if (solv.fmu->loader != "fmi2")
+                throw runtime_error("XMLConfigurationReader: The solver cosim needs the loader fmi2.");
+            solv.fmu->coSimulation = true;
+        }
         return list<SolverPlan>(1, solv);
     }
 
@@ -132,8 +145,20 @@ namespace Initialization
         }
 
         res.bufferSize = mapElem.second.get<size_type>("<xmlattr>.bufferSize", res.bufferSize);
+        res.batchSize = mapElem.second.get<size_type>("<xmlattr>.batchSize", res.batchSize);
+        res.maxBatchBytes = mapElem.second.get<size_type>("<xmlattr>.maxBatchBytes", res.maxBatchBytes);
+        if (res.batchSize == 0)
+        {
+            throw runtime_error("XMLConfigurationReader: The batch size of a connection needs to be positive.");
+        }
         res.destFmu = mapElem.second.get<string_type>("<xmlattr>.dest", res.destFmu);
         res.sourceFmu = mapElem.second.get<string_type>("<xmlattr>.source", res.sourceFmu);
+        res.encoding = mapElem.second.get<string_type>("<xmlattr>.encoding", res.encoding);
+        if (res.encoding != "full" && res.encoding != "delta")
+        {
+            throw runtime_error("XMLConfigurationReader: Unknown connection encoding " + res.encoding);
+        }
+        real_type deadband = mapElem.second.get<real_type>("<xmlattr>.deadband", 0.0);
 
         for (ptree::value_type &varMapElem : mapElem.second.get_child(""))
         {
@@ -148,6 +173,11 @@ namespace Initialization
             if (varType == "real")
             {
                 res.inputMapping.push_back<double>(con);
+                res.deadbands.push_back(varMapElem.second.get<real_type>("<xmlattr>.deadband", deadband));
+                if (res.deadbands.back() < 0.0)
+                {
+                    throw runtime_error("XMLConfigurationReader: The deadband of a connection can't be negative.");
+                }
             }
             else if (varType == "int")
             {
@@ -177,9 +207,23 @@ namespace Initialization
         if (_propertyTree.get_child_optional("configuration.connections"))
         {
             auto connElems = _propertyTree.get_child("configuration.connections");
+            string_type remoteKind = connElems.get<string_type>("<xmlattr>.remoteKind",
+                                                                DefaultValues::connectionPlan().remoteKind);
+            bool sharedMemory = connElems.get<bool>("<xmlattr>.sharedMemory",
+                                                    DefaultValues::connectionPlan().sharedMemory);
             for (ptree::value_type & mapElem : connElems)
             {
+                if (mapElem.first == "<xmlattr>")
+                {
+                    continue;
+                }
                 res.push_back(getConnectionPlan(mapElem));
+                res.back().remoteKind = mapElem.second.get<string_type>("<xmlattr>.remoteKind", remoteKind);
+                if (res.back().remoteKind != "mpi" && res.back().remoteKind != "mpirma")
+                {
+                    throw runtime_error("XMLConfigurationReader: Unknown remote connection kind " + res.back().remoteKind);
+                }
+                res.back().sharedMemory = mapElem.second.get<bool>("<xmlattr>.sharedMemory", sharedMemory);
             }
         }
         return res;
@@ -195,12 +239,39 @@ namespace Initialization
         res.defaultTolerance = simElem.get<real_type>("<xmlattr>.defaultTolerance", res.defaultTolerance);
         res.endTime = simElem.get<real_type>("<xmlattr>.endTime");
         res.startTime = simElem.get<real_type>("<xmlattr>.startTime ", res.startTime);
+        res.idleSpins = simElem.get<size_type>("<xmlattr>.idleSpins", res.idleSpins);
+        res.maxIdleParkTime = simElem.get<real_type>("<xmlattr>.maxIdleParkTime", res.maxIdleParkTime);
+        res.maxSolveQuantum = simElem.get<size_type>("<xmlattr>.maxSolveQuantum", res.maxSolveQuantum);
+        res.kind = simElem.get<string_type>("<xmlattr>.kind", res.kind);
+        res.coupling = simElem.get<string_type>("<xmlattr>.coupling", res.coupling);
+        res.macroStepSize = simElem.get<real_type>("<xmlattr>.macroStepSize", res.macroStepSize);
+        res.globalTimeInterval = simElem.get<size_type>("<xmlattr>.globalTimeInterval", res.globalTimeInterval);
+        if (res.coupling != "free" && res.coupling != "gaussSeidel")
+        {
+            throw runtime_error("XMLConfigurationReader: Unknown coupling " + res.coupling);
+        }
+        if (res.kind != "serial" && res.kind != "task")
+        {
+            throw runtime_error("XMLConfigurationReader: Unknown simulation kind " + res.kind);
+        }
+        if (res.kind == "task" && res.coupling != "free")
+        {
+            throw runtime_error("XMLConfigurationReader: Task simulations only support free coupling.");
+        }
+        if (res.macroStepSize <= 0.0)
+        {
+            throw runtime_error("XMLConfigurationReader: The macro step size needs to be positive.");
+        }
+        if (res.globalTimeInterval == 0)
+        {
+            throw runtime_error("XMLConfigurationReader: The global time interval needs to be positive.");
+        }
         checkForUndefinedValues(res.defaultEventInterval, res.defaultMaxError, res.defaultTolerance, res.endTime,
                                 res.startTime);
         return res;
     }
 
-    vector<vector<size_type>> XMLConfigurationReader::getNodeSchedule(ptree::value_type & nodeElem)
+    vector<vector<size_type>> XMLConfigurationReader::getNodeSchedule(ptree::value_type & nodeElem, vector<int> & cpus)
     {
         vector<vector<size_type>> res;
 
@@ -209,11 +280,18 @@ namespace Initialization
             if (coreElem.first == "core")
             {
                 res.push_back(vector<size_type>(coreElem.second.get<size_type>("<xmlattr>.numFmus", 0)));
+                cpus.push_back(coreElem.second.get<int>("<xmlattr>.cpu", -1));
             }
             else if (coreElem.first == "cores")
             {
-                res.resize(res.size() + coreElem.second.get<size_type>("<xmlattr>.numCores", 0),
+                size_type numNewCores = coreElem.second.get<size_type>("<xmlattr>.numCores", 0);
+                int firstCpu = coreElem.second.get<int>("<xmlattr>.firstCpu", -1);
+                res.resize(res.size() + numNewCores,
                            vector<size_type>(coreElem.second.get<size_type>("<xmlattr>.numFmusPerCore", 0), 0));
+                for (size_type i = 0; i < numNewCores; ++i)
+                {
+                    cpus.push_back((firstCpu < 0) ? -1 : firstCpu + static_cast<int>(i));
+                }
             }
         }
         return res;
@@ -227,11 +305,17 @@ namespace Initialization
             auto schedElem = _propertyTree.get_child("configuration.scheduling");
             if (!schedElem.empty())
             {
+                bool pinThreads = schedElem.get<bool>("<xmlattr>.pinThreads", false);
                 for (ptree::value_type &nodeElem : schedElem.get_child(""))
                 {
-                    if (nodeElem.first == "node")
+                    if (nodeElem.first == "<xmlattr>")
+                    {
+                        continue;
+                    }
+                    else if (nodeElem.first == "node")
                     {
-                        res.nodeStructure.push_back(getNodeSchedule(nodeElem));
+                        res.coreToCpu.push_back(vector<int>());
+                        res.nodeStructure.push_back(getNodeSchedule(nodeElem, res.coreToCpu.back()));
                     }
                     else if (nodeElem.first == "nodes")
                     {
@@ -250,15 +334,37 @@ namespace Initialization
                         {
                             throw runtime_error("In tag <nodes> the attribute 'numFmusPerCore' is missing.");
                         }
+                        int firstCpu = nodeElem.second.get<int>("<xmlattr>.firstCpu", -1);
 
                         res.nodeStructure.resize(res.nodeStructure.size() + numNewNodes,
                                                  vector<vector<size_type>>(numNewCores, vector<size_type>(numNewFmus)));
+                        vector<int> cpus(numNewCores, -1);
+                        for (size_type i = 0; i < numNewCores && firstCpu >= 0; ++i)
+                        {
+                            cpus[i] = firstCpu + static_cast<int>(i);
+                        }
+                        res.coreToCpu.resize(res.coreToCpu.size() + numNewNodes, cpus);
                     }
                     else
                     {
                         throw runtime_error("XMLConfigurationReader: In scheduling was an unknown node identifier.");
                     }
                 }
+                // Without explicit CPU the i-th core of a node is pinned to the i-th CPU of the node. Nodes sharing a
+                // machine are offset by the Program, since their placement isn't known here.
+                res.implicitCpu.resize(res.coreToCpu.size());
+                for (size_type i = 0; i < res.coreToCpu.size(); ++i)
+                {
+                    res.implicitCpu[i].resize(res.coreToCpu[i].size(), false);
+                    for (size_type j = 0; j < res.coreToCpu[i].size() && pinThreads; ++j)
+                    {
+                        if (res.coreToCpu[i][j] < 0)
+                        {
+                            res.coreToCpu[i][j] = static_cast<int>(j);
+                            res.implicitCpu[i][j] = true;
+                        }
+                    }
+                }
             }
         }
         return res;
@@ -270,7 +376,7 @@ namespace Initialization
     {
         map<string_type, SolverPlan*> fmuNameToSolver;
         shared_ptr<ConnectionPlan> tmp;
-        size_type tags = 0;
+        size_type numConnections = 0;
         for (SolverPlan & sp : solverPlans)
         {
             fmuNameToSolver[sp.fmu->name] = &sp;
@@ -279,6 +385,7 @@ namespace Initialization
         for (ConnectionPlan & cp : connPlans)
         {
             tmp = make_shared<ConnectionPlan>(cp);
+            tmp->id = numConnections++;
             tuple<size_type, size_type> destId, sourceId;
             destId = schedPlan.solverIdToCore[fmuNameToSolver[cp.destFmu]->id];
             sourceId = schedPlan.solverIdToCore[fmuNameToSolver[cp.sourceFmu]->id];
@@ -292,9 +399,7 @@ namespace Initialization
             }
             else
             {
-                tmp->kind = "mpi";
-                tmp->startTag = tags;
-                tags += tmp->bufferSize;
+                tmp->kind = tmp->remoteKind;
                 tmp->destRank = get<0>(destId);
                 tmp->sourceRank = get<0>(sourceId);
             }
@@ -376,7 +481,8 @@ namespace Initialization
         // Setting history and Sim kind:
         for (size_type i = 0; i < res.size(); ++i)
         {
-            auto tmpCom = make_shared<Synchronization::Communicator>();
+            auto tmpCom = make_shared<Synchronization::Communicator>(simPlan.idleSpins, simPlan.maxIdleParkTime);
+            auto tmpGvt = make_shared<Synchronization::GlobalVirtualTime>(simPlan.startTime, simPlan.endTime);
             for (size_type j = 0; j < res[i].size(); ++j)
             {
                 res[i][j].dataManager.writer.startTime = simPlan.startTime;  // Maybe different to the others
@@ -385,8 +491,11 @@ namespace Initialization
                         + res[i][j].dataManager.writer.filePath;
                 res[i][j].dataManager.history.kind = "serial";  // is only for extension (work in progress) to support different kinds of data histories
                 res[i][j].dataManager.commnicator = tmpCom;
+                res[i][j].cpuId = schedPlan.coreToCpu[i][j];
+                res[i][j].implicitCpu = schedPlan.implicitCpu[i][j];
 
-                res[i][j].kind = "serial";
+                res[i][j].kind = simPlan.kind;
+                res[i][j].globalTime = tmpGvt;
             }
         }
         return res;
@@ -394,7 +503,8 @@ namespace Initialization
 
     ProgramPlan XMLConfigurationReader::getProgramPlan()
     {
-        ProgramPlan res;
+        ProgramPlan res = DefaultValues::programPlan();
+        res.useProcesses = _propertyTree.get<bool>("configuration.scheduling.<xmlattr>.processes", res.useProcesses);
 
         SimulationPlan simPlan = getDefaultSimulationPlan();
         list<SolverPlan> solverPlans = getSolverPlans(simPlan);
@@ -405,6 +515,8 @@ namespace Initialization
         {
             // TODO(mf): do scheduling
             schedPlan.nodeStructure = vector<vector<vector<size_type>>>(1, vector<vector<size_type>>(1, vector<size_type>(1)));
+            schedPlan.coreToCpu = vector<vector<int>>(1, vector<int>(1, -1));
+            schedPlan.implicitCpu = vector<vector<bool>>(1, vector<bool>(1, false));
             schedPlan.solverIdToCore.resize(solverPlans.size());
             for(size_type i = 0; i < solverPlans.size(); ++i)
             {
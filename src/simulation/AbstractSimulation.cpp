@@ -1,12 +1,15 @@
 #include "simulation/AbstractSimulation.hpp"
 #include "solver/AbstractSolver.hpp"
 
+#include <exception>
+
 namespace Simulation
 {
 
     AbstractSimulation::AbstractSimulation(const Initialization::SimulationPlan & in, const vector<shared_ptr<Solver::ISolver>> & solver)
             : _solver(solver),
-              _maxIterations(std::numeric_limits<size_type>::max() - 2)
+              _maxIterations(std::numeric_limits<size_type>::max() - 2),
+              _cpuId(in.cpuId)
     {
         assert(solver.size() > 0);
         _simulationEndTime = std::numeric_limits<real_type>::max();
@@ -32,10 +35,35 @@ namespace Simulation
 
     void AbstractSimulation::initialize()
     {
+        loadFmus(_solver);
         for (Solver::SolverSPtr& solver : _solver)
             solver->initialize();
     }
 
+    void AbstractSimulation::loadFmus(const vector<shared_ptr<Solver::ISolver>> & solver)
+    {
+        // exceptions must not leave the parallel region
+        std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+        for (size_type i = 0; i < solver.size(); ++i)
+        {
+            try
+            {
+                solver[i]->loadFmu();
+            }
+            catch (...)
+            {
+#pragma omp critical (AbstractSimulationLoadFmus)
+                {
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
     void AbstractSimulation::setSimulationEndTime(const real_type simEnd)
     {
         _simulationEndTime = simEnd;
@@ -53,4 +81,9 @@ namespace Simulation
         _maxIterations = num;
     }
 
+    int AbstractSimulation::getCpuId() const
+    {
+        return _cpuId;
+    }
+
 } /* namespace Simulation */
@@ -1,4 +1,8 @@
 #include "simulation/SerialSimulation.hpp"
+#include "synchronization/GlobalVirtualTime.hpp"
+
+#include <chrono>
+#include <thread>
 //#include <omp.h>
 
 namespace Simulation
@@ -6,57 +10,231 @@ namespace Simulation
 
     SerialSimulation::SerialSimulation(const Initialization::SimulationPlan & in,
                                        const vector<shared_ptr<Solver::ISolver>> & solvers)
-            : AbstractSimulation(in, solvers)
+            : AbstractSimulation(in, solvers),
+              _solveOrder(solvers.size()),
+              _consumers(solvers.size()),
+              _maxSolveQuantum(in.maxSolveQuantum),
+              _coupling(in.coupling),
+              _macroStepSize(in.macroStepSize),
+              _globalTime(in.globalTime),
+              _globalTimeId(0),
+              _globalTimeInterval(in.globalTimeInterval)
     {
+        if (!_globalTime)
+            _globalTime = make_shared<Synchronization::GlobalVirtualTime>(in.startTime, in.endTime);
+        for (size_type i = 0; i < _solveOrder.size(); ++i)
+            _solveOrder[i] = i;
     }
 
     SerialSimulation::~SerialSimulation()
     {
     }
 
+    void SerialSimulation::initialize()
+    {
+        AbstractSimulation::initialize();
+        createSolveOrder();
+        _globalTimeId = _globalTime->addSimulation();
+    }
+
     void SerialSimulation::simulate()
     {
-        bool running = true;
-        size_type iterationCount = 0;
+        if (_coupling == "gaussSeidel")
+        {
+            simulateGaussSeidel();
+            return;
+        }
+        bool running = true, progress;
+        size_type iterationCount = 0, notificationCount;
         //const vector<shared_ptr<Solver::ISolver>>& solver = getSolver();
 
         const auto& solver = getSolver();
 
-        std::vector<size_type> numSteps(solver.size(), 15);
-        size_type tmpStepCount;
+        // all solvers of a simulation share one data manager
+        Synchronization::IDataManager * dataManager = solver.front()->getDataManager();
         double s(0.0), e(0.0);
         //s = omp_get_wtime();
         while (running && getMaxIterations() > ++iterationCount)
         {
             LOGGER_WRITE("Running at iteration " + to_string(iterationCount), Util::LC_SOLVER, Util::LL_DEBUG);
             running = false;
+            notificationCount = dataManager->getNotificationCount();
+            if (!solveAll(progress))
+                return;
+            reportGlobalTime(iterationCount);
             for (size_type i = 0; i < solver.size(); ++i)
             {
-                if ((tmpStepCount = solver[i]->solve(numSteps[i])) == std::numeric_limits<size_type>::max())
-                {
-                    LOGGER_WRITE("Abort simulation at " + to_string(solver[i]->getCurrentTime()), Util::LC_SOLVER,
-                                 Util::LL_ERROR);
-                    return;
-                }
-                if (tmpStepCount < numSteps[i])
-                    --numSteps[i];
-                else
-                    ++numSteps[i];
-                //LOGGER_WRITE("(" + to_string(i) + ") numSteps: " + to_string(numSteps[i]), Util::LC_SOLVER, Util::LL_ERROR);
                 if (solver[i]->getCurrentTime() < getSimulationEndTime())
                     running = true;
                 else
                     LOGGER_WRITE("(" + to_string(i) + ") Stopping at " + to_string(solver[i]->getCurrentTime()),
                                  Util::LC_SOLVER, Util::LL_DEBUG);
             }
+            // all solvers are blocked by their inputs, sleep instead of polling the connections again
+            if (running && !progress)
+                dataManager->waitForInputs(notificationCount);
         }
+        waitForGlobalEnd();
         //e = omp_get_wtime();
         LOGGER_WRITE("thread 0 time: " + to_string(e - s), Util::LC_SOLVER, Util::LL_INFO);
     }
 
+    void SerialSimulation::simulateGaussSeidel()
+    {
+        bool running, progress;
+        size_type iterationCount = 0, notificationCount;
+        const auto& solver = getSolver();
+        Synchronization::IDataManager * dataManager = solver.front()->getDataManager();
+
+        real_type macroTime = solver.front()->getCurrentTime();
+        while (macroTime < getSimulationEndTime())
+        {
+            // the solvers stop exactly at the end of the macro step and send their outputs of this time
+            macroTime = std::min(macroTime + _macroStepSize, getSimulationEndTime());
+            LOGGER_WRITE("Macro step to " + to_string(macroTime), Util::LC_SOLVER, Util::LL_DEBUG);
+            for (auto & solv : solver)
+                solv->setEndTime(macroTime);
+
+            running = true;
+            while (running && getMaxIterations() > ++iterationCount)
+            {
+                running = false;
+                notificationCount = dataManager->getNotificationCount();
+                if (!solveAll(progress))
+                    return;
+                reportGlobalTime(iterationCount);
+                for (auto & solv : solver)
+                    running = running || !solv->isFinished();
+                // cyclic dependencies or inputs from other cores aren't available yet
+                if (running && !progress)
+                    dataManager->waitForInputs(notificationCount);
+            }
+        }
+        waitForGlobalEnd();
+    }
+
+    bool_type SerialSimulation::solveAll(bool & progress)
+    {
+        const auto& solver = getSolver();
+        size_type tmpStepCount;
+        progress = false;
+        for (const size_type i : _solveOrder)
+        {
+            if ((tmpStepCount = solver[i]->solve(getSolveQuantum(*solver[i]))) == std::numeric_limits<size_type>::max())
+            {
+                LOGGER_WRITE("Abort simulation at " + to_string(solver[i]->getCurrentTime()), Util::LC_SOLVER,
+                             Util::LL_ERROR);
+                return false;
+            }
+            if (tmpStepCount > 0)
+                progress = true;
+        }
+        return true;
+    }
+
+    void SerialSimulation::reportGlobalTime(const size_type & iterationCount)
+    {
+        if (iterationCount % _globalTimeInterval != 0)
+            return;
+        real_type minTime = std::numeric_limits<real_type>::max();
+        for (const auto & solv : getSolver())
+            minTime = std::min(minTime, solv->getCurrentTime());
+        _globalTime->update(_globalTimeId, minTime);
+    }
+
+    void SerialSimulation::waitForGlobalEnd()
+    {
+        // without other processes the global virtual time is known locally, nobody waits for this node
+        if (!Synchronization::GlobalVirtualTime::isDistributed())
+        {
+            _globalTime->update(_globalTimeId, getSimulationEndTime());
+            return;
+        }
+        while (_globalTime->update(_globalTimeId, getSimulationEndTime()) < getSimulationEndTime())
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        LOGGER_WRITE("All nodes reached the end time", Util::LC_SOLVER, Util::LL_DEBUG);
+    }
+
+    void SerialSimulation::createSolveOrder()
+    {
+        const auto& solver = getSolver();
+        map<string_type, size_type> fmuNameToSolver;
+        for (size_type i = 0; i < solver.size(); ++i)
+            fmuNameToSolver[solver[i]->getFmu()->getFmuName()] = i;
+
+        // edges from producer to consumer, only between solvers of this simulation
+        _consumers = vector<vector<size_type>>(solver.size());
+        vector<size_type> numProducers(solver.size(), 0);
+        for (size_type i = 0; i < solver.size(); ++i)
+        {
+            const FMI::AbstractFmu * fmu = solver[i]->getFmu();
+            for (const auto & con : fmu->getConnections())
+            {
+                auto it = fmuNameToSolver.find(con->getSourceFmu());
+                if (!con->isOutgoing(fmu->getFmuName()) && it != fmuNameToSolver.end())
+                {
+                    _consumers[it->second].push_back(i);
+                    ++numProducers[i];
+                }
+            }
+        }
+
+        // Kahn's algorithm. On a cycle, the remaining solver with the fewest unsolved producers (the first one in
+        // plan order on ties) is taken next, which breaks the cycle at this solver's inputs.
+        vector<bool_type> done(solver.size(), false);
+        _solveOrder.clear();
+        while (_solveOrder.size() < solver.size())
+        {
+            size_type next = solver.size();
+            for (size_type i = 0; i < solver.size(); ++i)
+            {
+                if (!done[i] && (next == solver.size() || numProducers[i] < numProducers[next]))
+                    next = i;
+                if (next == i && numProducers[i] == 0)
+                    break;
+            }
+            if (numProducers[next] > 0)
+            {
+                LOGGER_WRITE("Breaking dependency cycle at solver " + to_string(next), Util::LC_SOLVER, Util::LL_DEBUG);
+                // otherwise the solver would wait for its unsolved producers, which wait for it
+                const FMI::AbstractFmu * fmu = solver[next]->getFmu();
+                for (const auto & con : fmu->getConnections())
+                {
+                    auto it = fmuNameToSolver.find(con->getSourceFmu());
+                    if (!con->isOutgoing(fmu->getFmuName()) && it != fmuNameToSolver.end() && !done[it->second])
+                        solver[next]->getDataManager()->setDelayedInput(con->getLocalId());
+                }
+            }
+            done[next] = true;
+            _solveOrder.push_back(next);
+            for (const size_type consumer : _consumers[next])
+            {
+                if (numProducers[consumer] > 0)
+                    --numProducers[consumer];
+            }
+        }
+    }
+
+    size_type SerialSimulation::getSolveQuantum(const Solver::ISolver & solver) const
+    {
+        real_type horizon = solver.getInputHorizon();
+        if (std::isinf(horizon))
+            return _maxSolveQuantum;
+        real_type stepSize = (solver.getCurrentStepSize() > 0.0) ? solver.getCurrentStepSize() : solver.getStepSize();
+        real_type numSolverSteps = std::ceil((horizon - solver.getCurrentTime()) / stepSize);
+        if (numSolverSteps < 1.0)
+            return 1;
+        return static_cast<size_type>(std::min(numSolverSteps, static_cast<real_type>(_maxSolveQuantum)));
+    }
+
     string_type SerialSimulation::getSimulationType() const
     {
         return "serial";
     }
 
+    const vector<size_type> & SerialSimulation::getSolveOrder() const
+    {
+        return _solveOrder;
+    }
+
 }  // namespace Simulation
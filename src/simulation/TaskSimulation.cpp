@@ -0,0 +1,96 @@
+#include "simulation/TaskSimulation.hpp"
+
+namespace Simulation
+{
+
+    TaskSimulation::TaskSimulation(const Initialization::SimulationPlan & in,
+                                   const vector<shared_ptr<Solver::ISolver>> & solvers)
+            : SerialSimulation(in, solvers)
+    {
+    }
+
+    TaskSimulation::~TaskSimulation()
+    {
+    }
+
+    void TaskSimulation::simulate()
+    {
+        const auto& solver = getSolver();
+        Synchronization::IDataManager * dataManager = solver.front()->getDataManager();
+
+        deque<size_type> ready(_solveOrder.begin(), _solveOrder.end());
+        set<size_type> suspended;
+        size_type numFinished = 0, iterationCount = 0, tmpStepCount;
+        size_type notificationCount = dataManager->getNotificationCount();
+
+        while (numFinished < solver.size() && getMaxIterations() > ++iterationCount)
+        {
+            if (ready.empty())
+            {
+                // every unfinished solver is blocked, sleep till some connection of the node changed
+                dataManager->waitForInputs(notificationCount);
+                notificationCount = dataManager->getNotificationCount();
+                resumeSuspended(ready, suspended);
+            }
+
+            size_type i = ready.front();
+            ready.pop_front();
+            if ((tmpStepCount = solver[i]->solve(getSolveQuantum(*solver[i]))) == std::numeric_limits<size_type>::max())
+            {
+                LOGGER_WRITE("Abort simulation at " + to_string(solver[i]->getCurrentTime()), Util::LC_SOLVER,
+                             Util::LL_ERROR);
+                return;
+            }
+
+            reportGlobalTime(iterationCount);
+            if (tmpStepCount > 0)
+            {
+                // new outputs may unblock the consumers on this core
+                for (const size_type consumer : _consumers[i])
+                {
+                    if (suspended.erase(consumer) > 0)
+                        ready.push_back(consumer);
+                }
+            }
+
+            if (solver[i]->getCurrentTime() >= getSimulationEndTime())
+            {
+                LOGGER_WRITE("(" + to_string(i) + ") Stopping at " + to_string(solver[i]->getCurrentTime()),
+                             Util::LC_SOLVER, Util::LL_DEBUG);
+                ++numFinished;
+            }
+            else if (tmpStepCount > 0)
+                ready.push_back(i);
+            else
+                suspended.insert(i);
+        }
+        waitForGlobalEnd();
+    }
+
+    void TaskSimulation::resumeSuspended(deque<size_type> & ready, set<size_type> & suspended)
+    {
+        const auto& solver = getSolver();
+        Synchronization::IDataManager * dataManager = solver.front()->getDataManager();
+        for (auto it = suspended.begin(); it != suspended.end();)
+        {
+            if (dataManager->hasNewInputs(solver[*it]->getFmu()))
+            {
+                ready.push_back(*it);
+                it = suspended.erase(it);
+            }
+            else
+                ++it;
+        }
+        if (ready.empty())
+        {
+            ready.insert(ready.end(), suspended.begin(), suspended.end());
+            suspended.clear();
+        }
+    }
+
+    string_type TaskSimulation::getSimulationType() const
+    {
+        return "task";
+    }
+
+} /* namespace Simulation */
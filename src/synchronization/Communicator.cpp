@@ -3,9 +3,10 @@
 namespace Synchronization
 {
 
-    Communicator::Communicator()
+    Communicator::Communicator(const size_type & numIdleSpins, const real_type & maxIdleParkTime)
             : _numManagedCons(0),
-              _numManagedFmus(0)
+              _numManagedFmus(0),
+              _notifier(numIdleSpins, maxIdleParkTime)
     {
     }
 
@@ -16,13 +17,15 @@ namespace Synchronization
         for (auto & con : connList)
         {
             con->initialize(in->getFmuName());
+            con->setNotifier(&_notifier);
             size_type conId;
-            auto it = _knownConIds.find(con->getStartTag());
+            // both sides of a connection inside the node share one id
+            auto it = _knownConIds.find(con->getId());
             if (it == _knownConIds.end())
             {
                 valuePacking.push_back(con->getPacking());
                 conId = _numManagedCons++;
-                _knownConIds[con->getStartTag()] = conId;
+                _knownConIds[con->getId()] = conId;
                 ++numNewCons;
             }
             else
@@ -73,6 +76,12 @@ namespace Synchronization
         return static_cast<bool_type>(_connections[communicationId]->send(in));
     }
 
+    void Communicator::flush(const vector<size_type> & conIds)
+    {
+        for (const size_type conId : conIds)
+            _connections[conId]->flush();
+    }
+
     HistoryEntry Communicator::recv(size_type communicationId)
     {
         return _connections[communicationId]->recv();
@@ -113,5 +122,36 @@ namespace Synchronization
         return sum;
     }
 
+    size_type Communicator::getNotificationCount() const
+    {
+        return _notifier.getCount();
+    }
+
+    void Communicator::waitForInputs(const size_type & notificationCount, const vector<size_type> & conIds)
+    {
+        // Notifying connections wake the thread by the count. Entries, which already arrived on the others, didn't
+        // unblock the caller's solvers (e.g. the history is full), so only the connections without an entry are polled.
+        vector<size_type> pendingConIds;
+        for (const size_type & conId : conIds)
+        {
+            if (!_connections[conId]->notifies() && !_connections[conId]->pollReady())
+                pendingConIds.push_back(conId);
+        }
+        _notifier.wait(notificationCount, [this, &pendingConIds]()
+        {
+            return hasReadyConnection(pendingConIds);
+        });
+    }
+
+    bool_type Communicator::hasReadyConnection(const vector<size_type> & conIds)
+    {
+        for (const size_type & conId : conIds)
+        {
+            if (_connections[conId]->pollReady())
+                return true;
+        }
+        return false;
+    }
+
 } /* namespace Synchronization */
 
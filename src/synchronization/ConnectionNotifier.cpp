@@ -0,0 +1,49 @@
+#include "synchronization/ConnectionNotifier.hpp"
+
+namespace Synchronization
+{
+
+    ConnectionNotifier::ConnectionNotifier(const size_type & numSpins, const real_type & maxParkTime)
+            : _count(0),
+              _numParked(0),
+              _numSpins(numSpins),
+              _maxParkTime(std::max(static_cast<long long>(maxParkTime * 1.0e6), 1ll))
+    {
+    }
+
+    void ConnectionNotifier::notify()
+    {
+        ++_count;
+        // _count and _numParked are sequentially consistent, a thread parking concurrently sees the new count
+        if (_numParked.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cond.notify_all();
+        }
+    }
+
+    size_type ConnectionNotifier::getCount() const
+    {
+        return _count.load();
+    }
+
+    void ConnectionNotifier::wait(const size_type & lastCount, const function<bool_type()> & isReady)
+    {
+        for (size_type i = 0; i < _numSpins; ++i)
+        {
+            if (_count.load() != lastCount || isReady())
+                return;
+        }
+
+        std::chrono::microseconds parkTime(1);
+        std::unique_lock<std::mutex> lock(_mutex);
+        ++_numParked;
+        while (_count.load() == lastCount && !isReady())
+        {
+            _cond.wait_for(lock, parkTime);
+            parkTime = std::min(2 * parkTime, _maxParkTime);
+        }
+        --_numParked;
+    }
+
+} /* namespace Synchronization */
@@ -0,0 +1,123 @@
+#include "synchronization/DeltaEncoding.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace Synchronization
+{
+
+    DeltaEncoding::DeltaEncoding(const Initialization::ConnectionPlan & in)
+            : _numReals(in.inputMapping.size<real_type>()),
+              _numInts(in.inputMapping.size<int_type>()),
+              _numBools(in.inputMapping.size<bool_type>()),
+              _maskSize((_numReals + _numInts + _numBools + 7) / 8),
+              _deadbands(in.deadbands),
+              _lastValues(_numReals, _numInts, _numBools, 0ul),
+              _hasLastValues(false)
+    {
+        _deadbands.resize(_numReals, 0.0);
+    }
+
+    size_type DeltaEncoding::getMaxEntrySize() const
+    {
+        // header, bitmask and all values
+        return sizeof(real_type) + sizeof(size_type) + sizeof(bool_type) + _maskSize + _numReals * sizeof(real_type)
+                + _numInts * sizeof(int_type) + _numBools * sizeof(bool_type);
+    }
+
+    size_type DeltaEncoding::pack(const HistoryEntry & in, char * out)
+    {
+        const FMI::ValueCollection & vals = in.getValueCollection();
+        const bool_type sendAll = !_hasLastValues;
+        const real_type time = in.getTime();
+        const size_type order = in.getSolverOrder();
+        const bool_type event = in.hasEvent();
+        std::memcpy(out, &time, sizeof(real_type));
+        std::memcpy(out + sizeof(real_type), &order, sizeof(size_type));
+        std::memcpy(out + sizeof(real_type) + sizeof(size_type), &event, sizeof(bool_type));
+        char * mask = out + sizeof(real_type) + sizeof(size_type) + sizeof(bool_type);
+        std::memset(mask, 0, _maskSize);
+        char * pos = mask + _maskSize;
+        size_type bit = 0;
+
+        const vector<real_type> & reals = vals.getValues<real_type>();
+        vector<real_type> & lastReals = _lastValues.getValues<real_type>();
+        for (size_type i = 0; i < _numReals; ++i, ++bit)
+        {
+            // at events every change is sent, the negated comparison also sends NaNs
+            if (sendAll || (event ? reals[i] != lastReals[i] : !(std::abs(reals[i] - lastReals[i]) <= _deadbands[i])))
+            {
+                mask[bit / 8] |= static_cast<char>(1 << (bit % 8));
+                std::memcpy(pos, &reals[i], sizeof(real_type));
+                pos += sizeof(real_type);
+                lastReals[i] = reals[i];
+            }
+        }
+        const vector<int_type> & ints = vals.getValues<int_type>();
+        vector<int_type> & lastInts = _lastValues.getValues<int_type>();
+        for (size_type i = 0; i < _numInts; ++i, ++bit)
+        {
+            if (sendAll || ints[i] != lastInts[i])
+            {
+                mask[bit / 8] |= static_cast<char>(1 << (bit % 8));
+                std::memcpy(pos, &ints[i], sizeof(int_type));
+                pos += sizeof(int_type);
+                lastInts[i] = ints[i];
+            }
+        }
+        const vector<bool_type> & bools = vals.getValues<bool_type>();
+        vector<bool_type> & lastBools = _lastValues.getValues<bool_type>();
+        for (size_type i = 0; i < _numBools; ++i, ++bit)
+        {
+            if (sendAll || bools[i] != lastBools[i])
+            {
+                mask[bit / 8] |= static_cast<char>(1 << (bit % 8));
+                *pos++ = bools[i];
+                lastBools[i] = bools[i];
+            }
+        }
+        _hasLastValues = true;
+        return static_cast<size_type>(pos - out);
+    }
+
+    HistoryEntry DeltaEncoding::unpack(const char * in, size_type & numBytes)
+    {
+        real_type time;
+        size_type order;
+        bool_type event;
+        std::memcpy(&time, in, sizeof(real_type));
+        std::memcpy(&order, in + sizeof(real_type), sizeof(size_type));
+        std::memcpy(&event, in + sizeof(real_type) + sizeof(size_type), sizeof(bool_type));
+        const char * mask = in + sizeof(real_type) + sizeof(size_type) + sizeof(bool_type);
+        const char * pos = mask + _maskSize;
+        size_type bit = 0;
+
+        vector<real_type> & reals = _lastValues.getValues<real_type>();
+        for (size_type i = 0; i < _numReals; ++i, ++bit)
+        {
+            if (mask[bit / 8] & (1 << (bit % 8)))
+            {
+                std::memcpy(&reals[i], pos, sizeof(real_type));
+                pos += sizeof(real_type);
+            }
+        }
+        vector<int_type> & ints = _lastValues.getValues<int_type>();
+        for (size_type i = 0; i < _numInts; ++i, ++bit)
+        {
+            if (mask[bit / 8] & (1 << (bit % 8)))
+            {
+                std::memcpy(&ints[i], pos, sizeof(int_type));
+                pos += sizeof(int_type);
+            }
+        }
+        vector<bool_type> & bools = _lastValues.getValues<bool_type>();
+        for (size_type i = 0; i < _numBools; ++i, ++bit)
+        {
+            if (mask[bit / 8] & (1 << (bit % 8)))
+                bools[i] = *pos++;
+        }
+        numBytes = static_cast<size_type>(pos - in);
+        return HistoryEntry(time, order, _lastValues, event);
+    }
+
+} /* namespace Synchronization */
@@ -0,0 +1,96 @@
+#include "synchronization/GlobalVirtualTime.hpp"
+
+namespace Synchronization
+{
+
+    GlobalVirtualTime::GlobalVirtualTime(const real_type & startTime, const real_type & endTime)
+            : _time(startTime),
+              _startTime(startTime),
+              _endTime(endTime),
+              _loggedProgress(0)
+#ifdef USE_MPI
+              ,
+              _request(MPI_REQUEST_NULL),
+              _sendTime(startTime),
+              _reducedTime(startTime)
+#endif
+    {
+    }
+
+    size_type GlobalVirtualTime::addSimulation()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _localTimes.push_back(_startTime);
+        return _localTimes.size() - 1;
+    }
+
+    real_type GlobalVirtualTime::update(const size_type & id, const real_type & localTime)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _localTimes[id] = localTime;
+        real_type nodeTime = *std::min_element(_localTimes.begin(), _localTimes.end());
+#ifdef USE_MPI
+        if (isDistributed())
+        {
+            if (_request != MPI_REQUEST_NULL)
+            {
+                int done = 0;
+                MPI_Test(&_request, &done, MPI_STATUS_IGNORE);
+                if (done)
+                    setTime(_reducedTime);
+            }
+            // every process stops reducing after the same reduction, since all of them got the same result
+            if (_request == MPI_REQUEST_NULL && _time < _endTime)
+            {
+                _sendTime = nodeTime;
+                MPI_Iallreduce(&_sendTime, &_reducedTime, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD, &_request);
+            }
+            return _time;
+        }
+#endif
+        setTime(nodeTime);
+        return _time;
+    }
+
+    real_type GlobalVirtualTime::getTime()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _time;
+    }
+
+    bool_type GlobalVirtualTime::isFinished()
+    {
+        return getTime() >= _endTime;
+    }
+
+    bool_type GlobalVirtualTime::isDistributed()
+    {
+#ifdef USE_MPI
+        int initialized = 0, finalized = 0, size = 1;
+        MPI_Initialized(&initialized);
+        MPI_Finalized(&finalized);
+        if (initialized && !finalized)
+            MPI_Comm_size(MPI_COMM_WORLD, &size);
+        return size > 1;
+#else
+        return false;
+#endif
+    }
+
+    void GlobalVirtualTime::setTime(const real_type & time)
+    {
+        if (time <= _time)
+            return;
+        _time = time;
+        if (_endTime <= _startTime)
+            return;
+        int_type progress = static_cast<int_type>(10.0 * (std::min(_time, _endTime) - _startTime) / (_endTime - _startTime));
+        if (progress > _loggedProgress)
+        {
+            _loggedProgress = progress;
+            LOGGER_WRITE("Global virtual time " + to_string(_time) + " (" + to_string(10 * progress) + "%)",
+                         Util::LC_SOLVER, Util::LL_INFO);
+        }
+    }
+
+} /* namespace Synchronization */
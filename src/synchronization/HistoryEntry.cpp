@@ -14,7 +14,7 @@ namespace Synchronization
             : _time(time),
               _solverOrder(solverOrder),
               _hasEvent(event),
-              _element(vals)
+              _element(std::move(vals))
     {
     }
 
@@ -20,6 +20,7 @@ namespace Synchronization
               _intVals(nullptr),
               _bool_typeSize(in.getValueCollection().getValues<bool_type>().size()),
               _bool_typeVals(nullptr),
+              _stringVals(in.getValueCollection().getValues<string_type>()),
               _dataSize(
                       (_realSize + 1) * sizeof(real_type) + (_intSize + 1) * sizeof(int)
                               + (_bool_typeSize + 1) * sizeof(bool_type)),
@@ -31,13 +32,14 @@ namespace Synchronization
     HistoryEntryBuffer::operator HistoryEntry() const
     {
         HistoryEntry res(((real_type*) _data.get())[0], (getStartOfAdditionalIntValues()[0]),
-                         FMI::ValueCollection(_realSize, _intSize, _bool_typeSize, 0ul),
+                         FMI::ValueCollection(_realSize, _intSize, _bool_typeSize, _stringVals.size()),
                          getStartOfAdditionalBoolValues()[0]);
 
         copy(_realVals, _realVals + _realSize, res.getValueCollection().getValues<real_type>().begin());
         copy(_intVals, _intVals + _intSize, res.getValueCollection().getValues<int_type>().begin());
         for (size_type i = 0; i < _bool_typeSize; ++i)
-            res.getValueCollection().getValues<int_type>()[i] = _bool_typeVals[i];
+            res.getValueCollection().getValues<bool_type>()[i] = _bool_typeVals[i];
+        res.getValueCollection().getValues<string_type>() = _stringVals;
         return res;
     }
 
@@ -74,7 +76,7 @@ namespace Synchronization
         copy(in.getValueCollection().getValues<int_type>().begin(), in.getValueCollection().getValues<int_type>().end(),
              _intVals);
         for (size_type i = 0; i < _bool_typeSize; ++i)
-            _bool_typeVals[i] = in.getValueCollection().getValues<bool_type>()[i - 1];
+            _bool_typeVals[i] = in.getValueCollection().getValues<bool_type>()[i];
     }
 
     real_type * HistoryEntryBuffer::getStartOfValueCollection()
@@ -20,6 +20,15 @@ namespace Synchronization
         return _entries[_lastInsertedElem].getTime();
     }
 
+    size_type RingBufferSubHistory::getNumFreeEntries() const
+    {
+        if (_numAddedElems < _entries.size())
+            return _entries.size() - _numAddedElems;
+        // entries from _curIndex to the newest one and the one before _curIndex are used for interpolation
+        size_type numUsed = (_lastInsertedElem + _entries.size() - _curIndex) % _entries.size() + 2;
+        return (numUsed < _entries.size()) ? _entries.size() - numUsed : 0;
+    }
+
     FMI::ValueCollection RingBufferSubHistory::interpolate(const real_type & time)
     {
         while (_entries[_curIndex].getTime() < time)
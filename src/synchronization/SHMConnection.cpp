@@ -0,0 +1,89 @@
+#include "synchronization/SHMConnection.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Synchronization
+{
+
+    char * SHMConnection::_segment = nullptr;
+    size_type SHMConnection::_segmentSize = 0;
+
+    SHMConnection::SHMConnection(const Initialization::ConnectionPlan & in)
+            : SharedMemoryConnection(in)
+    {
+    }
+
+    SHMConnection::~SHMConnection()
+    {
+    }
+
+    void SHMConnection::createSegment(Initialization::ProgramPlan & plan)
+    {
+        if (_segment != nullptr)
+            return;
+
+        vector<size_type> offsets;
+        for (auto & nodePlans : plan.simPlans)
+        {
+            for (auto & simPlan : nodePlans)
+            {
+                for (auto & solverPlan : simPlan.dataManager.solvers)
+                {
+                    for (auto & conPlan : solverPlan->outConnections)
+                    {
+                        if (conPlan->kind == "openmp")
+                        {
+                            conPlan->kind = "shm";
+                            conPlan->shmOffset = _segmentSize;
+                            offsets.push_back(_segmentSize);
+                            _segmentSize += getRingSize(*conPlan);
+                        }
+                    }
+                }
+            }
+        }
+        if (_segmentSize == 0)
+            return;
+
+        string_type name = "/ParallelFmu_" + to_string(getpid());
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        if (fd < 0)
+            throw runtime_error("SHMConnection: Couldn't create shared memory " + name);
+        if (ftruncate(fd, _segmentSize) != 0)
+        {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw runtime_error("SHMConnection: Couldn't resize shared memory " + name);
+        }
+        void * segment = mmap(nullptr, _segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        // the mapping is inherited by the forked workers, the name isn't needed anymore
+        shm_unlink(name.c_str());
+        if (segment == MAP_FAILED)
+            throw runtime_error("SHMConnection: Couldn't map shared memory " + name);
+
+        _segment = static_cast<char*>(segment);
+        for (const size_type offset : offsets)
+            initializeRing(_segment + offset);
+    }
+
+    void SHMConnection::freeSegment()
+    {
+        if (_segment != nullptr)
+        {
+            munmap(_segment, _segmentSize);
+            _segment = nullptr;
+            _segmentSize = 0;
+        }
+    }
+
+    void SHMConnection::initialize(const std::string & /*fmuName*/)
+    {
+        if (_segment == nullptr)
+            throw runtime_error("SHMConnection: The shared memory segment wasn't created.");
+        setRing(_segment + _plan.shmOffset);
+    }
+
+} /* namespace Synchronization */
@@ -17,6 +17,7 @@ namespace Synchronization
             _buffer[_currentSendIndex] = in;
             _isFree[_currentSendIndex] = false;
             _currentSendIndex = nextSendIndex();
+            notify();
             return true;
         }
         else
@@ -36,6 +37,7 @@ namespace Synchronization
             //LOGGER_WRITE("Recv: " + to_string(*(_buffer[_currentReceiveIndex]->getValueCollection())),Util::LC_SOLVER, Util::LL_DEBUG);
             size_t tmp = _currentReceiveIndex;
             _currentReceiveIndex = nextReceiveIndex();
+            notify();
             return _buffer[tmp];
         }
         else
@@ -52,5 +54,10 @@ namespace Synchronization
 
     }
 
+    bool_type SerialConnection::pollReady()
+    {
+        return !_isFree[_currentReceiveIndex];
+    }
+
 } /* namespace Synchronization */
 
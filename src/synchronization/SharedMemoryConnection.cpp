@@ -0,0 +1,77 @@
+#include "synchronization/SharedMemoryConnection.hpp"
+
+namespace Synchronization
+{
+
+    SharedMemoryConnection::SharedMemoryConnection(const Initialization::ConnectionPlan & in)
+            : AbstractConnection(in),
+              _entrySize(_buffer.front().dataSize()),
+              _tail(nullptr),
+              _head(nullptr),
+              _slots(nullptr)
+    {
+    }
+
+    SharedMemoryConnection::~SharedMemoryConnection()
+    {
+    }
+
+    bool SharedMemoryConnection::send(const HistoryEntry & in)
+    {
+        std::uint64_t tail = _tail->load(std::memory_order_relaxed);
+        if (tail - _head->load(std::memory_order_acquire) >= _buffer.size())
+            return false;
+
+        size_type slotIndex = tail % _buffer.size();
+        _buffer[slotIndex] = in;
+        std::memcpy(_slots + slotIndex * _entrySize, _buffer[slotIndex].data(), _entrySize);
+        _tail->store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    HistoryEntry SharedMemoryConnection::recv()
+    {
+        std::uint64_t head = _head->load(std::memory_order_relaxed);
+        if (head == _tail->load(std::memory_order_acquire))
+            return HistoryEntry::invalid();
+
+        size_type slotIndex = head % _buffer.size();
+        std::memcpy(_buffer[slotIndex].data(), _slots + slotIndex * _entrySize, _entrySize);
+        HistoryEntry res = _buffer[slotIndex];
+        _head->store(head + 1, std::memory_order_release);
+        return res;
+    }
+
+    int_type SharedMemoryConnection::hasFreeBuffer()
+    {
+        std::uint64_t numUsed = _tail->load(std::memory_order_relaxed) - _head->load(std::memory_order_acquire);
+        return static_cast<int_type>(std::min<std::uint64_t>(_buffer.size() - numUsed, 2u));
+    }
+
+    bool_type SharedMemoryConnection::pollReady()
+    {
+        return _head->load(std::memory_order_relaxed) != _tail->load(std::memory_order_acquire);
+    }
+
+    size_type SharedMemoryConnection::getRingSize(const Initialization::ConnectionPlan & in)
+    {
+        size_type entrySize = HistoryEntryBuffer(HistoryEntry(in.inputMapping.getPackedValueCollection())).dataSize();
+        size_type res = _slotOffset + in.bufferSize * entrySize;
+        // the next ring starts on a new cache line
+        return ((res + _cacheLineSize - 1) / _cacheLineSize) * _cacheLineSize;
+    }
+
+    void SharedMemoryConnection::initializeRing(char * ring)
+    {
+        new (ring + _tailOffset) std::atomic<std::uint64_t>(0);
+        new (ring + _headOffset) std::atomic<std::uint64_t>(0);
+    }
+
+    void SharedMemoryConnection::setRing(char * ring)
+    {
+        _tail = reinterpret_cast<std::atomic<std::uint64_t>*>(ring + _tailOffset);
+        _head = reinterpret_cast<std::atomic<std::uint64_t>*>(ring + _headOffset);
+        _slots = ring + _slotOffset;
+    }
+
+} /* namespace Synchronization */
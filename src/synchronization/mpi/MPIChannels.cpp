@@ -0,0 +1,66 @@
+#include "synchronization/mpi/MPIChannels.hpp"
+
+namespace Synchronization
+{
+
+    vector<MPI_Comm> MPIChannels::_comms;
+    size_type MPIChannels::_numTags = 0;
+
+    void MPIChannels::create(Initialization::ProgramPlan & plan)
+    {
+        if (!_comms.empty())
+            return;
+
+        // the tags of a rank pair are shared by both directions, since MPIRMAConnection sends its handshake backwards
+        map<tuple<size_type, size_type>, size_type> numTagsOfRanks;
+        size_type maxTag = 0;
+        for (auto & nodePlans : plan.simPlans)
+        {
+            for (auto & simPlan : nodePlans)
+            {
+                for (auto & solverPlan : simPlan.dataManager.solvers)
+                {
+                    for (auto & conPlan : solverPlan->outConnections)
+                    {
+                        if (conPlan->kind == "mpi" || conPlan->kind == "mpirma")
+                        {
+                            size_type & numTags = numTagsOfRanks[make_tuple(
+                                    std::min(conPlan->sourceRank, conPlan->destRank),
+                                    std::max(conPlan->sourceRank, conPlan->destRank))];
+                            conPlan->startTag = numTags++;
+                            maxTag = std::max(maxTag, conPlan->startTag);
+                        }
+                    }
+                }
+            }
+        }
+
+        int_type * tagUb = nullptr, flag = 0;
+        MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &tagUb, &flag);
+        // 32767 is the minimal upper bound guaranteed by the standard
+        _numTags = static_cast<size_type>(flag != 0 ? *tagUb : 32767) + 1;
+        _comms.resize(maxTag / _numTags + 1);
+        for (MPI_Comm & comm : _comms)
+            MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+    }
+
+    void MPIChannels::free()
+    {
+        for (MPI_Comm & comm : _comms)
+            MPI_Comm_free(&comm);
+        _comms.clear();
+    }
+
+    MPI_Comm MPIChannels::getComm(const size_type & startTag)
+    {
+        if (_comms.empty())
+            throw runtime_error("MPIChannels: The communicators weren't created.");
+        return _comms[startTag / _numTags];
+    }
+
+    int_type MPIChannels::getTag(const size_type & startTag)
+    {
+        return static_cast<int_type>(startTag % _numTags);
+    }
+
+} /* namespace Synchronization */
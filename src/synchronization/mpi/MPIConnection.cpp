@@ -5,97 +5,245 @@ namespace Synchronization
 
     MPIConnection::MPIConnection(const Initialization::ConnectionPlan & in)
             : AbstractConnection(in),
-              _isFree(vector<MPI_Request>(in.bufferSize)),
-              _numOpenConns(1u)
+              _isFree(vector<MPI_Request>(in.bufferSize, MPI_REQUEST_NULL)),
+              _isPersistent(false),
+              _fullSends(vector<MPI_Request>(in.bufferSize, MPI_REQUEST_NULL)),
+              _comm(MPIChannels::getComm(in.startTag)),
+              _tag(MPIChannels::getTag(in.startTag)),
+              _numReals(0),
+              _numInts(0),
+              _numBools(0),
+              _realOffset(0),
+              _intOffset(0),
+              _orderOffset(0),
+              _boolOffset(0),
+              _eventOffset(0),
+              _entrySize(0),
+              _entryType(MPI_DATATYPE_NULL),
+              _isDelta(in.encoding == "delta"),
+              _delta(in),
+              _batchSize(1),
+              _numPacked(0),
+              _numPackedBytes(0),
+              _numReceived(0),
+              _numUnpacked(0)
     {
-
+        createEntryType();
+        if (_isDelta)
+            _entrySize = _delta.getMaxEntrySize();
+        _batchSize = std::max(1u, std::min(in.batchSize, in.maxBatchBytes / _entrySize));
+        _batches = vector<vector<char>>(in.bufferSize, vector<char>(_batchSize * _entrySize));
     }
 
     MPIConnection::~MPIConnection()
     {
         //TODO close all connections, complicated. Needs a ping-ping between target - source
+        int_type finalized = 0;
+        MPI_Finalized(&finalized);
+        if (finalized == 0)
+        {
+            // active requests are deallocated as soon as they complete
+            if (_isPersistent)
+            {
+                for (MPI_Request & req : _isFree)
+                    MPI_Request_free(&req);
+            }
+            for (MPI_Request & req : _fullSends)
+            {
+                if (req != MPI_REQUEST_NULL)
+                    MPI_Request_free(&req);
+            }
+            MPI_Type_free(&_entryType);
+        }
     }
 
     void MPIConnection::initialize(const std::string & fmuName)
     {
         if (!isOutgoing(fmuName))
         {
-            for (size_type i = 0; i < _numOpenConns; ++i)
+            for (size_type i = 0; i < _isFree.size(); ++i)
             {
-                //  // Call recv, so the corresponding MPI_Isends aren't blocked
-                MPI_Irecv(_buffer[i].data(), _buffer[i].dataSize(), MPI_BYTE, _plan.sourceRank, getStartTag() + i, MPI_COMM_WORLD, &_isFree[i]);
+                if (_isDelta)
+                    MPI_Recv_init(_batches[i].data(), _batches[i].size(), MPI_BYTE, _plan.sourceRank, _tag, _comm,
+                                  &_isFree[i]);
+                else
+                    MPI_Recv_init(_batches[i].data(), _batchSize, _entryType, _plan.sourceRank, _tag, _comm,
+                                  &_isFree[i]);
+            }
+            _isPersistent = true;
+            // post all slots, so the corresponding MPI_Isends aren't blocked
+            MPI_Startall(_isFree.size(), _isFree.data());
+        }
+        else if (!_isDelta)
+        {
+            // delta encoded messages vary in size, they are always sent by flush()
+            for (size_type i = 0; i < _fullSends.size(); ++i)
+            {
+                MPI_Send_init(_batches[i].data(), _batchSize, _entryType, _plan.destRank, _tag, _comm, &_fullSends[i]);
             }
         }
     }
 
     bool MPIConnection::send(const HistoryEntry & in)
     {
-        //is free?
-        int_type tmpBool = 0;
-        if (_buffer[_currentSendIndex].isFree())
-            tmpBool = 1;
-        else
-            MPI_Test(&_isFree[_currentSendIndex], &tmpBool, MPI_STATUS_IGNORE);
-        //yes:
-        if (tmpBool > 0)
+        // a new message needs a slot, whose last message was sent completely
+        if (_numPacked == 0 && !isCompleted(_currentSendIndex))
+            return false;
+
+        if (_isDelta)
         {
-            _buffer[_currentSendIndex] = in;  // todo fast copy
-            MPI_Isend(_buffer[_currentSendIndex].data(), _buffer[_currentSendIndex].dataSize(), MPI_BYTE, _plan.destRank, getStartTag() + _currentSendIndex,
-            MPI_COMM_WORLD,
-                      &_isFree[_currentSendIndex]);
-            _currentSendIndex = nextSendIndex();
+            _numPackedBytes += _delta.pack(in, _batches[_currentSendIndex].data() + _numPackedBytes);
+            if (++_numPacked == _batchSize)
+                flush();
             return true;
         }
-        //no:
-        return false;
+        packEntry(in, _batches[_currentSendIndex].data() + _numPacked * _entrySize);
+        if (++_numPacked == _batchSize)
+        {
+            MPI_Start(&_fullSends[_currentSendIndex]);
+            _currentSendIndex = nextSendIndex();
+            _numPacked = 0;
+        }
+        return true;
     }
 
-    HistoryEntry MPIConnection::recv()
+    void MPIConnection::flush()
     {
-        int_type tmpBool = 0;
+        if (_numPacked > 0)
+        {
+            if (_isDelta)
+                MPI_Isend(_batches[_currentSendIndex].data(), _numPackedBytes, MPI_BYTE, _plan.destRank, _tag, _comm,
+                          &_isFree[_currentSendIndex]);
+            else
+                MPI_Isend(_batches[_currentSendIndex].data(), _numPacked, _entryType, _plan.destRank, _tag, _comm,
+                          &_isFree[_currentSendIndex]);
+            _currentSendIndex = nextSendIndex();
+            _numPacked = 0;
+            _numPackedBytes = 0;
+        }
+    }
 
-        MPI_Test(&_isFree[_currentReceiveIndex], &tmpBool, MPI_STATUS_IGNORE);
-        if (tmpBool > 0)
+    HistoryEntry MPIConnection::recv()
+    {
+        if (_numUnpacked < _numReceived || testReceive())
         {
-            HistoryEntry res = _buffer[_currentReceiveIndex];  // todo real copy
-            _currentReceiveIndex = nextReceiveIndex();
-            MPI_Irecv(_buffer[_currentReceiveIndex].data(), _buffer[_currentReceiveIndex].dataSize(), MPI_BYTE, _plan.sourceRank, getStartTag() + _currentReceiveIndex,
-            MPI_COMM_WORLD,
-                      &_isFree[_currentReceiveIndex]);  //keep listening for the next communication on this buffer
+            const char * message = _batches[_currentReceiveIndex].data();
+            size_type numBytes;
+            HistoryEntry res =
+                    _isDelta ? _delta.unpack(message + _numUnpacked, numBytes) :
+                               unpackEntry(message + _numUnpacked * _entrySize);
+            _numUnpacked += _isDelta ? numBytes : 1;
+            if (_numUnpacked >= _numReceived)
+            {
+                _numReceived = _numUnpacked = 0;
+                MPI_Start(&_isFree[_currentReceiveIndex]);  //keep listening for the next communication on this buffer
+                _currentReceiveIndex = nextReceiveIndex();
+            }
             return res;
         }
 
         return HistoryEntry::invalid();
     }
 
-    int_type MPIConnection::hasFreeBuffer()
+    bool_type MPIConnection::pollReady()
+    {
+        return _numUnpacked < _numReceived || testReceive();
+    }
+
+    bool_type MPIConnection::testReceive()
     {
-        int_type res = 0, tmpBool = 0;
-        if (_buffer[_currentSendIndex].isFree())
+        // a completed request is inactive and loses its status, so the entry count is stored at once
+        if (_numReceived > 0)
+            return true;
+        int_type tmpBool = 0, numEntries = 0;
+        MPI_Status status;
+        MPI_Test(&_isFree[_currentReceiveIndex], &tmpBool, &status);
+        if (tmpBool > 0)
         {
-            if (_buffer[nextSendIndex()].isFree())
-                res = 2;
-            else
-                res = 1;
+            MPI_Get_count(&status, _isDelta ? MPI_BYTE : _entryType, &numEntries);
+            _numReceived = static_cast<size_type>(std::max(numEntries, 0));
         }
-        else
-        {
-            MPI_Test(&_isFree[_currentSendIndex], &tmpBool, MPI_STATUS_IGNORE);
-            if (tmpBool > 0)
-            {
-                if (_buffer[nextSendIndex()].isFree())
-                    res = 2;
+        return _numReceived > 0;
+    }
 
-                else
-                {
-                    MPI_Test(&_isFree[nextSendIndex()], &tmpBool, MPI_STATUS_IGNORE);
-                    if (tmpBool > 0)
-                        res = 2;
-                    else
-                        res = 1;
-                }
-            }
-        }
+    bool_type MPIConnection::isCompleted(const size_type & index)
+    {
+        // null and inactive persistent requests complete immediately
+        int_type partialDone = 0, fullDone = 0;
+        MPI_Test(&_isFree[index], &partialDone, MPI_STATUS_IGNORE);
+        MPI_Test(&_fullSends[index], &fullDone, MPI_STATUS_IGNORE);
+        return partialDone > 0 && fullDone > 0;
+    }
+
+    int_type MPIConnection::hasFreeBuffer()
+    {
+        // number of entries, which can be sent at least, limited to 2
+        size_type res = 0;
+        if (_numPacked > 0)
+            res = _batchSize - _numPacked;
+        else if (isCompleted(_currentSendIndex))
+            res = _batchSize;
+        if (res == 1 && _batches.size() > 1 && isCompleted(nextSendIndex()))
+            res = 2;
+        return static_cast<int_type>(std::min(res, 2u));
+    }
+
+    void MPIConnection::createEntryType()
+    {
+        const FMI::ValueCollection vals = _plan.inputMapping.getPackedValueCollection();
+        _numReals = vals.getValues<real_type>().size();
+        _numInts = vals.getValues<int_type>().size();
+        _numBools = vals.getValues<bool_type>().size();
+
+        // ordered by alignment, so no padding is needed inside an entry
+        _realOffset = sizeof(real_type);
+        _intOffset = _realOffset + _numReals * sizeof(real_type);
+        _orderOffset = _intOffset + _numInts * sizeof(int_type);
+        _boolOffset = _orderOffset + sizeof(size_type);
+        _eventOffset = _boolOffset + _numBools * sizeof(bool_type);
+        _entrySize = ((_eventOffset + sizeof(bool_type) + sizeof(real_type) - 1) / sizeof(real_type))
+                * sizeof(real_type);
+
+        int_type blockLengths[] = { 1, static_cast<int_type>(_numReals), static_cast<int_type>(_numInts), 1,
+                static_cast<int_type>(_numBools), 1 };
+        MPI_Aint displacements[] = { 0, static_cast<MPI_Aint>(_realOffset), static_cast<MPI_Aint>(_intOffset),
+                static_cast<MPI_Aint>(_orderOffset), static_cast<MPI_Aint>(_boolOffset),
+                static_cast<MPI_Aint>(_eventOffset) };
+        MPI_Datatype types[] = { MPI_DOUBLE, MPI_DOUBLE, MPI_INT, MPI_UINT32_T, MPI_CHAR, MPI_CHAR };
+        MPI_Datatype structType;
+        MPI_Type_create_struct(6, blockLengths, displacements, types, &structType);
+        // consecutive entries of a message are _entrySize bytes apart
+        MPI_Type_create_resized(structType, 0, _entrySize, &_entryType);
+        MPI_Type_free(&structType);
+        MPI_Type_commit(&_entryType);
+    }
+
+    void MPIConnection::packEntry(const HistoryEntry & in, char * out) const
+    {
+        const FMI::ValueCollection & vals = in.getValueCollection();
+        *reinterpret_cast<real_type*>(out) = in.getTime();
+        std::copy(vals.getValues<real_type>().begin(), vals.getValues<real_type>().end(),
+                  reinterpret_cast<real_type*>(out + _realOffset));
+        std::copy(vals.getValues<int_type>().begin(), vals.getValues<int_type>().end(),
+                  reinterpret_cast<int_type*>(out + _intOffset));
+        *reinterpret_cast<size_type*>(out + _orderOffset) = in.getSolverOrder();
+        std::copy(vals.getValues<bool_type>().begin(), vals.getValues<bool_type>().end(),
+                  reinterpret_cast<bool_type*>(out + _boolOffset));
+        *reinterpret_cast<bool_type*>(out + _eventOffset) = in.hasEvent();
+    }
+
+    HistoryEntry MPIConnection::unpackEntry(const char * in) const
+    {
+        HistoryEntry res(*reinterpret_cast<const real_type*>(in), *reinterpret_cast<const size_type*>(in + _orderOffset),
+                         FMI::ValueCollection(_numReals, _numInts, _numBools, 0ul),
+                         *reinterpret_cast<const bool_type*>(in + _eventOffset));
+        FMI::ValueCollection & vals = res.getValueCollection();
+        const real_type * reals = reinterpret_cast<const real_type*>(in + _realOffset);
+        std::copy(reals, reals + _numReals, vals.getValues<real_type>().begin());
+        const int_type * ints = reinterpret_cast<const int_type*>(in + _intOffset);
+        std::copy(ints, ints + _numInts, vals.getValues<int_type>().begin());
+        const bool_type * bools = reinterpret_cast<const bool_type*>(in + _boolOffset);
+        std::copy(bools, bools + _numBools, vals.getValues<bool_type>().begin());
         return res;
     }
 
@@ -0,0 +1,156 @@
+#include "synchronization/mpi/MPIRMAConnection.hpp"
+
+namespace Synchronization
+{
+
+    MPI_Win MPIRMAConnection::_window = MPI_WIN_NULL;
+
+    MPIRMAConnection::MPIRMAConnection(const Initialization::ConnectionPlan & in)
+            : AbstractConnection(in),
+              _entrySize(_buffer.front().dataSize()),
+              _ring(nullptr),
+              _ringAddress(0),
+              _addressRequest(MPI_REQUEST_NULL),
+              _hasRingAddress(false),
+              _numSent(0),
+              _remoteHead(0),
+              _numReceived(0)
+    {
+    }
+
+    MPIRMAConnection::~MPIRMAConnection()
+    {
+        int_type finalized = 0;
+        MPI_Finalized(&finalized);
+        if (_ring != nullptr && finalized == 0)
+        {
+            if (_window != MPI_WIN_NULL)
+                MPI_Win_detach(_window, _ring);
+            MPI_Free_mem(_ring);
+        }
+    }
+
+    void MPIRMAConnection::createWindow()
+    {
+        if (_window == MPI_WIN_NULL)
+        {
+            MPI_Win_create_dynamic(MPI_INFO_NULL, MPI_COMM_WORLD, &_window);
+            // one passive target epoch to all ranks for the whole simulation
+            MPI_Win_lock_all(MPI_MODE_NOCHECK, _window);
+        }
+    }
+
+    void MPIRMAConnection::freeWindow()
+    {
+        if (_window != MPI_WIN_NULL)
+        {
+            MPI_Win_unlock_all(_window);
+            MPI_Win_free(&_window);
+        }
+    }
+
+    void MPIRMAConnection::initialize(const std::string & fmuName)
+    {
+        if (_window == MPI_WIN_NULL)
+            throw runtime_error("MPIRMAConnection: The window wasn't created.");
+
+        if (isOutgoing(fmuName))
+        {
+            MPI_Irecv(&_ringAddress, 1, MPI_AINT, _plan.destRank, MPIChannels::getTag(getStartTag()),
+                      MPIChannels::getComm(getStartTag()), &_addressRequest);
+        }
+        else
+        {
+            MPI_Aint ringSize = _slotOffset + _buffer.size() * _entrySize;
+            MPI_Alloc_mem(ringSize, MPI_INFO_NULL, &_ring);
+            std::fill(_ring, _ring + ringSize, 0);
+            MPI_Win_attach(_window, _ring, ringSize);
+            MPI_Get_address(_ring, &_ringAddress);
+            MPI_Isend(&_ringAddress, 1, MPI_AINT, _plan.sourceRank, MPIChannels::getTag(getStartTag()),
+                      MPIChannels::getComm(getStartTag()), &_addressRequest);
+            // _ringAddress stays valid, so the send completes in the background
+            MPI_Request_free(&_addressRequest);
+        }
+    }
+
+    bool MPIRMAConnection::send(const HistoryEntry & in)
+    {
+        if (!testRingAddress() || getNumFreeSlots() == 0)
+            return false;
+
+        HistoryEntryBuffer & slot = _buffer[_numSent % _buffer.size()];
+        slot = in;
+        MPI_Put(slot.data(), _entrySize, MPI_BYTE, _plan.destRank,
+                _ringAddress + _slotOffset + (_numSent % _buffer.size()) * _entrySize, _entrySize, MPI_BYTE, _window);
+        // the entry has to be complete in the ring, before the tail is advanced
+        MPI_Win_flush(_plan.destRank, _window);
+        std::uint64_t one = 1;
+        MPI_Accumulate(&one, 1, MPI_UINT64_T, _plan.destRank, _ringAddress + _tailOffset, 1, MPI_UINT64_T, MPI_SUM,
+                       _window);
+        MPI_Win_flush(_plan.destRank, _window);
+        ++_numSent;
+        return true;
+    }
+
+    HistoryEntry MPIRMAConnection::recv()
+    {
+        if (!pollReady())
+            return HistoryEntry::invalid();
+
+        size_type slotIndex = _numReceived % _buffer.size();
+        std::memcpy(_buffer[slotIndex].data(), _ring + _slotOffset + slotIndex * _entrySize, _entrySize);
+        HistoryEntry res = _buffer[slotIndex];
+        ++_numReceived;
+        // publish the freed slot to the source
+        MPI_Accumulate(&_numReceived, 1, MPI_UINT64_T, _plan.destRank, _ringAddress + _headOffset, 1, MPI_UINT64_T,
+                       MPI_REPLACE, _window);
+        MPI_Win_flush(_plan.destRank, _window);
+        return res;
+    }
+
+    bool_type MPIRMAConnection::pollReady()
+    {
+        return _numReceived < fetchTail();
+    }
+
+    int_type MPIRMAConnection::hasFreeBuffer()
+    {
+        if (!testRingAddress())
+            return 0;
+        return static_cast<int_type>(std::min(getNumFreeSlots(), 2u));
+    }
+
+    bool_type MPIRMAConnection::testRingAddress()
+    {
+        if (!_hasRingAddress)
+        {
+            int_type tmpBool = 0;
+            MPI_Test(&_addressRequest, &tmpBool, MPI_STATUS_IGNORE);
+            _hasRingAddress = tmpBool > 0;
+        }
+        return _hasRingAddress;
+    }
+
+    size_type MPIRMAConnection::getNumFreeSlots()
+    {
+        if (_numSent - _remoteHead >= _buffer.size())
+        {
+            MPI_Fetch_and_op(nullptr, &_remoteHead, MPI_UINT64_T, _plan.destRank, _ringAddress + _headOffset, MPI_NO_OP,
+                             _window);
+            MPI_Win_flush(_plan.destRank, _window);
+        }
+        return static_cast<size_type>(_buffer.size() - (_numSent - _remoteHead));
+    }
+
+    std::uint64_t MPIRMAConnection::fetchTail()
+    {
+        // atomic read of the local tail, which is advanced by the source
+        std::uint64_t res = 0;
+        MPI_Fetch_and_op(nullptr, &res, MPI_UINT64_T, _plan.destRank, _ringAddress + _tailOffset, MPI_NO_OP, _window);
+        MPI_Win_flush(_plan.destRank, _window);
+        // make the entries put by the source visible in the local memory
+        MPI_Win_sync(_window);
+        return res;
+    }
+
+} /* namespace Synchronization */
@@ -0,0 +1,105 @@
+#include "synchronization/mpi/MPISHMConnection.hpp"
+
+namespace Synchronization
+{
+
+    MPI_Win MPISHMConnection::_window = MPI_WIN_NULL;
+    MPI_Comm MPISHMConnection::_nodeComm = MPI_COMM_NULL;
+
+    MPISHMConnection::MPISHMConnection(const Initialization::ConnectionPlan & in)
+            : SharedMemoryConnection(in)
+    {
+    }
+
+    MPISHMConnection::~MPISHMConnection()
+    {
+    }
+
+    void MPISHMConnection::createWindow(Initialization::ProgramPlan & plan, const int & rank)
+    {
+        if (_window != MPI_WIN_NULL)
+            return;
+
+        int_type numRanks = 1, nodeId = rank;
+        MPI_Comm_size(MPI_COMM_WORLD, &numRanks);
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &_nodeComm);
+        // the lowest rank of a node identifies the node
+        MPI_Allreduce(&rank, &nodeId, 1, MPI_INT, MPI_MIN, _nodeComm);
+        vector<int_type> nodeOfRank(numRanks);
+        MPI_Allgather(&nodeId, 1, MPI_INT, nodeOfRank.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+        // every rank traverses the same plan, so all agree on the kinds and offsets
+        vector<size_type> segmentSizes(numRanks, 0);
+        vector<size_type> localOffsets;
+        for (auto & nodePlans : plan.simPlans)
+        {
+            for (auto & simPlan : nodePlans)
+            {
+                for (auto & solverPlan : simPlan.dataManager.solvers)
+                {
+                    for (auto & conPlan : solverPlan->outConnections)
+                    {
+                        if ((conPlan->kind == "mpi" || conPlan->kind == "mpirma")
+                                && nodeOfRank[conPlan->sourceRank] == nodeOfRank[conPlan->destRank]
+                                && conPlan->sharedMemory)
+                        {
+                            // the rings pass every entry in full, the configured MPI connection is kept
+                            if (conPlan->kind == "mpi" && (conPlan->batchSize > 1 || conPlan->encoding == "delta"))
+                            {
+                                if (rank == 0)
+                                    LOGGER_WRITE("MPISHMConnection: Connection " + conPlan->sourceFmu + " -> "
+                                                 + conPlan->destFmu + " uses batching or delta encoding and stays a "
+                                                 "mpi connection on one node.",
+                                                 Util::LC_LOADER, Util::LL_WARNING);
+                                continue;
+                            }
+                            conPlan->kind = "mpishm";
+                            conPlan->shmOffset = segmentSizes[conPlan->destRank];
+                            segmentSizes[conPlan->destRank] += getRingSize(*conPlan);
+                            if (static_cast<int_type>(conPlan->destRank) == rank)
+                                localOffsets.push_back(conPlan->shmOffset);
+                        }
+                    }
+                }
+            }
+        }
+
+        char * segment = nullptr;
+        MPI_Win_allocate_shared(segmentSizes[rank], 1, MPI_INFO_NULL, _nodeComm, &segment, &_window);
+        for (const size_type offset : localOffsets)
+            initializeRing(segment + offset);
+        // the rings are initialized, before a source can use them
+        MPI_Barrier(_nodeComm);
+    }
+
+    void MPISHMConnection::freeWindow()
+    {
+        if (_window != MPI_WIN_NULL)
+        {
+            MPI_Win_free(&_window);
+            MPI_Comm_free(&_nodeComm);
+        }
+    }
+
+    void MPISHMConnection::initialize(const std::string & /*fmuName*/)
+    {
+        if (_window == MPI_WIN_NULL)
+            throw runtime_error("MPISHMConnection: The window wasn't created.");
+
+        int_type worldRank = _plan.destRank, nodeRank = MPI_UNDEFINED, dispUnit = 1;
+        MPI_Group worldGroup, nodeGroup;
+        MPI_Comm_group(MPI_COMM_WORLD, &worldGroup);
+        MPI_Comm_group(_nodeComm, &nodeGroup);
+        MPI_Group_translate_ranks(worldGroup, 1, &worldRank, nodeGroup, &nodeRank);
+        MPI_Group_free(&worldGroup);
+        MPI_Group_free(&nodeGroup);
+        if (nodeRank == MPI_UNDEFINED)
+            throw runtime_error("MPISHMConnection: The destination rank isn't on this node.");
+
+        MPI_Aint segmentSize = 0;
+        char * segment = nullptr;
+        MPI_Win_shared_query(_window, nodeRank, &segmentSize, &dispUnit, &segment);
+        setRing(segment + _plan.shmOffset);
+    }
+
+} /* namespace Synchronization */
@@ -30,6 +30,8 @@ namespace Synchronization
             }
             omp_unset_lock(&_writersLock);
         }
+        if (res)
+            notify();
         return res;
     }
 
@@ -47,6 +49,8 @@ namespace Synchronization
             }
             omp_unset_lock(&_writersLock);
         }
+        if (res.isValid())
+            notify();  // a send buffer became free
         return res;
     }
 
@@ -67,4 +71,13 @@ namespace Synchronization
         return res;
     }
 
+    bool_type OpenMPConnection::pollReady()
+    {
+        // the lock is only held for a copy, a contended lock doesn't tell anything about the buffer
+        omp_set_lock(&_writersLock);
+        bool_type res = !_buffer[_currentReceiveIndex].isFree();
+        omp_unset_lock(&_writersLock);
+        return res;
+    }
+
 } /* namespace Synchronization */
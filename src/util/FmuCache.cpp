@@ -0,0 +1,228 @@
+/*
+ * FmuCache.cpp
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+#include <zlib.h>
+
+#include "util/FmuCache.hpp"
+#include "util/Logger.hpp"
+
+namespace Util
+{
+    namespace
+    {
+        const std::uint32_t centralDirectorySignature = 0x02014b50;
+        const std::uint32_t localHeaderSignature = 0x04034b50;
+        const std::uint32_t endOfCentralDirectorySignature = 0x06054b50;
+
+        // zip archives are little endian
+        std::uint32_t read16(const std::vector<char> & zip, const std::size_t & pos)
+        {
+            if (pos + 2 > zip.size())
+                throw std::runtime_error("FmuCache: Truncated zip archive.");
+            return static_cast<std::uint32_t>(static_cast<unsigned char>(zip[pos]))
+                    | static_cast<std::uint32_t>(static_cast<unsigned char>(zip[pos + 1])) << 8;
+        }
+
+        std::uint32_t read32(const std::vector<char> & zip, const std::size_t & pos)
+        {
+            return read16(zip, pos) | read16(zip, pos + 2) << 16;
+        }
+
+        bool isTemporary(const std::string & name)
+        {
+            return name.find(".tmp-") != std::string::npos || name.find(".evict-") != std::string::npos;
+        }
+    }
+
+    std::string FmuCache::extract(const std::string & fmuPath, const std::string & cachePath)
+    {
+        namespace fs = boost::filesystem;
+        std::ifstream file(fmuPath, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("FmuCache: Couldn't read " + fmuPath);
+        std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        std::ostringstream key;
+        key << std::hex << std::setw(16) << std::setfill('0') << hash(data) << std::dec << "-" << data.size();
+        fs::path root = fs::absolute((cachePath.empty()) ? getDefaultPath() : cachePath);
+        fs::path dir = root / key.str();
+        boost::system::error_code ec;
+        if (!fs::is_directory(dir))
+        {
+            fs::create_directories(root);
+            fs::path tmp = dir;
+            tmp += ".tmp-" + fs::unique_path().string();
+            unzip(data, tmp.string());
+            // fails, if another process populated the directory in the meantime
+            fs::rename(tmp, dir, ec);
+            if (ec)
+            {
+                fs::remove_all(tmp, ec);
+                if (!fs::is_directory(dir))
+                    throw std::runtime_error("FmuCache: Couldn't populate " + dir.string());
+            }
+            else
+            {
+                LOGGER_WRITE("Extracted " + fmuPath + " to " + dir.string(), Util::LC_LOADER, Util::LL_DEBUG);
+                evict(root.string(), dir.string());
+            }
+        }
+        // the modification time marks the last use for the eviction
+        fs::last_write_time(dir, std::time(nullptr), ec);
+        return dir.string() + "/";
+    }
+
+    std::string FmuCache::getDefaultPath()
+    {
+        return (boost::filesystem::temp_directory_path() / "parallelfmu-fmus").string();
+    }
+
+    std::uint64_t FmuCache::hash(const std::vector<char> & data)
+    {
+        std::uint64_t res = 14695981039346656037ull;
+        for (const char c : data)
+        {
+            res ^= static_cast<unsigned char>(c);
+            res *= 1099511628211ull;
+        }
+        return res;
+    }
+
+    void FmuCache::unzip(const std::vector<char> & zip, const std::string & outPath)
+    {
+        namespace fs = boost::filesystem;
+        // the end of central directory record is followed by a comment of at most 65535 bytes
+        if (zip.size() < 22)
+            throw std::runtime_error("FmuCache: The FMU isn't a zip archive.");
+        std::size_t eocd = zip.size() - 22, first = (eocd > 65535) ? eocd - 65535 : 0;
+        while (read32(zip, eocd) != endOfCentralDirectorySignature)
+        {
+            if (eocd == first)
+                throw std::runtime_error("FmuCache: The FMU isn't a zip archive.");
+            --eocd;
+        }
+
+        fs::create_directories(outPath);
+        const std::uint32_t numEntries = read16(zip, eocd + 10);
+        std::size_t pos = read32(zip, eocd + 16);
+        std::vector<char> content;
+        for (std::uint32_t i = 0; i < numEntries; ++i)
+        {
+            if (read32(zip, pos) != centralDirectorySignature)
+                throw std::runtime_error("FmuCache: Corrupt central directory.");
+            const std::uint32_t madeBy = read16(zip, pos + 4), method = read16(zip, pos + 10), crc = read32(zip, pos + 16),
+                    compressedSize = read32(zip, pos + 20), size = read32(zip, pos + 24), nameLength = read16(zip, pos + 28),
+                    mode = read32(zip, pos + 38) >> 16, localOffset = read32(zip, pos + 42);
+            if (pos + 46 + nameLength > zip.size())
+                throw std::runtime_error("FmuCache: Truncated zip archive.");
+            const std::string name(zip.data() + pos + 46, nameLength);
+            pos += 46 + nameLength + read16(zip, pos + 30) + read16(zip, pos + 32);
+
+            if (compressedSize == 0xffffffff || size == 0xffffffff || localOffset == 0xffffffff)
+                throw std::runtime_error("FmuCache: Zip64 archives aren't supported.");
+            const fs::path relative(name);
+            if (name.empty() || relative.is_absolute()
+                    || std::find(relative.begin(), relative.end(), fs::path("..")) != relative.end())
+                throw std::runtime_error("FmuCache: Invalid file name " + name + " in zip archive.");
+
+            const fs::path target = fs::path(outPath) / relative;
+            if (name.back() == '/')
+            {
+                fs::create_directories(target);
+                continue;
+            }
+            fs::create_directories(target.parent_path());
+
+            if (read32(zip, localOffset) != localHeaderSignature)
+                throw std::runtime_error("FmuCache: Corrupt local header of " + name);
+            const std::size_t start = localOffset + 30 + read16(zip, localOffset + 26) + read16(zip, localOffset + 28);
+            if (start + compressedSize > zip.size())
+                throw std::runtime_error("FmuCache: Truncated zip archive.");
+
+            content.resize(size);
+            if (method == 0 && compressedSize == size)
+            {
+                std::copy(zip.begin() + start, zip.begin() + start + size, content.begin());
+            }
+            else if (method == 8)
+            {
+                z_stream stream = z_stream();
+                // negative window bits: raw deflate data without zlib header
+                if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+                    throw std::runtime_error("FmuCache: Couldn't initialize zlib.");
+                stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(zip.data() + start));
+                stream.avail_in = compressedSize;
+                stream.next_out = reinterpret_cast<Bytef *>(content.data());
+                stream.avail_out = size;
+                int status = inflate(&stream, Z_FINISH);
+                inflateEnd(&stream);
+                if (status != Z_STREAM_END || stream.total_out != size)
+                    throw std::runtime_error("FmuCache: Couldn't inflate " + name);
+            }
+            else
+                throw std::runtime_error("FmuCache: Unsupported compression method of " + name);
+
+            if (crc32(0, reinterpret_cast<const Bytef *>(content.data()), size) != crc)
+                throw std::runtime_error("FmuCache: CRC mismatch of " + name);
+            std::ofstream out(target.string(), std::ios::binary);
+            out.write(content.data(), size);
+            if (!out)
+                throw std::runtime_error("FmuCache: Couldn't write " + target.string());
+            out.close();
+            // keep the permissions of archives created on unix
+            if ((madeBy >> 8) == 3 && (mode & 0777) != 0)
+                fs::permissions(target, static_cast<fs::perms>(mode & 0777));
+        }
+    }
+
+    void FmuCache::evict(const std::string & cachePath, const std::string & keep)
+    {
+        namespace fs = boost::filesystem;
+        boost::system::error_code ec;
+        const std::time_t now = std::time(nullptr);
+        std::vector<std::pair<std::time_t, fs::path>> entries;
+        for (fs::directory_iterator it(cachePath, ec); !ec && it != fs::directory_iterator(); it.increment(ec))
+        {
+            const fs::path & path = it->path();
+            const std::time_t lastUse = fs::last_write_time(path, ec);
+            if (ec || !fs::is_directory(path) || path.string() == keep)
+                continue;
+            if (isTemporary(path.filename().string()))
+            {
+                // left over by a crashed process
+                if (now - lastUse > minUnusedTime)
+                    fs::remove_all(path, ec);
+            }
+            else
+                entries.push_back(std::make_pair(lastUse, path));
+        }
+        if (entries.size() + 1 <= maxEntries)
+            return;
+
+        std::sort(entries.begin(), entries.end());
+        std::size_t numEvict = entries.size() + 1 - maxEntries;
+        for (std::size_t i = 0; i < numEvict && now - entries[i].first > minUnusedTime; ++i)
+        {
+            // renamed first, so no process finds a partially removed FMU
+            fs::path victim = entries[i].second;
+            victim += ".evict-" + fs::unique_path().string();
+            fs::rename(entries[i].second, victim, ec);
+            if (!ec)
+            {
+                fs::remove_all(victim, ec);
+                LOGGER_WRITE("Evicted " + entries[i].second.string() + " from the FMU cache", Util::LC_LOADER,
+                             Util::LL_DEBUG);
+            }
+        }
+    }
+
+}
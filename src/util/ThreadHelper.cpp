@@ -0,0 +1,40 @@
+/*
+ * ThreadHelper.cpp
+ */
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "Stdafx.hpp"
+#include "util/ThreadHelper.hpp"
+
+namespace Util
+{
+    bool ThreadHelper::pinCurrentThread(const int & cpuId)
+    {
+        if (cpuId < 0)
+            return false;
+#ifdef __linux__
+        if (cpuId >= CPU_SETSIZE)
+        {
+            LOGGER_WRITE("ThreadHelper: CPU " + to_string(cpuId) + " is out of range.", Util::LC_SYS, Util::LL_WARNING);
+            return false;
+        }
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpuId, &cpuSet);
+        // pid 0 refers to the calling thread
+        if (sched_setaffinity(0, sizeof(cpu_set_t), &cpuSet) != 0)
+        {
+            LOGGER_WRITE("ThreadHelper: Couldn't pin thread to CPU " + to_string(cpuId) + ".", Util::LC_SYS,
+                         Util::LL_WARNING);
+            return false;
+        }
+        return true;
+#else
+        LOGGER_WRITE("ThreadHelper: Thread pinning isn't supported on this system.", Util::LC_SYS, Util::LL_WARNING);
+        return false;
+#endif
+    }
+}
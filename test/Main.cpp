@@ -1,20 +1,32 @@
 #include <gtest/gtest.h>
 
 
-#include "TestSerial.hpp"
+#include "TestNative.hpp"
+#include "TestPlanSerializer.hpp"
+#include "TestDeltaEncoding.hpp"
+#include "TestFmuStatePool.hpp"
+#include "TestFmuCache.hpp"
+#include "TestModelDescriptionCache.hpp"
+#include "TestRos2.hpp"
+#include "TestSharedMemoryConnection.hpp"
+#include "TestCoupling.hpp"
+#ifdef USE_TEST_FMUS
+    #include "TestSerial.hpp"
+#endif
 //#ifdef USE_FMILIB
 //    #include "TestFmuFMI.hpp"
 //#endif
+#if defined USE_FMILIB && defined USE_TEST_FMUS
+    #include "TestFmi2.hpp"
+#endif
 
-#ifdef USE_OPENMP
+#if defined USE_OPENMP && defined USE_TEST_FMUS
     #include "TestOpenMP.hpp"
 #endif
 //#include "TestMPI.hpp"
 //#include "TestFmuSdk.hpp"
 
-/*#include "TestXmlReader.hpp"
-#include "TestRos2.hpp"
-*/
+//#include "TestXmlReader.hpp"
 //#include "TestBouncing1000_openmp.hpp"
 //#include "TestBouncing1000.hpp"
 
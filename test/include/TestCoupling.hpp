@@ -0,0 +1,154 @@
+/*
+ * TestCoupling.hpp
+ */
+
+#ifndef TEST_INCLUDE_TESTCOUPLING_HPP_
+#define TEST_INCLUDE_TESTCOUPLING_HPP_
+
+#include "TestCommon.hpp"
+#include "fmi/NativeModel.hpp"
+#include "simulation/SerialSimulation.hpp"
+
+/**
+ * Outputs the time, y = x = t.
+ */
+class ClockModel : public FMI::NativeModel
+{
+ public:
+    ClockModel()
+            : FMI::NativeModel(1, 0)
+    {
+        // x, y
+        _reals.resize(2, 0.0);
+    }
+
+    void describe(FMI::FmuTypeInfo & info) const override
+    {
+        info.modelIdentifier = "clock";
+        info.defaultStartTime = 0.0;
+        info.defaultStopTime = 1.0;
+        info.numberOfStates = _numStates;
+        info.numberOfEventIndicators = _numEventIndicators;
+        addVariable<real_type>(info, "x", 0, _reals[0], true);
+        addVariable<real_type>(info, "y", 1, _reals[1], true, VarCausality::varCausalityOutput);
+    }
+
+    void getDerivatives(real_type * derivatives) const override
+    {
+        derivatives[0] = 1.0;
+    }
+
+    void getEventIndicators(real_type * /*eventIndicators*/) const override
+    {
+    }
+
+    bool_type eventUpdate() override
+    {
+        return false;
+    }
+
+    void computeOutputs() override
+    {
+        _reals[1] = _time;
+    }
+};
+
+class Coupling : public TestCommon
+{
+ public:
+    Coupling(const std::string & configFile)
+            : TestCommon(configFile)
+    {
+    }
+
+    vector<size_type> getSolveOrder()
+    {
+        _simulation->initialize();
+        auto simulation = std::dynamic_pointer_cast<Simulation::SerialSimulation>(_simulation);
+        if (!simulation)
+            throw runtime_error("Coupling: The simulation isn't serial.");
+        return simulation->getSolveOrder();
+    }
+
+    void simulate()
+    {
+        _simulation->simulate();
+        for (const auto & solv : _simulation->getSolver())
+            ASSERT_EQ(1.0, solv->getCurrentTime()) << solv->getFmu()->getFmuName();
+    }
+
+    FMI::AbstractFmu * getFmu(const string_type & name) const
+    {
+        for (const auto & solv : _simulation->getSolver())
+            if (solv->getFmu()->getFmuName() == name)
+                return solv->getFmu();
+        throw runtime_error("Coupling: Unknown FMU " + name);
+    }
+};
+
+/**
+ * First -> Middle -> Last, listed in reverse order.
+ */
+class CouplingChain : public Coupling
+{
+ public:
+    CouplingChain()
+            : Coupling("./test/data/TestConfig_Native_chain.xml")
+    {
+    }
+};
+
+/**
+ * First <-> Second -> Consumer.
+ */
+class CouplingCycle : public Coupling
+{
+ public:
+    CouplingCycle()
+            : Coupling("./test/data/TestConfig_Native_cycle.xml")
+    {
+    }
+};
+
+/**
+ * Clock -> Consumer, listed in reverse order and coupled in macro steps of 0.1.
+ */
+class CouplingGaussSeidel : public Coupling
+{
+ public:
+    CouplingGaussSeidel()
+            : Coupling("./test/data/TestConfig_Native_gaussSeidel.xml")
+    {
+        FMI::NativeModel::registerModel("clock", [](const map<string_type, real_type> &)
+        {   return new ClockModel();});
+    }
+};
+
+TEST_F (CouplingChain, TestProducersFirst)
+{
+    EXPECT_EQ(vector<size_type>( {2, 1, 0}), getSolveOrder());
+    simulate();
+}
+
+TEST_F (CouplingCycle, TestCycleIsBroken)
+{
+    // the cycle is broken at the first solver, the consumer of the cycle follows it
+    EXPECT_EQ(vector<size_type>( {0, 1, 2}), getSolveOrder());
+    simulate();
+}
+
+TEST_F (CouplingGaussSeidel, TestConsumerUsesCurrentMacroStep)
+{
+    EXPECT_EQ(vector<size_type>( {1, 0}), getSolveOrder());
+    simulate();
+
+    // u is the clock, so the consumer follows x' = -(x - 1 - t), x(0) = 1, i.e. x = t + e^-t. With the clock of the
+    // previous macro step, u would lag by 0.1 and x by about 0.06.
+    FMI::AbstractFmu * consumer = getFmu("Consumer"), *clock = getFmu("Clock");
+    FMI::ValueCollection consumerValues = consumer->getValues(FMI::ReferenceContainerType::ALL);
+    EXPECT_EQ(clock->getValues(FMI::ReferenceContainerType::ALL).getValues<real_type>()[1],
+              consumerValues.getValues<real_type>()[1]);
+    EXPECT_NEAR(1.0 + std::exp(-1.0), consumer->getStates()[0], 0.01);
+}
+
+#endif /* TEST_INCLUDE_TESTCOUPLING_HPP_ */
@@ -0,0 +1,143 @@
+/*
+ * TestDeltaEncoding.hpp
+ */
+
+#ifndef TEST_INCLUDE_TESTDELTAENCODING_HPP_
+#define TEST_INCLUDE_TESTDELTAENCODING_HPP_
+
+#include <gtest/gtest.h>
+
+#include "initialization/DefaultValues.hpp"
+#include "synchronization/DeltaEncoding.hpp"
+
+class DeltaEncodingTest : public ::testing::Test
+{
+ public:
+    Initialization::ConnectionPlan _plan;
+
+    /**
+     * Two reals (deadbands 0.1 and 0), one integer and one bool.
+     */
+    DeltaEncodingTest()
+            : _plan(Initialization::DefaultValues::connectionPlan())
+    {
+        _plan.encoding = "delta";
+        _plan.inputMapping = FMI::InputMapping( { make_tuple(0, 0), make_tuple(1, 1)}, { make_tuple(0, 0)},
+                                               { make_tuple(0, 0)});
+        _plan.deadbands = {0.1, 0.0};
+    }
+
+    static Synchronization::HistoryEntry createEntry(const real_type & time, const real_type & r0, const real_type & r1,
+                                                     const int_type & i0, const bool_type & b0,
+                                                     const bool_type & event = false)
+    {
+        return Synchronization::HistoryEntry(time, 1, FMI::ValueCollection( {r0, r1}, {i0}, {b0}, {}), event);
+    }
+
+    /// Size of an encoded entry with the given number of changed values of every type.
+    static size_type entrySize(const size_type & numReals, const size_type & numInts, const size_type & numBools)
+    {
+        return sizeof(real_type) + sizeof(size_type) + sizeof(bool_type) + 1 + numReals * sizeof(real_type)
+                + numInts * sizeof(int_type) + numBools * sizeof(bool_type);
+    }
+
+    static void expectValues(const Synchronization::HistoryEntry & entry, const real_type & r0, const real_type & r1,
+                             const int_type & i0, const bool_type & b0)
+    {
+        const FMI::ValueCollection & vals = entry.getValueCollection();
+        EXPECT_EQ(r0, vals.getValues<real_type>()[0]);
+        EXPECT_EQ(r1, vals.getValues<real_type>()[1]);
+        EXPECT_EQ(i0, vals.getValues<int_type>()[0]);
+        EXPECT_EQ(b0, vals.getValues<bool_type>()[0]);
+    }
+};
+
+TEST_F (DeltaEncodingTest, FirstEntryIsSentInFull)
+{
+    Synchronization::DeltaEncoding source(_plan), dest(_plan);
+    vector<char> buffer(source.getMaxEntrySize());
+
+    // all values equal the zero initialized last values, but nothing was sent yet
+    size_type numBytes = source.pack(createEntry(0.5, 0.0, 0.0, 0, 0), buffer.data());
+    EXPECT_EQ(entrySize(2, 1, 1), numBytes);
+    EXPECT_EQ(source.getMaxEntrySize(), numBytes);
+
+    size_type numRead = 0;
+    Synchronization::HistoryEntry res = dest.unpack(buffer.data(), numRead);
+    EXPECT_EQ(numBytes, numRead);
+    EXPECT_EQ(0.5, res.getTime());
+    EXPECT_EQ(1u, res.getSolverOrder());
+    EXPECT_FALSE(res.hasEvent());
+    expectValues(res, 0.0, 0.0, 0, 0);
+}
+
+TEST_F (DeltaEncodingTest, DeadbandSuppressesSmallChanges)
+{
+    Synchronization::DeltaEncoding source(_plan), dest(_plan);
+    vector<char> buffer(source.getMaxEntrySize());
+    size_type numRead;
+    source.pack(createEntry(0.0, 1.0, 1.0, 3, 1), buffer.data());
+    dest.unpack(buffer.data(), numRead);
+
+    // r0 changes within its deadband, r1 (deadband 0) and the integer change, the bool doesn't
+    EXPECT_EQ(entrySize(1, 1, 0), source.pack(createEntry(0.1, 1.05, 1.01, 4, 1), buffer.data()));
+    Synchronization::HistoryEntry res = dest.unpack(buffer.data(), numRead);
+    EXPECT_EQ(entrySize(1, 1, 0), numRead);
+    EXPECT_EQ(0.1, res.getTime());
+    expectValues(res, 1.0, 1.01, 4, 1);
+
+    // the deadband is measured from the value last sent, not from the previous entry
+    EXPECT_EQ(entrySize(1, 0, 1), source.pack(createEntry(0.2, 1.15, 1.01, 4, 0), buffer.data()));
+    res = dest.unpack(buffer.data(), numRead);
+    expectValues(res, 1.15, 1.01, 4, 0);
+
+    // nothing changed, only the header and the empty mask
+    EXPECT_EQ(entrySize(0, 0, 0), source.pack(createEntry(0.3, 1.15, 1.01, 4, 0), buffer.data()));
+    res = dest.unpack(buffer.data(), numRead);
+    EXPECT_EQ(0.3, res.getTime());
+    expectValues(res, 1.15, 1.01, 4, 0);
+}
+
+TEST_F (DeltaEncodingTest, EventsSendEveryChange)
+{
+    Synchronization::DeltaEncoding source(_plan), dest(_plan);
+    vector<char> buffer(source.getMaxEntrySize());
+    size_type numRead;
+    source.pack(createEntry(0.0, 1.0, 1.0, 3, 1), buffer.data());
+    dest.unpack(buffer.data(), numRead);
+
+    // within the deadband, but at an event
+    EXPECT_EQ(entrySize(1, 0, 0), source.pack(createEntry(0.1, 1.05, 1.0, 3, 1, true), buffer.data()));
+    Synchronization::HistoryEntry res = dest.unpack(buffer.data(), numRead);
+    EXPECT_TRUE(res.hasEvent());
+    expectValues(res, 1.05, 1.0, 3, 1);
+
+    // NaNs are always sent
+    EXPECT_EQ(entrySize(1, 0, 0), source.pack(createEntry(0.2, 1.05, std::nan(""), 3, 1), buffer.data()));
+    res = dest.unpack(buffer.data(), numRead);
+    EXPECT_TRUE(std::isnan(res.getValueCollection().getValues<real_type>()[1]));
+}
+
+TEST_F (DeltaEncodingTest, EntriesOfOneMessage)
+{
+    Synchronization::DeltaEncoding source(_plan), dest(_plan);
+    vector<char> message(3 * source.getMaxEntrySize());
+    size_type numPacked = 0;
+    numPacked += source.pack(createEntry(0.0, 1.0, 2.0, 3, 0), message.data() + numPacked);
+    numPacked += source.pack(createEntry(0.1, 1.5, 2.0, 3, 1), message.data() + numPacked);
+    numPacked += source.pack(createEntry(0.2, 1.5, 2.5, 4, 1), message.data() + numPacked);
+    EXPECT_EQ(entrySize(2, 1, 1) + entrySize(1, 0, 1) + entrySize(1, 1, 0), numPacked);
+
+    size_type numUnpacked = 0, numBytes;
+    expectValues(dest.unpack(message.data() + numUnpacked, numBytes), 1.0, 2.0, 3, 0);
+    numUnpacked += numBytes;
+    expectValues(dest.unpack(message.data() + numUnpacked, numBytes), 1.5, 2.0, 3, 1);
+    numUnpacked += numBytes;
+    Synchronization::HistoryEntry res = dest.unpack(message.data() + numUnpacked, numBytes);
+    numUnpacked += numBytes;
+    EXPECT_EQ(0.2, res.getTime());
+    expectValues(res, 1.5, 2.5, 4, 1);
+    EXPECT_EQ(numPacked, numUnpacked);
+}
+
+#endif /* TEST_INCLUDE_TESTDELTAENCODING_HPP_ */
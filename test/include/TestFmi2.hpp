@@ -0,0 +1,123 @@
+/*
+ * TestFmi2.hpp
+ */
+
+#ifndef TEST_INCLUDE_TESTFMI2_HPP_
+#define TEST_INCLUDE_TESTFMI2_HPP_
+
+#include "TestCommon.hpp"
+
+/**
+ * The bouncing ball falls from h=1 and hits the ground at t=sqrt(2/9.81)=0.4515 with v=-4.43. It bounces back with
+ * v=3.10, so at t=0.8 it is at h=3.10*0.3485-9.81/2*0.3485^2=0.485.
+ */
+class Fmi2ModelExchange : public TestCommon
+{
+ public:
+    Fmi2ModelExchange()
+            : TestCommon("./test/data/TestConfig_Fmi2_me.xml")
+    {
+    }
+
+    ~Fmi2ModelExchange()
+    {
+    }
+};
+
+class Fmi2CoSimulation : public TestCommon
+{
+ public:
+    Fmi2CoSimulation()
+            : TestCommon("./test/data/TestConfig_Fmi2_cs.xml")
+    {
+    }
+
+    ~Fmi2CoSimulation()
+    {
+    }
+
+    static real_type getReal(const FMI::AbstractFmu & fmu, const string_type & name)
+    {
+        size_type ref = fmu.getValueInfo().getReference<real_type>(name);
+        const vector<size_type> & refs = fmu.getAllValueReferences().getValues<real_type>();
+        FMI::ValueCollection values(refs.size(), 0, 0, 0);
+        fmu.getAllValues(values);
+        for (size_type i = 0; i < refs.size(); ++i)
+            if (refs[i] == ref)
+                return values.getValues<real_type>()[i];
+        throw runtime_error("Fmi2CoSimulation: Unknown variable " + name);
+    }
+};
+
+TEST_F (Fmi2ModelExchange, TestInitialization)
+{
+    ASSERT_EQ(_simulation->getSolver().size(), 1);
+    FMI::AbstractFmu* fmu = _simulation->getSolver().back()->getFmu();
+    ASSERT_FALSE(fmu->isCoSimulation());
+    ASSERT_EQ(0.0, fmu->getTime());
+    ASSERT_EQ(2, fmu->getNumStates());
+    vector<real_type> states(fmu->getNumStates());
+    fmu->getStates(states.data());
+    ASSERT_DOUBLE_EQ(1.0, states[0]);
+}
+
+TEST_F (Fmi2ModelExchange, TestJacobian)
+{
+    FMI::AbstractFmu* fmu = _simulation->getSolver().back()->getFmu();
+    ASSERT_EQ(2, fmu->getNumStates());
+    // der(h) = v, der(v) = -g while flying
+    vector<real_type> jacobian(4, -1.0);
+    fmu->getJacobian(jacobian.data());
+    EXPECT_NEAR(0.0, jacobian[0], 1.0e-6);
+    EXPECT_NEAR(0.0, jacobian[1], 1.0e-6);
+    EXPECT_NEAR(1.0, jacobian[2], 1.0e-6);
+    EXPECT_NEAR(0.0, jacobian[3], 1.0e-6);
+    const vector<vector<size_type>> & pattern = fmu->getJacobianPattern();
+    if (!pattern.empty())
+    {
+        ASSERT_EQ(2, pattern.size());
+        ASSERT_EQ(vector<size_type>(1, 1), pattern[0]);
+    }
+}
+
+TEST_F (Fmi2ModelExchange, TestEventHandling)
+{
+    _simulation->initialize();
+    _simulation->simulate();
+    Solver::ISolver & solver = *_simulation->getSolver().back();
+    ASSERT_EQ(0.8, solver.getCurrentTime());
+    ASSERT_GT(solver.getEventCounter(), 0);
+    vector<real_type> states(solver.getFmu()->getNumStates());
+    solver.getFmu()->getStates(states.data());
+    EXPECT_NEAR(0.485, states[0], 0.01);
+}
+
+TEST_F (Fmi2ModelExchange, TestSaveAndRestoreState)
+{
+    FMI::AbstractFmu* fmu = _simulation->getSolver().back()->getFmu();
+    size_type snapshot = fmu->saveState();
+    vector<real_type> states(fmu->getNumStates());
+    fmu->getStates(states.data());
+    _simulation->initialize();
+    _simulation->simulate();
+    fmu->restoreState(snapshot);
+    vector<real_type> restored(fmu->getNumStates());
+    fmu->getStates(restored.data());
+    EXPECT_EQ(0.0, fmu->getTime());
+    EXPECT_EQ(states, restored);
+    fmu->releaseState(snapshot);
+}
+
+TEST_F (Fmi2CoSimulation, TestCommunicationSteps)
+{
+    FMI::AbstractFmu* fmu = _simulation->getSolver().back()->getFmu();
+    ASSERT_TRUE(fmu->isCoSimulation());
+    EXPECT_DOUBLE_EQ(1.0, getReal(*fmu, "h"));
+    _simulation->initialize();
+    _simulation->simulate();
+    ASSERT_EQ(0.8, _simulation->getSolver().back()->getCurrentTime());
+    // the internal solver of the FMU isn't as accurate as the model exchange test
+    EXPECT_NEAR(0.485, getReal(*fmu, "h"), 0.05);
+}
+
+#endif /* TEST_INCLUDE_TESTFMI2_HPP_ */
@@ -0,0 +1,198 @@
+/*
+ * TestFmuCache.hpp
+ */
+
+#ifndef TEST_INCLUDE_TESTFMUCACHE_HPP_
+#define TEST_INCLUDE_TESTFMUCACHE_HPP_
+
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "util/FmuCache.hpp"
+
+class FmuCacheTest : public ::testing::Test
+{
+ public:
+    boost::filesystem::path _dir;
+    boost::filesystem::path _cache;
+
+    FmuCacheTest()
+            : _dir(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("fmucachetest-%%%%-%%%%")),
+              _cache(_dir / "cache")
+    {
+        boost::filesystem::create_directories(_dir);
+    }
+
+    ~FmuCacheTest()
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove_all(_dir, ec);
+    }
+
+    /**
+     * Writes a zip archive with the entries (name, content). Names ending with a slash are directories. The contents
+     * are deflated, if deflate is true, and stored otherwise.
+     */
+    std::string writeZip(const std::string & name, const std::vector<std::pair<std::string, std::string>> & entries,
+                         const bool deflate)
+    {
+        std::string res, centralDirectory;
+        for (const auto & entry : entries)
+        {
+            const std::string & content = entry.second;
+            std::string data = (deflate) ? compress(content) : content;
+            const std::uint32_t crc = crc32(0, reinterpret_cast<const Bytef *>(content.data()), content.size());
+            const std::uint32_t offset = res.size();
+            std::string header;
+            append(header, 20, 2);  // version needed
+            append(header, 0, 2);  // flags
+            append(header, (deflate) ? 8 : 0, 2);
+            append(header, 0, 4);  // time and date
+            append(header, crc, 4);
+            append(header, data.size(), 4);
+            append(header, content.size(), 4);
+            append(header, entry.first.size(), 2);
+            append(header, 0, 2);  // extra field
+
+            append(res, 0x04034b50, 4);
+            res += header + entry.first + data;
+
+            append(centralDirectory, 0x02014b50, 4);
+            append(centralDirectory, 0x031e, 2);  // made by unix
+            centralDirectory += header;
+            append(centralDirectory, 0, 2);  // comment
+            append(centralDirectory, 0, 4);  // disk and internal attributes
+            append(centralDirectory, 0644u << 16, 4);
+            append(centralDirectory, offset, 4);
+            centralDirectory += entry.first;
+        }
+        const std::uint32_t centralDirectoryOffset = res.size();
+        res += centralDirectory;
+        append(res, 0x06054b50, 4);
+        append(res, 0, 4);  // disks
+        append(res, entries.size(), 2);
+        append(res, entries.size(), 2);
+        append(res, centralDirectory.size(), 4);
+        append(res, centralDirectoryOffset, 4);
+        append(res, 0, 2);  // comment
+
+        const std::string path = (_dir / name).string();
+        std::ofstream(path, std::ios::binary) << res;
+        return path;
+    }
+
+    static std::string readFile(const std::string & path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    /**
+     * Creates a directory in the cache, which looks like an extracted FMU last used age seconds ago.
+     */
+    boost::filesystem::path addEntry(const std::string & name, const std::time_t & age)
+    {
+        boost::filesystem::path res = _cache / name;
+        boost::filesystem::create_directories(res);
+        boost::filesystem::last_write_time(res, std::time(nullptr) - age);
+        return res;
+    }
+
+ private:
+    static void append(std::string & out, const std::uint32_t & value, const std::size_t & numBytes)
+    {
+        for (std::size_t i = 0; i < numBytes; ++i)
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+
+    static std::string compress(const std::string & in)
+    {
+        z_stream stream = z_stream();
+        // raw deflate data like in zip archives
+        deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+        std::string res(deflateBound(&stream, in.size()), '\0');
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in.data()));
+        stream.avail_in = in.size();
+        stream.next_out = reinterpret_cast<Bytef *>(&res[0]);
+        stream.avail_out = res.size();
+        deflate(&stream, Z_FINISH);
+        res.resize(stream.total_out);
+        deflateEnd(&stream);
+        return res;
+    }
+};
+
+TEST_F (FmuCacheTest, ExtractsStoredAndDeflatedEntries)
+{
+    const std::string description = "<fmiModelDescription modelName=\"Test\"/>";
+    const std::string binary(10000, 'x');
+    const std::vector<std::pair<std::string, std::string>> entries = {
+        { "binaries/", "" }, { "binaries/linux64/test.so", binary }, { "modelDescription.xml", description } };
+
+    for (bool deflate : { false, true })
+    {
+        std::string fmu = writeZip((deflate) ? "deflated.fmu" : "stored.fmu", entries, deflate);
+        if (deflate)
+        {
+            ASSERT_LT(boost::filesystem::file_size(fmu), binary.size());
+        }
+        std::string dir = Util::FmuCache::extract(fmu, _cache.string());
+        ASSERT_EQ('/', dir.back());
+        EXPECT_TRUE(boost::filesystem::is_directory(dir + "binaries/linux64"));
+        EXPECT_EQ(binary, readFile(dir + "binaries/linux64/test.so"));
+        EXPECT_EQ(description, readFile(dir + "modelDescription.xml"));
+        EXPECT_EQ(boost::filesystem::perms(0644),
+                  boost::filesystem::status(dir + "modelDescription.xml").permissions() & 0777);
+    }
+}
+
+TEST_F (FmuCacheTest, RepeatedHitIsNotExtractedAgain)
+{
+    std::string fmu = writeZip("test.fmu", { { "modelDescription.xml", "first" } }, true);
+    std::string dir = Util::FmuCache::extract(fmu, _cache.string());
+    boost::filesystem::remove(dir + "modelDescription.xml");
+    boost::filesystem::last_write_time(dir, std::time(nullptr) - 2 * Util::FmuCache::minUnusedTime);
+
+    // the directory of the same FMU is reused as it is and marked as used
+    EXPECT_EQ(dir, Util::FmuCache::extract(fmu, _cache.string()));
+    EXPECT_FALSE(boost::filesystem::exists(dir + "modelDescription.xml"));
+    EXPECT_GT(boost::filesystem::last_write_time(dir), std::time(nullptr) - Util::FmuCache::minUnusedTime);
+
+    // a changed FMU gets a new directory
+    writeZip("test.fmu", { { "modelDescription.xml", "second" } }, true);
+    std::string changed = Util::FmuCache::extract(fmu, _cache.string());
+    EXPECT_NE(dir, changed);
+    EXPECT_EQ("second", readFile(changed + "modelDescription.xml"));
+}
+
+TEST_F (FmuCacheTest, EvictionSkipsRecentlyUsedEntries)
+{
+    const std::time_t old = 2 * Util::FmuCache::minUnusedTime, recent = Util::FmuCache::minUnusedTime / 2;
+    vector<boost::filesystem::path> oldEntries, recentEntries;
+    for (std::size_t i = 0; i < 2; ++i)
+        oldEntries.push_back(addEntry("old" + to_string(i), old + i));
+    for (std::size_t i = 0; i < Util::FmuCache::maxEntries - 2; ++i)
+        recentEntries.push_back(addEntry("recent" + to_string(i), recent));
+    boost::filesystem::path crashed = addEntry("crashed.tmp-1234", old);
+
+    // one entry too many: only the least recently used one goes
+    std::string first = Util::FmuCache::extract(writeZip("first.fmu", { { "a", "a" } }, false), _cache.string());
+    EXPECT_FALSE(boost::filesystem::exists(oldEntries[1]));
+    EXPECT_TRUE(boost::filesystem::exists(oldEntries[0]));
+    EXPECT_FALSE(boost::filesystem::exists(crashed));
+
+    // the entries used within the last hour are kept, even if the cache exceeds its size
+    std::string second = Util::FmuCache::extract(writeZip("second.fmu", { { "b", "b" } }, false), _cache.string());
+    std::string third = Util::FmuCache::extract(writeZip("third.fmu", { { "c", "c" } }, false), _cache.string());
+    EXPECT_FALSE(boost::filesystem::exists(oldEntries[0]));
+    for (const auto & entry : recentEntries)
+        EXPECT_TRUE(boost::filesystem::exists(entry));
+    EXPECT_TRUE(boost::filesystem::exists(first));
+    EXPECT_TRUE(boost::filesystem::exists(second));
+    EXPECT_TRUE(boost::filesystem::exists(third));
+}
+
+#endif /* TEST_INCLUDE_TESTFMUCACHE_HPP_ */
@@ -0,0 +1,132 @@
+/*
+ * TestFmuStatePool.hpp
+ */
+
+#ifndef TEST_INCLUDE_TESTFMUSTATEPOOL_HPP_
+#define TEST_INCLUDE_TESTFMUSTATEPOOL_HPP_
+
+#include <gtest/gtest.h>
+
+#include "fmi/FmuStatePool.hpp"
+#include "fmi/NativeFmu.hpp"
+#include "initialization/DefaultValues.hpp"
+
+TEST(FmuStatePool, ReleasedIdsAreRecycled)
+{
+    FMI::FmuStatePool pool;
+    size_type first = pool.acquire();
+    size_type second = pool.acquire();
+    ASSERT_NE(first, second);
+    ASSERT_EQ(2u, pool.size());
+
+    pool.get(first).states = vector<real_type>(8, 1.0);
+    pool.release(first);
+    EXPECT_FALSE(pool.isUsed(first));
+    EXPECT_TRUE(pool.isUsed(second));
+    EXPECT_THROW(pool.get(first), runtime_error);
+    EXPECT_THROW(pool.release(first), runtime_error);
+
+    // the released snapshot and its memory are reused instead of allocating a new one
+    ASSERT_EQ(first, pool.acquire());
+    EXPECT_EQ(2u, pool.size());
+    EXPECT_EQ(8u, pool.get(first).states.capacity());
+    EXPECT_EQ(2u, pool.acquire());
+    EXPECT_EQ(3u, pool.size());
+}
+
+TEST(FmuStatePool, ClearFreesHandles)
+{
+    FMI::FmuStatePool pool;
+    int handle = 0;
+    pool.get(pool.acquire()).handle = &handle;
+    pool.acquire();
+    pool.release(0);
+
+    size_type numFreed = 0;
+    pool.clear([&](FMI::FmuSnapshot & snapshot)
+    {
+        EXPECT_EQ(&handle, snapshot.handle);
+        ++numFreed;
+    });
+    EXPECT_EQ(1u, numFreed);
+    EXPECT_EQ(0u, pool.size());
+    EXPECT_FALSE(pool.isUsed(0));
+}
+
+class FmuState : public ::testing::Test
+{
+ public:
+    Initialization::FmuPlan _plan;
+
+    FmuState()
+            : _plan(Initialization::DefaultValues::fmuPlan())
+    {
+        _plan.name = "Synthetic";
+        _plan.loader = "native";
+        _plan.path = "synthetic?states=2&eventPeriod=0.2";
+    }
+
+    static FMI::ValueCollection getEventValues(const FMI::AbstractFmu & fmu)
+    {
+        const FMI::ValueReferenceCollection & refs = fmu.getTypeInfo().eventValueReferences;
+        FMI::ValueCollection res(refs.getValues<real_type>().size(), refs.getValues<int_type>().size(),
+                                 refs.getValues<bool_type>().size(), 0);
+        fmu.getValues(res);
+        return res;
+    }
+};
+
+TEST_F (FmuState, SaveStepRestore)
+{
+    FMI::NativeFmu fmu(_plan);
+    fmu.load();
+    ASSERT_FALSE(fmu.canGetAndSetState());
+    const vector<real_type> states = fmu.getStates();
+    const FMI::ValueCollection values = getEventValues(fmu);
+    const bool_type converged = fmu.getEventInfo().isIterationConverged();
+    size_type snapshot = fmu.saveState();
+
+    // step to the first event at t=0.1 and handle it, which flips the level and counts the event
+    fmu.setTime(0.1);
+    fmu.setStates(vector<real_type>( {0.5, 0.25}));
+    ASSERT_NE(converged, fmu.eventUpdate().isIterationConverged());
+    ASSERT_EQ(1, getEventValues(fmu).getValues<int_type>()[0]);
+    ASSERT_NE(values, getEventValues(fmu));
+
+    fmu.restoreState(snapshot);
+    EXPECT_EQ(0.0, fmu.getTime());
+    EXPECT_EQ(states, fmu.getStates());
+    EXPECT_EQ(values, getEventValues(fmu));
+    EXPECT_EQ(converged, fmu.getEventInfo().isIterationConverged());
+
+    // the snapshot stays valid and can be restored again
+    fmu.setStates(vector<real_type>( {2.0, 2.0}));
+    fmu.restoreState(snapshot);
+    EXPECT_EQ(states, fmu.getStates());
+    fmu.releaseState(snapshot);
+    EXPECT_THROW(fmu.restoreState(snapshot), runtime_error);
+    fmu.unload();
+}
+
+TEST_F (FmuState, ReleasedSnapshotsAreRecycled)
+{
+    FMI::NativeFmu fmu(_plan);
+    fmu.load();
+    size_type first = fmu.saveState();
+    size_type second = fmu.saveState();
+    ASSERT_NE(first, second);
+    fmu.releaseState(first);
+
+    // the recycled snapshot holds the new state
+    fmu.setTime(0.3);
+    fmu.setStates(vector<real_type>( {0.5, 0.25}));
+    ASSERT_EQ(first, fmu.saveState());
+    fmu.restoreState(second);
+    EXPECT_EQ(0.0, fmu.getTime());
+    fmu.restoreState(first);
+    EXPECT_EQ(0.3, fmu.getTime());
+    EXPECT_EQ(vector<real_type>( {0.5, 0.25}), fmu.getStates());
+    fmu.unload();
+}
+
+#endif /* TEST_INCLUDE_TESTFMUSTATEPOOL_HPP_ */
@@ -0,0 +1,212 @@
+/*
+ * TestModelDescriptionCache.hpp
+ */
+
+#ifndef TEST_INCLUDE_TESTMODELDESCRIPTIONCACHE_HPP_
+#define TEST_INCLUDE_TESTMODELDESCRIPTIONCACHE_HPP_
+
+#include <algorithm>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/stat.h>
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include "fmi/ModelDescriptionCache.hpp"
+
+class ModelDescriptionCacheTest : public ::testing::Test
+{
+ public:
+    boost::filesystem::path _dir;
+    string_type _path;
+    FMI::ModelDescriptionTable _table;
+
+    /**
+     * A table with a variable of every type.
+     */
+    ModelDescriptionCacheTest()
+            : _dir(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("mdcachetest-%%%%-%%%%")),
+              _path(_dir.string() + "/")
+    {
+        boost::filesystem::create_directories(_dir);
+        writeXml("<fmiModelDescription modelName=\"Test\"/>");
+
+        _table.modelIdentifier = "Test";
+        _table.guid = "{8c4e810f-3df3-4a00-8276-176fa3c9f000}";
+        _table.defaultStartTime = 0.5;
+        _table.defaultStopTime = 2.0;
+        _table.numberOfStates = 2;
+        _table.numberOfEventIndicators = 1;
+        _table.variables.push_back(createVariable("x", 0, VarType::varReal));
+        _table.variables.back().realStart = 1.5;
+        _table.variables.push_back(createVariable("n", 1, VarType::varInt));
+        _table.variables.back().intStart = -3;
+        _table.variables.push_back(createVariable("mode", 2, VarType::varEnum));
+        _table.variables.back().intStart = 2;
+        _table.variables.push_back(createVariable("on", 3, VarType::varBool));
+        _table.variables.back().boolStart = 1;
+        _table.variables.push_back(createVariable("label", 4, VarType::varString));
+        _table.variables.back().stringStart = "start";
+        _table.variables.back().causality = VarCausality::varCausalityInput;
+        _table.variables.back().alias = Enu::enu_alias;
+    }
+
+    ~ModelDescriptionCacheTest()
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove_all(_dir, ec);
+    }
+
+    void writeXml(const string_type & content)
+    {
+        std::ofstream(_path + "modelDescription.xml", std::ios::binary) << content;
+    }
+
+    struct timespec getXmlModificationTime() const
+    {
+        struct stat info;
+        stat((_path + "modelDescription.xml").c_str(), &info);
+        return info.st_mtim;
+    }
+
+    void setXmlModificationTime(const struct timespec & time) const
+    {
+        struct timespec times[2] = { time, time };
+        utimensat(AT_FDCWD, (_path + "modelDescription.xml").c_str(), times, 0);
+    }
+
+    static FMI::ModelVariable createVariable(const string_type & name, const size_type & valueReference,
+                                             const VarType & type)
+    {
+        FMI::ModelVariable res = FMI::ModelVariable();
+        res.name = name;
+        res.valueReference = valueReference;
+        res.type = type;
+        res.causality = VarCausality::varCausalityInternal;
+        res.variability = Enu::enu_continuous;
+        res.alias = Enu::enu_noAlias;
+        res.startStatus = ValueStatus::valueDefined;
+        return res;
+    }
+};
+
+TEST_F (ModelDescriptionCacheTest, RoundTrip)
+{
+    FMI::ModelDescriptionTable table;
+    ASSERT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+    FMI::ModelDescriptionCache::write(_path, _table);
+    ASSERT_TRUE(FMI::ModelDescriptionCache::read(_path, table));
+
+    EXPECT_EQ(_table.modelIdentifier, table.modelIdentifier);
+    EXPECT_EQ(_table.guid, table.guid);
+    EXPECT_EQ(_table.defaultStartTime, table.defaultStartTime);
+    EXPECT_EQ(_table.defaultStopTime, table.defaultStopTime);
+    EXPECT_EQ(_table.numberOfStates, table.numberOfStates);
+    EXPECT_EQ(_table.numberOfEventIndicators, table.numberOfEventIndicators);
+    ASSERT_EQ(_table.variables.size(), table.variables.size());
+    for (size_type i = 0; i < table.variables.size(); ++i)
+    {
+        const FMI::ModelVariable & expected = _table.variables[i], & res = table.variables[i];
+        EXPECT_EQ(expected.name, res.name);
+        EXPECT_EQ(expected.valueReference, res.valueReference);
+        EXPECT_EQ(expected.type, res.type);
+        EXPECT_EQ(expected.causality, res.causality);
+        EXPECT_EQ(expected.variability, res.variability);
+        EXPECT_EQ(expected.alias, res.alias);
+        EXPECT_EQ(expected.startStatus, res.startStatus);
+    }
+    EXPECT_EQ(1.5, table.variables[0].realStart);
+    EXPECT_EQ(-3, table.variables[1].intStart);
+    EXPECT_EQ(2, table.variables[2].intStart);
+    EXPECT_EQ(1, table.variables[3].boolStart);
+    EXPECT_EQ("start", table.variables[4].stringStart);
+}
+
+TEST_F (ModelDescriptionCacheTest, RejectsStaleFile)
+{
+    FMI::ModelDescriptionTable table;
+    FMI::ModelDescriptionCache::write(_path, _table);
+    const struct timespec written = getXmlModificationTime();
+
+    // rewritten with the same content: the new modification time is checked by the hash
+    writeXml("<fmiModelDescription modelName=\"Test\"/>");
+    setXmlModificationTime({written.tv_sec + 10, written.tv_nsec});
+    EXPECT_TRUE(FMI::ModelDescriptionCache::read(_path, table));
+
+    // same size, but another content
+    writeXml("<fmiModelDescription modelName=\"Tset\"/>");
+    setXmlModificationTime({written.tv_sec + 20, written.tv_nsec});
+    EXPECT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+
+    // another size, even with the modification time of the stored XML
+    writeXml("<fmiModelDescription modelName=\"Test2\"/>");
+    setXmlModificationTime(written);
+    EXPECT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+
+    boost::filesystem::remove(_path + "modelDescription.xml");
+    EXPECT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+}
+
+TEST_F (ModelDescriptionCacheTest, RejectsTruncatedFile)
+{
+    FMI::ModelDescriptionTable table;
+    FMI::ModelDescriptionCache::write(_path, _table);
+    const string_type binPath = _path + FMI::ModelDescriptionCache::fileName;
+    const std::uintmax_t size = boost::filesystem::file_size(binPath);
+
+    boost::filesystem::resize_file(binPath, size - 1);
+    EXPECT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+    boost::filesystem::resize_file(binPath, size / 2);
+    EXPECT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+    boost::filesystem::resize_file(binPath, 4);
+    EXPECT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+
+    // trailing data
+    FMI::ModelDescriptionCache::write(_path, _table);
+    std::ofstream(binPath, std::ios::binary | std::ios::app) << 'x';
+    EXPECT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+
+    // another layout
+    FMI::ModelDescriptionCache::write(_path, _table);
+    std::fstream file(binPath, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(7);
+    file.put('0');
+    file.close();
+    EXPECT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+}
+
+TEST_F (ModelDescriptionCacheTest, RejectsOtherMachineLayout)
+{
+    FMI::ModelDescriptionTable table;
+    const string_type binPath = _path + FMI::ModelDescriptionCache::fileName;
+
+    // the byte order marker follows the magic, as written by a machine with the other byte order
+    FMI::ModelDescriptionCache::write(_path, _table);
+    {
+        std::fstream file(binPath, std::ios::binary | std::ios::in | std::ios::out);
+        char marker[4];
+        file.seekg(8);
+        file.read(marker, 4);
+        std::reverse(marker, marker + 4);
+        file.seekp(8);
+        file.write(marker, 4);
+    }
+    EXPECT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+
+    // the word size follows the marker
+    FMI::ModelDescriptionCache::write(_path, _table);
+    {
+        std::fstream file(binPath, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(12);
+        file.put(static_cast<char>(sizeof(void *) == 8 ? 4 : 8));
+    }
+    EXPECT_FALSE(FMI::ModelDescriptionCache::read(_path, table));
+
+    // rewritten by this machine
+    FMI::ModelDescriptionCache::write(_path, _table);
+    EXPECT_TRUE(FMI::ModelDescriptionCache::read(_path, table));
+    EXPECT_EQ(_table.guid, table.guid);
+}
+
+#endif /* TEST_INCLUDE_TESTMODELDESCRIPTIONCACHE_HPP_ */
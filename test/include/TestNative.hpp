@@ -0,0 +1,266 @@
+/*
+ * TestNative.hpp
+ */
+
+#ifndef TEST_INCLUDE_TESTNATIVE_HPP_
+#define TEST_INCLUDE_TESTNATIVE_HPP_
+
+#include "TestCommon.hpp"
+
+/**
+ * The source relaxes its states with the rates k[i] = 1, 10^(1/3), 10^(2/3), 10 towards its level, which flips at the
+ * events t=0.1 and t=0.3. The sink follows 1 + the outputs of the source, y[1] = x[1] and y[2] = x[2], with rate 1 and
+ * has no events of its own.
+ */
+class Native : public TestCommon
+{
+ public:
+    Native(const std::string & configFile = "./test/data/TestConfig_Native_serial.xml")
+            : TestCommon(configFile)
+    {
+    }
+
+    ~Native()
+    {
+    }
+
+    void simulate(const real_type & endTime)
+    {
+        _simulation->setSimulationEndTime(endTime);
+        _simulation->initialize();
+        _simulation->simulate();
+        for (const auto & solv : _simulation->getSolver())
+            ASSERT_EQ(solv->getCurrentTime(), endTime);
+    }
+
+    FMI::AbstractFmu * getFmu(const string_type & name) const
+    {
+        for (const auto & solv : _simulation->getSolver())
+            if (solv->getFmu()->getFmuName() == name)
+                return solv->getFmu();
+        throw runtime_error("Native: Unknown FMU " + name);
+    }
+
+    /**
+     * The exact states of the source.
+     */
+    static vector<real_type> getSourceStates(const real_type & time)
+    {
+        vector<real_type> res(4, 1.0);
+        for (size_type i = 0; i < res.size(); ++i)
+        {
+            real_type rate = std::pow(10.0, i / 3.0);
+            if (time > 0.1)
+                res[i] = -1.0 + 2.0 * std::exp(-rate * (std::min(time, 0.3) - 0.1));
+            if (time > 0.3)
+                res[i] = 1.0 + (res[i] - 1.0) * std::exp(-rate * (time - 0.3));
+        }
+        return res;
+    }
+
+    /**
+     * Checks the states, the inputs of the sink and the level of the source. Euler's error grows with the rate, so the
+     * source is checked with a larger tolerance.
+     */
+    void checkValues(const real_type & time, const vector<real_type> & sinkStates, const real_type & level)
+    {
+        FMI::AbstractFmu * source = getFmu("Source"), *sink = getFmu("Sink");
+        vector<real_type> sourceStates = getSourceStates(time);
+        for (size_type i = 0; i < sourceStates.size(); ++i)
+            EXPECT_NEAR(sourceStates[i], source->getStates()[i], 0.025) << "x[" << i + 1 << "] of the source";
+        for (size_type i = 0; i < sinkStates.size(); ++i)
+            EXPECT_NEAR(sinkStates[i], sink->getStates()[i], 0.01) << "x[" << i + 1 << "] of the sink";
+
+        FMI::ValueCollection sourceValues = source->getValues(FMI::ReferenceContainerType::ALL), sinkValues = sink
+                ->getValues(FMI::ReferenceContainerType::ALL);
+        // x[1..4], y[1..2], level and x[1..2], u[1..2], y[1], level
+        EXPECT_EQ(level, sourceValues.getValues<real_type>()[6]);
+        EXPECT_EQ(1.0, sinkValues.getValues<real_type>()[5]);
+        // the sink has set its inputs within its last step, so they are between the outputs at its start and end
+        vector<real_type> start = getSourceStates(time - 0.01);
+        for (size_type i = 0; i < 2; ++i)
+            EXPECT_NEAR((start[i] + sourceStates[i]) / 2.0, sinkValues.getValues<real_type>()[2 + i],
+                        std::abs(start[i] - sourceStates[i]) / 2.0 + 0.025) << "u[" << i + 1 << "] of the sink";
+    }
+};
+
+TEST_F (Native, TestSyntheticSerial)
+{
+    ASSERT_TRUE(_simulation->getSimulationType() == "serial");
+    ASSERT_EQ(_simulation->getSolver().size(), 2);
+    simulate(0.5);
+    // the sink's states are integrated with the exact source states and a fine step size
+    checkValues(0.5, { 1.30541, 1.23370 }, 1.0);
+    EXPECT_EQ(2, getFmu("Source")->getValues(FMI::ReferenceContainerType::ALL).getValues<int_type>()[0]);
+}
+
+TEST_F (Native, TestSyntheticSerialAfterEvent)
+{
+    simulate(0.12);
+    checkValues(0.12, { 1.11268, 1.11224 }, -1.0);
+    EXPECT_EQ(1, getFmu("Source")->getValues(FMI::ReferenceContainerType::ALL).getValues<int_type>()[0]);
+}
+
+/**
+ * The FMUs of Native, simulated by a task simulation.
+ */
+class NativeTask : public Native
+{
+ public:
+    NativeTask()
+            : Native("./test/data/TestConfig_Native_task.xml")
+    {
+    }
+};
+
+TEST_F (NativeTask, TestResultsMatchSerial)
+{
+    ASSERT_TRUE(_simulation->getSimulationType() == "task");
+    simulate(0.5);
+    checkValues(0.5, { 1.30541, 1.23370 }, 1.0);
+    EXPECT_EQ(2, getFmu("Source")->getValues(FMI::ReferenceContainerType::ALL).getValues<int_type>()[0]);
+
+    Initialization::Program serialProgram(
+            Initialization::CommandLineArgs("./test/data/TestConfig_Native_serial.xml", Util::LogLevel::LL_DEBUG));
+    serialProgram.initialize();
+    Simulation::AbstractSimulationSPtr serial = serialProgram.getSimulation();
+    ASSERT_TRUE(serial->getSimulationType() == "serial");
+    serial->setSimulationEndTime(0.5);
+    serial->initialize();
+    serial->simulate();
+    for (size_type i = 0; i < serial->getSolver().size(); ++i)
+    {
+        FMI::AbstractFmu * serialFmu = serial->getSolver()[i]->getFmu(), *taskFmu = getFmu(serialFmu->getFmuName());
+        ASSERT_EQ(serialFmu->getStates().size(), taskFmu->getStates().size());
+        for (size_type j = 0; j < serialFmu->getStates().size(); ++j)
+            EXPECT_NEAR(serialFmu->getStates()[j], taskFmu->getStates()[j], 1.0e-3)
+                    << "x[" << j + 1 << "] of " << serialFmu->getFmuName();
+    }
+}
+
+/**
+ * Outputs the number of elapsed periods of 0.05 as string "tick".
+ */
+class TickerModel : public FMI::NativeModel
+{
+ public:
+    TickerModel()
+            : FMI::NativeModel(1, 0)
+    {
+        _reals.resize(1, 0.0);
+        _strings.resize(1);
+        computeOutputs();
+    }
+
+    void describe(FMI::FmuTypeInfo & info) const override
+    {
+        info.modelIdentifier = "ticker";
+        info.defaultStartTime = 0.0;
+        info.defaultStopTime = 1.0;
+        info.numberOfStates = _numStates;
+        info.numberOfEventIndicators = _numEventIndicators;
+        addVariable<real_type>(info, "x", 0, _reals[0], true);
+        addVariable<string_type>(info, "tick", 0, _strings[0], false, VarCausality::varCausalityOutput);
+    }
+
+    void getDerivatives(real_type * derivatives) const override
+    {
+        derivatives[0] = 0.0;
+    }
+
+    void getEventIndicators(real_type * /*eventIndicators*/) const override
+    {
+    }
+
+    bool_type eventUpdate() override
+    {
+        return false;
+    }
+
+    void computeOutputs() override
+    {
+        _strings[0] = to_string(static_cast<int_type>(std::floor(_time * 20.0 + 1.0e-6)));
+    }
+};
+
+/**
+ * Integrates its string input "tick" as number.
+ */
+class RecorderModel : public FMI::NativeModel
+{
+ public:
+    RecorderModel()
+            : FMI::NativeModel(1, 0)
+    {
+        _reals.resize(1, 0.0);
+        _strings.resize(1, "0");
+    }
+
+    void describe(FMI::FmuTypeInfo & info) const override
+    {
+        info.modelIdentifier = "recorder";
+        info.defaultStartTime = 0.0;
+        info.defaultStopTime = 1.0;
+        info.numberOfStates = _numStates;
+        info.numberOfEventIndicators = _numEventIndicators;
+        addVariable<real_type>(info, "x", 0, _reals[0], true);
+        addVariable<string_type>(info, "tick", 0, _strings[0], false, VarCausality::varCausalityInput);
+    }
+
+    void getDerivatives(real_type * derivatives) const override
+    {
+        derivatives[0] = std::stod(_strings[0]);
+    }
+
+    void getEventIndicators(real_type * /*eventIndicators*/) const override
+    {
+    }
+
+    bool_type eventUpdate() override
+    {
+        return false;
+    }
+
+    void computeOutputs() override
+    {
+    }
+};
+
+class NativeStrings : public TestCommon
+{
+ public:
+    NativeStrings()
+            : TestCommon("./test/data/TestConfig_Native_strings.xml")
+    {
+        FMI::NativeModel::registerModel("ticker", [](const map<string_type, real_type> &)
+        {   return new TickerModel();});
+        FMI::NativeModel::registerModel("recorder", [](const map<string_type, real_type> &)
+        {   return new RecorderModel();});
+    }
+
+    ~NativeStrings()
+    {
+    }
+};
+
+TEST_F (NativeStrings, TestChangingStringOutput)
+{
+    _simulation->initialize();
+    _simulation->simulate();
+    for (const auto & solv : _simulation->getSolver())
+        ASSERT_EQ(solv->getCurrentTime(), 0.5);
+    // The tick counts 0, 1, ..., 9 for 0.05 each, so the integral is 0.05 * 45. The results are written only at two
+    // output times, so a tick read only at those would give a much smaller value.
+    FMI::AbstractFmu * recorder = _simulation->getSolver().back()->getFmu();
+    ASSERT_EQ("recorder", recorder->getTypeInfo().modelIdentifier);
+    EXPECT_NEAR(2.25, recorder->getStates()[0], 0.1);
+}
+
+TEST(NativeModel, UnknownModel)
+{
+    ASSERT_THROW(FMI::NativeModel::create("unknown?states=1"), runtime_error);
+    ASSERT_THROW(FMI::NativeModel::create("synthetic?states=a"), runtime_error);
+    ASSERT_THROW(FMI::NativeModel::create("synthetic?states=0"), runtime_error);
+}
+
+#endif /* TEST_INCLUDE_TESTNATIVE_HPP_ */
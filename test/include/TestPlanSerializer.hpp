@@ -0,0 +1,309 @@
+/*
+ * TestPlanSerializer.hpp
+ */
+
+#ifndef TEST_INCLUDE_TESTPLANSERIALIZER_HPP_
+#define TEST_INCLUDE_TESTPLANSERIALIZER_HPP_
+
+#include <gtest/gtest.h>
+
+#include "initialization/DefaultValues.hpp"
+#include "initialization/PlanSerializer.hpp"
+#include "synchronization/Communicator.hpp"
+#include "synchronization/GlobalVirtualTime.hpp"
+
+class PlanSerializerTest : public ::testing::Test
+{
+ public:
+    Initialization::ProgramPlan _plan;
+
+    /**
+     * Two nodes: node 0 with two cores connected by an "openmp" connection, node 1 with one core, which receives a
+     * delta encoded "mpi" connection from node 0. Every field differs from its default value.
+     */
+    PlanSerializerTest()
+            : _plan(Initialization::DefaultValues::programPlan())
+    {
+        _plan.useProcesses = true;
+
+        auto local = make_shared<Initialization::ConnectionPlan>(createConnection(0, "openmp", "Source", "Sink0"));
+        auto remote = make_shared<Initialization::ConnectionPlan>(createConnection(1, "mpi", "Source", "Sink1"));
+        remote->destRank = 1;
+        remote->batchSize = 8;
+        remote->maxBatchBytes = 4096;
+        remote->remoteKind = "mpirma";
+        remote->sharedMemory = false;
+        remote->encoding = "delta";
+        remote->deadbands = {0.5, 0.0};
+        remote->shmOffset = 128;
+        remote->startTag = 3;
+
+        _plan.simPlans.resize(2);
+        _plan.simPlans[0].push_back(createSimulation(0, 2));
+        _plan.simPlans[0].push_back(createSimulation(1, 3));
+        _plan.simPlans[1].push_back(createSimulation(2, -1));
+
+        auto source = createSolver(0, "Source");
+        source->outConnections = {local, remote};
+        auto sink0 = createSolver(1, "Sink0");
+        sink0->inConnections = {local};
+        auto sink1 = createSolver(2, "Sink1");
+        sink1->inConnections = {remote};
+        sink1->fmu->loader = "fmi2";
+        sink1->fmu->version = "2.0";
+        sink1->fmu->coSimulation = true;
+
+        _plan.simPlans[0][0].dataManager.solvers.push_back(source);
+        _plan.simPlans[0][0].dataManager.outConnections = {local, remote};
+        _plan.simPlans[0][1].dataManager.solvers.push_back(sink0);
+        _plan.simPlans[0][1].dataManager.inConnections = {local};
+        _plan.simPlans[1][0].dataManager.solvers.push_back(sink1);
+        _plan.simPlans[1][0].dataManager.inConnections = {remote};
+    }
+
+    static Initialization::ConnectionPlan createConnection(const size_type & id, const string_type & kind,
+                                                           const string_type & source, const string_type & dest)
+    {
+        Initialization::ConnectionPlan res = Initialization::DefaultValues::connectionPlan();
+        res.id = id;
+        res.kind = kind;
+        res.bufferSize = 7 + id;
+        res.sourceFmu = source;
+        res.destFmu = dest;
+        res.sourceRank = 0;
+        res.destRank = 0;
+        res.startTag = 0;
+        res.inputMapping = FMI::InputMapping( { make_tuple(4, 2), make_tuple(5, 3)}, { make_tuple(0, 1)},
+                                             { make_tuple(1, 0)}, { make_tuple(2, 2)});
+        return res;
+    }
+
+    static Initialization::SimulationPlan createSimulation(const size_type & num, const int & cpuId)
+    {
+        Initialization::SimulationPlan res = Initialization::DefaultValues::simulationPlan();
+        res.kind = "task";
+        res.startTime = 0.5;
+        res.endTime = 10.0;
+        res.defaultStepSize = 1.0e-3;
+        res.defaultEventInterval = 1.0e-4;
+        res.defaultMaxError = 1.0e-6;
+        res.defaultTolerance = 1.0e-7;
+        res.cpuId = cpuId;
+        res.implicitCpu = (cpuId % 2) == 0;
+        res.idleSpins = 50 + num;
+        res.maxIdleParkTime = 0.25;
+        res.maxSolveQuantum = 12;
+        res.coupling = "gaussSeidel";
+        res.macroStepSize = 0.125;
+        res.globalTimeInterval = 9;
+        res.dataManager.writer.kind = "csvFileWriter";
+        res.dataManager.writer.startTime = 0.5;
+        res.dataManager.writer.endTime = 10.0;
+        res.dataManager.writer.numSteps = 200;
+        res.dataManager.writer.filePath = "result" + to_string(num) + ".csv";
+        res.dataManager.history.kind = "openmp";
+        return res;
+    }
+
+    static shared_ptr<Initialization::SolverPlan> createSolver(const size_type & id, const string_type & name)
+    {
+        auto res = make_shared<Initialization::SolverPlan>(Initialization::DefaultValues::solverPlan());
+        res->kind = "ros2";
+        res->id = id;
+        res->startTime = 0.5;
+        res->endTime = 10.0;
+        res->stepSize = 0.01;
+        res->maxError = 1.0e-5;
+        res->eventInterval = 1.0e-3;
+        res->fmu = make_shared<Initialization::FmuPlan>(Initialization::DefaultValues::fmuPlan());
+        res->fmu->name = name;
+        res->fmu->path = "test/data/" + name + ".fmu";
+        res->fmu->workingPath = "/tmp/work" + to_string(id);
+        res->fmu->cachePath = "/tmp/cache";
+        res->fmu->version = "1.0";
+        res->fmu->id = 10 + id;
+        res->fmu->loader = "fmuSdk";
+        res->fmu->intermediateResults = true;
+        res->fmu->tolControlled = false;
+        res->fmu->relTol = 1.0e-4;
+        res->fmu->logEnabled = true;
+        res->fmu->coSimulation = false;
+        res->fmu->solverId = id;
+        return res;
+    }
+
+    static void expectEqual(const FMI::InputMapping & expected, const FMI::InputMapping & actual)
+    {
+        EXPECT_EQ(expected.getValues<real_type>(), actual.getValues<real_type>());
+        EXPECT_EQ(expected.getValues<int_type>(), actual.getValues<int_type>());
+        EXPECT_EQ(expected.getValues<bool_type>(), actual.getValues<bool_type>());
+        EXPECT_EQ(expected.getValues<string_type>(), actual.getValues<string_type>());
+    }
+
+    static void expectEqual(const Initialization::ConnectionPlan & expected,
+                            const Initialization::ConnectionPlan & actual)
+    {
+        EXPECT_EQ(expected.kind, actual.kind);
+        EXPECT_EQ(expected.bufferSize, actual.bufferSize);
+        EXPECT_EQ(expected.batchSize, actual.batchSize);
+        EXPECT_EQ(expected.maxBatchBytes, actual.maxBatchBytes);
+        EXPECT_EQ(expected.remoteKind, actual.remoteKind);
+        EXPECT_EQ(expected.sharedMemory, actual.sharedMemory);
+        EXPECT_EQ(expected.encoding, actual.encoding);
+        EXPECT_EQ(expected.deadbands, actual.deadbands);
+        EXPECT_EQ(expected.shmOffset, actual.shmOffset);
+        EXPECT_EQ(expected.sourceRank, actual.sourceRank);
+        EXPECT_EQ(expected.destRank, actual.destRank);
+        EXPECT_EQ(expected.sourceFmu, actual.sourceFmu);
+        EXPECT_EQ(expected.destFmu, actual.destFmu);
+        EXPECT_EQ(expected.id, actual.id);
+        EXPECT_EQ(expected.startTag, actual.startTag);
+        expectEqual(expected.inputMapping, actual.inputMapping);
+    }
+
+    static void expectEqual(const list<shared_ptr<Initialization::ConnectionPlan>> & expected,
+                            const list<shared_ptr<Initialization::ConnectionPlan>> & actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (auto e = expected.begin(), a = actual.begin(); e != expected.end(); ++e, ++a)
+            expectEqual(**e, **a);
+    }
+
+    static void expectEqual(const Initialization::SolverPlan & expected, const Initialization::SolverPlan & actual)
+    {
+        EXPECT_EQ(expected.kind, actual.kind);
+        EXPECT_EQ(expected.id, actual.id);
+        EXPECT_EQ(expected.startTime, actual.startTime);
+        EXPECT_EQ(expected.endTime, actual.endTime);
+        EXPECT_EQ(expected.stepSize, actual.stepSize);
+        EXPECT_EQ(expected.maxError, actual.maxError);
+        EXPECT_EQ(expected.eventInterval, actual.eventInterval);
+        const Initialization::FmuPlan & e = *expected.fmu, & a = *actual.fmu;
+        EXPECT_EQ(e.name, a.name);
+        EXPECT_EQ(e.path, a.path);
+        EXPECT_EQ(e.workingPath, a.workingPath);
+        EXPECT_EQ(e.cachePath, a.cachePath);
+        EXPECT_EQ(e.version, a.version);
+        EXPECT_EQ(e.id, a.id);
+        EXPECT_EQ(e.loader, a.loader);
+        EXPECT_EQ(e.intermediateResults, a.intermediateResults);
+        EXPECT_EQ(e.tolControlled, a.tolControlled);
+        EXPECT_EQ(e.relTol, a.relTol);
+        EXPECT_EQ(e.logEnabled, a.logEnabled);
+        EXPECT_EQ(e.coSimulation, a.coSimulation);
+        EXPECT_EQ(e.solverId, a.solverId);
+        expectEqual(expected.outConnections, actual.outConnections);
+        expectEqual(expected.inConnections, actual.inConnections);
+    }
+
+    static void expectEqual(const Initialization::SimulationPlan & expected,
+                            const Initialization::SimulationPlan & actual)
+    {
+        EXPECT_EQ(expected.kind, actual.kind);
+        EXPECT_EQ(expected.startTime, actual.startTime);
+        EXPECT_EQ(expected.endTime, actual.endTime);
+        EXPECT_EQ(expected.defaultStepSize, actual.defaultStepSize);
+        EXPECT_EQ(expected.defaultEventInterval, actual.defaultEventInterval);
+        EXPECT_EQ(expected.defaultMaxError, actual.defaultMaxError);
+        EXPECT_EQ(expected.defaultTolerance, actual.defaultTolerance);
+        EXPECT_EQ(expected.cpuId, actual.cpuId);
+        EXPECT_EQ(expected.implicitCpu, actual.implicitCpu);
+        EXPECT_EQ(expected.idleSpins, actual.idleSpins);
+        EXPECT_EQ(expected.maxIdleParkTime, actual.maxIdleParkTime);
+        EXPECT_EQ(expected.maxSolveQuantum, actual.maxSolveQuantum);
+        EXPECT_EQ(expected.coupling, actual.coupling);
+        EXPECT_EQ(expected.macroStepSize, actual.macroStepSize);
+        EXPECT_EQ(expected.globalTimeInterval, actual.globalTimeInterval);
+
+        const Initialization::DataManagerPlan & e = expected.dataManager, & a = actual.dataManager;
+        EXPECT_EQ(e.writer.kind, a.writer.kind);
+        EXPECT_EQ(e.writer.startTime, a.writer.startTime);
+        EXPECT_EQ(e.writer.endTime, a.writer.endTime);
+        EXPECT_EQ(e.writer.numSteps, a.writer.numSteps);
+        EXPECT_EQ(e.writer.filePath, a.writer.filePath);
+        EXPECT_EQ(e.history.kind, a.history.kind);
+        ASSERT_EQ(e.solvers.size(), a.solvers.size());
+        for (size_type i = 0; i < e.solvers.size(); ++i)
+            expectEqual(*e.solvers[i], *a.solvers[i]);
+        expectEqual(e.outConnections, a.outConnections);
+        expectEqual(e.inConnections, a.inConnections);
+    }
+};
+
+TEST_F (PlanSerializerTest, RoundTrip)
+{
+    vector<char> buffer = Initialization::PlanSerializer::serialize(_plan);
+    Initialization::ProgramPlan res = Initialization::PlanSerializer::deserializeProgramPlan(buffer);
+
+    EXPECT_EQ(_plan.useProcesses, res.useProcesses);
+    ASSERT_EQ(_plan.simPlans.size(), res.simPlans.size());
+    for (size_type i = 0; i < _plan.simPlans.size(); ++i)
+    {
+        ASSERT_EQ(_plan.simPlans[i].size(), res.simPlans[i].size());
+        for (size_type j = 0; j < _plan.simPlans[i].size(); ++j)
+            expectEqual(_plan.simPlans[i][j], res.simPlans[i][j]);
+    }
+}
+
+TEST_F (PlanSerializerTest, SharesConnectionsAndNodeObjects)
+{
+    vector<char> buffer = Initialization::PlanSerializer::serialize(_plan);
+    Initialization::ProgramPlan res = Initialization::PlanSerializer::deserializeProgramPlan(buffer);
+
+    // both ends and the data managers refer to the same connection plans
+    const Initialization::SolverPlan & source = *res.simPlans[0][0].dataManager.solvers[0];
+    const Initialization::SolverPlan & sink0 = *res.simPlans[0][1].dataManager.solvers[0];
+    const Initialization::SolverPlan & sink1 = *res.simPlans[1][0].dataManager.solvers[0];
+    EXPECT_EQ(source.outConnections.front(), sink0.inConnections.front());
+    EXPECT_EQ(source.outConnections.back(), sink1.inConnections.front());
+    EXPECT_EQ(source.outConnections.back(), res.simPlans[1][0].dataManager.inConnections.front());
+
+    // one communicator and global virtual time per node
+    EXPECT_NE(res.simPlans[0][0].dataManager.commnicator, nullptr);
+    EXPECT_EQ(res.simPlans[0][0].dataManager.commnicator, res.simPlans[0][1].dataManager.commnicator);
+    EXPECT_NE(res.simPlans[0][0].dataManager.commnicator, res.simPlans[1][0].dataManager.commnicator);
+    EXPECT_NE(res.simPlans[0][0].globalTime, nullptr);
+    EXPECT_EQ(res.simPlans[0][0].globalTime, res.simPlans[0][1].globalTime);
+    EXPECT_NE(res.simPlans[0][0].globalTime, res.simPlans[1][0].globalTime);
+}
+
+TEST_F (PlanSerializerTest, RejectsDamagedBuffers)
+{
+    vector<char> buffer = Initialization::PlanSerializer::serialize(_plan);
+    vector<char> truncated(buffer.begin(), buffer.end() - 1);
+    EXPECT_THROW(Initialization::PlanSerializer::deserializeProgramPlan(truncated), runtime_error);
+    buffer.push_back(0);
+    EXPECT_THROW(Initialization::PlanSerializer::deserializeProgramPlan(buffer), runtime_error);
+}
+
+#ifdef USE_NETWORK_OFFLOADER
+TEST_F (PlanSerializerTest, NetworkPlanRoundTrip)
+{
+    Network::NetworkPlan plan;
+    plan.fmuNet.resize(2);
+    for (size_type i = 0; i < plan.fmuNet.size(); ++i)
+    {
+        plan.fmuNet[i].mpiPos = i;
+        plan.fmuNet[i].corePos = i + 1;
+        plan.fmuNet[i].solverPos = i + 2;
+        plan.fmuNet[i].inputMap = FMI::InputMapping( { make_tuple(i, 0)}, { make_tuple(1, i)});
+        plan.fmuNet[i].outputMap = FMI::InputMapping( {}, {}, { make_tuple(i, i)}, { make_tuple(0, 0)});
+    }
+
+    vector<char> buffer = Initialization::PlanSerializer::serialize(plan);
+    Network::NetworkPlan res = Initialization::PlanSerializer::deserializeNetworkPlan(buffer);
+    ASSERT_EQ(plan.fmuNet.size(), res.fmuNet.size());
+    for (size_type i = 0; i < plan.fmuNet.size(); ++i)
+    {
+        EXPECT_EQ(plan.fmuNet[i].mpiPos, res.fmuNet[i].mpiPos);
+        EXPECT_EQ(plan.fmuNet[i].corePos, res.fmuNet[i].corePos);
+        EXPECT_EQ(plan.fmuNet[i].solverPos, res.fmuNet[i].solverPos);
+        expectEqual(plan.fmuNet[i].inputMap, res.fmuNet[i].inputMap);
+        expectEqual(plan.fmuNet[i].outputMap, res.fmuNet[i].outputMap);
+    }
+    // the server is only known by the process it runs on
+    EXPECT_EQ(res.server, nullptr);
+}
+#endif
+
+#endif /* TEST_INCLUDE_TESTPLANSERIALIZER_HPP_ */
@@ -23,6 +23,7 @@ class SolverRos2 : public TestCommon
     }
 };
 
+#ifdef USE_TEST_FMUS
 TEST_F (SolverRos2, TestRos2EventHandling)
 {
     //first event of should occur approximately at t=0.45
@@ -37,5 +38,36 @@ TEST_F (SolverRos2, TestRos2EventHandling)
     _simulation->simulate();
     ASSERT_EQ(3, _simulation->getSolver().back()->getEventCounter());
 }
+#endif
+
+/**
+ * The states relax with the rates 1 and 1000 towards the level 1, which flips to -1 at the event t=0.25 and back at
+ * t=0.75. The step size 0.01 is far beyond the stability limit 0.002 of explicit solvers.
+ */
+class SolverRos2Stiff : public TestCommon
+{
+ public:
+    SolverRos2Stiff()
+            : TestCommon("./test/data/TestConfig_Ros2_stiff.xml")
+    {
+    }
+
+    ~SolverRos2Stiff()
+    {
+    }
+};
+
+TEST_F (SolverRos2Stiff, TestRelaxationWithEvents)
+{
+    _simulation->initialize();
+    _simulation->simulate();
+    Solver::ISolver & solver = *_simulation->getSolver().back();
+    ASSERT_EQ(1.0, solver.getCurrentTime());
+    ASSERT_EQ(2, solver.getEventCounter());
+    vector<real_type> states = solver.getFmu()->getStates();
+    // x[i] = 1 + (x[i](0.75) - 1) exp(-k[i] (t - 0.75)) with x[i](0.75) = -1 + 2 exp(-k[i] 0.5)
+    EXPECT_NEAR(1.0 - (2.0 - 2.0 * std::exp(-0.5)) * std::exp(-0.25), states[0], 1.0e-4);
+    EXPECT_NEAR(1.0, states[1], 1.0e-4);
+}
 
 #endif /* INCLUDE_TEST_TESTROS2_HPP_ */
@@ -0,0 +1,162 @@
+/*
+ * TestSharedMemoryConnection.hpp
+ */
+
+#ifndef TEST_INCLUDE_TESTSHAREDMEMORYCONNECTION_HPP_
+#define TEST_INCLUDE_TESTSHAREDMEMORYCONNECTION_HPP_
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "TestCommon.hpp"
+#include "fmi/NativeModel.hpp"
+#include "initialization/DefaultValues.hpp"
+#include "synchronization/SharedMemoryConnection.hpp"
+
+/**
+ * A connection, whose ring lies in memory of the test instead of a shared memory segment.
+ */
+class RingConnection : public Synchronization::SharedMemoryConnection
+{
+ public:
+    RingConnection(const Initialization::ConnectionPlan & in, char * ring)
+            : Synchronization::SharedMemoryConnection(in)
+    {
+        setRing(ring);
+    }
+};
+
+class SharedMemoryRing : public ::testing::Test
+{
+ public:
+    Initialization::ConnectionPlan _plan;
+    vector<std::uint64_t> _ring;
+
+    /**
+     * One real and one integer in a ring of four entries.
+     */
+    SharedMemoryRing()
+            : _plan(Initialization::DefaultValues::connectionPlan())
+    {
+        _plan.bufferSize = 4;
+        _plan.inputMapping = FMI::InputMapping( { make_tuple(0, 0)}, { make_tuple(0, 0)}, {}, {});
+        _ring.resize(Synchronization::SharedMemoryConnection::getRingSize(_plan) / sizeof(std::uint64_t));
+        Synchronization::SharedMemoryConnection::initializeRing(getRing());
+    }
+
+    char * getRing()
+    {
+        return reinterpret_cast<char*>(_ring.data());
+    }
+
+    static Synchronization::HistoryEntry createEntry(const size_type & i)
+    {
+        // explicit vectors, since the braced values would select the size constructor of ValueCollection
+        return Synchronization::HistoryEntry(
+                static_cast<real_type>(i), 1,
+                FMI::ValueCollection(vector<real_type>(1, 0.5 * i), vector<int_type>(1, static_cast<int_type>(i)),
+                                     vector<bool_type>(), vector<string_type>()));
+    }
+
+    static void expectEntry(const size_type & i, const Synchronization::HistoryEntry & entry)
+    {
+        ASSERT_TRUE(entry.isValid());
+        EXPECT_EQ(static_cast<real_type>(i), entry.getTime());
+        EXPECT_EQ(0.5 * i, entry.getValueCollection().getValues<real_type>()[0]);
+        EXPECT_EQ(static_cast<int_type>(i), entry.getValueCollection().getValues<int_type>()[0]);
+    }
+};
+
+TEST_F (SharedMemoryRing, FullRingRejectsSend)
+{
+    RingConnection source(_plan, getRing()), dest(_plan, getRing());
+    EXPECT_FALSE(dest.pollReady());
+    EXPECT_FALSE(dest.recv().isValid());
+    EXPECT_EQ(2, source.hasFreeBuffer());
+
+    for (size_type i = 0; i < 4; ++i)
+        ASSERT_TRUE(source.send(createEntry(i)));
+    EXPECT_EQ(0, source.hasFreeBuffer());
+    EXPECT_FALSE(source.send(createEntry(4)));
+
+    ASSERT_TRUE(dest.pollReady());
+    expectEntry(0, dest.recv());
+    EXPECT_EQ(1, source.hasFreeBuffer());
+    ASSERT_TRUE(source.send(createEntry(4)));
+    for (size_type i = 1; i < 5; ++i)
+        expectEntry(i, dest.recv());
+    EXPECT_FALSE(dest.pollReady());
+}
+
+TEST_F (SharedMemoryRing, TwoThreadsPassEntriesInOrder)
+{
+    const size_type numEntries = 100000;
+    RingConnection source(_plan, getRing()), dest(_plan, getRing());
+    std::thread producer([&]()
+    {
+        for (size_type i = 0; i < numEntries; ++i)
+            while (!source.send(createEntry(i)))
+                std::this_thread::yield();
+    });
+
+    size_type numWrong = 0;
+    for (size_type i = 0; i < numEntries; ++i)
+    {
+        Synchronization::HistoryEntry entry = dest.recv();
+        while (!entry.isValid())
+        {
+            std::this_thread::yield();
+            entry = dest.recv();
+        }
+        const FMI::ValueCollection & vals = entry.getValueCollection();
+        if (entry.getTime() != static_cast<real_type>(i) || vals.getValues<real_type>()[0] != 0.5 * i
+                || vals.getValues<int_type>()[0] != static_cast<int_type>(i))
+            ++numWrong;
+    }
+    producer.join();
+    EXPECT_EQ(0u, numWrong);
+    EXPECT_FALSE(dest.pollReady());
+}
+
+/**
+ * The source and the sink of TestConfig_Native_serial.xml, simulated in two worker processes.
+ */
+class Processes : public TestCommon
+{
+ public:
+    Processes(const std::string & configFile = "./test/data/TestConfig_Native_processes.xml")
+            : TestCommon(configFile)
+    {
+    }
+
+    ~Processes()
+    {
+    }
+};
+
+/**
+ * Like Processes, but the model of the source can't be created.
+ */
+class ProcessesFailing : public Processes
+{
+ public:
+    ProcessesFailing()
+            : Processes("./test/data/TestConfig_Native_processes_failing.xml")
+    {
+        FMI::NativeModel::registerModel("failing", [](const map<string_type, real_type> &) -> FMI::NativeModel *
+        {   throw runtime_error("Failing model");});
+    }
+};
+
+TEST_F (Processes, TestWorkersFinish)
+{
+    ASSERT_NO_THROW(_program.simulate());
+}
+
+TEST_F (ProcessesFailing, TestFailedWorkerStopsTheOthers)
+{
+    // The sink waits for the outputs of the source forever, unless it is terminated when the source fails.
+    ASSERT_THROW(_program.simulate(), runtime_error);
+}
+
+#endif /* TEST_INCLUDE_TESTSHAREDMEMORYCONNECTION_HPP_ */
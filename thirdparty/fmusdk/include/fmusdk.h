@@ -84,6 +84,11 @@ void fmuLogger(FMU *fmu, fmiComponent c, fmiString instanceName, fmiStatus statu
 int unzip(const char *zipPath, const char *outPath);
 void parseArguments(int argc, char *argv[], const char** fmuFileName, double* tEnd, double* h, int* loggingOn, char* csv_separator);
 FMU* loadFMU(const char* fmuFileName);
+// loads an FMU, which is already extracted into extractedPath (ending with a slash)
+FMU* loadExtractedFMU(const char* fmuFileName, const char* extractedPath);
+// loads the dll of an extracted FMU without parsing its modelDescription.xml, modelDescription may be NULL then
+FMU* loadExtractedFMUDll(const char* fmuFileName, const char* extractedPath, ModelDescription* modelDescription,
+                         const char* modelIdentifier);
 void unloadFMU(FMU *fmu);
 void deleteUnzippedFiles(FMU *fmu);
 void outputRow(FMU *fmu, fmiComponent c, double time, FILE* file, char separator, fmiBoolean header);
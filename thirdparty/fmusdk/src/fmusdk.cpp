@@ -174,10 +174,10 @@ char *getTempFmuLocation() {
     return fmuLocation;
 }
 
-static void* getAdr(int* s, FMU *fmu, const char* functionName){
+static void* getAdr(int* s, FMU *fmu, const char* modelIdentifier, const char* functionName){
     char name[BUFSIZE];
     void* fp;
-    sprintf(name, "%s_%s", getModelIdentifier(fmu->modelDescription), functionName);
+    sprintf(name, "%s_%s", modelIdentifier, functionName);
 #ifdef _MSC_VER
     fp = GetProcAddress(fmu->dllHandle, name);
 #else
@@ -196,7 +196,7 @@ static void* getAdr(int* s, FMU *fmu, const char* functionName){
 
 // Load the given dll and set function pointers in fmu
 // Return 0 to indicate failure
-static int loadDll(const char* dllPath, FMU *fmu) {
+static int loadDll(const char* dllPath, FMU *fmu, const char* modelIdentifier) {
     int s = 1;
 #ifdef FMI_COSIMULATION   
     int x = 1;
@@ -218,54 +218,54 @@ static int loadDll(const char* dllPath, FMU *fmu) {
     fmu->dllHandle = h;
 
 #ifdef FMI_COSIMULATION   
-    fmu->getTypesPlatform        = (fGetTypesPlatform)   getAdr(&s, fmu, "fmiGetTypesPlatform");
+    fmu->getTypesPlatform        = (fGetTypesPlatform)   getAdr(&s, fmu, modelIdentifier, "fmiGetTypesPlatform");
     if (s==0) { 
         s = 1; // work around bug for FMUs exported using Dymola 2012 and SimulationX 3.x
-        fmu->getTypesPlatform    = (fGetTypesPlatform)   getAdr(&s, fmu, "fmiGetModelTypesPlatform");
+        fmu->getTypesPlatform    = (fGetTypesPlatform)   getAdr(&s, fmu, modelIdentifier, "fmiGetModelTypesPlatform");
         if (s==1) printf("  using fmiGetModelTypesPlatform instead\n");
     }
-    fmu->instantiateSlave        = (fInstantiateSlave)   getAdr(&s, fmu, "fmiInstantiateSlave");
-    fmu->initializeSlave         = (fInitializeSlave)    getAdr(&s, fmu, "fmiInitializeSlave");
-    fmu->terminateSlave          = (fTerminateSlave)     getAdr(&s, fmu, "fmiTerminateSlave");
-    fmu->resetSlave              = (fResetSlave)         getAdr(&s, fmu, "fmiResetSlave");
-    fmu->freeSlaveInstance       = (fFreeSlaveInstance)  getAdr(&s, fmu, "fmiFreeSlaveInstance");
-    fmu->setRealInputDerivatives = (fSetRealInputDerivatives) getAdr(&s, fmu, "fmiSetRealInputDerivatives");
-    fmu->getRealOutputDerivatives = (fGetRealOutputDerivatives) getAdr(&s, fmu, "fmiGetRealOutputDerivatives");
-    fmu->cancelStep              = (fCancelStep)         getAdr(&s, fmu, "fmiCancelStep");
-    fmu->doStep                  = (fDoStep)             getAdr(&s, fmu, "fmiDoStep");
+    fmu->instantiateSlave        = (fInstantiateSlave)   getAdr(&s, fmu, modelIdentifier, "fmiInstantiateSlave");
+    fmu->initializeSlave         = (fInitializeSlave)    getAdr(&s, fmu, modelIdentifier, "fmiInitializeSlave");
+    fmu->terminateSlave          = (fTerminateSlave)     getAdr(&s, fmu, modelIdentifier, "fmiTerminateSlave");
+    fmu->resetSlave              = (fResetSlave)         getAdr(&s, fmu, modelIdentifier, "fmiResetSlave");
+    fmu->freeSlaveInstance       = (fFreeSlaveInstance)  getAdr(&s, fmu, modelIdentifier, "fmiFreeSlaveInstance");
+    fmu->setRealInputDerivatives = (fSetRealInputDerivatives) getAdr(&s, fmu, modelIdentifier, "fmiSetRealInputDerivatives");
+    fmu->getRealOutputDerivatives = (fGetRealOutputDerivatives) getAdr(&s, fmu, modelIdentifier, "fmiGetRealOutputDerivatives");
+    fmu->cancelStep              = (fCancelStep)         getAdr(&s, fmu, modelIdentifier, "fmiCancelStep");
+    fmu->doStep                  = (fDoStep)             getAdr(&s, fmu, modelIdentifier, "fmiDoStep");
     // SimulationX 3.4 and 3.5 do not yet export getStatus and getXStatus: do not count this as failure here
-    fmu->getStatus               = (fGetStatus)          getAdr(&x, fmu, "fmiGetStatus");
-    fmu->getRealStatus           = (fGetRealStatus)      getAdr(&x, fmu, "fmiGetRealStatus");
-    fmu->getIntegerStatus        = (fGetIntegerStatus)   getAdr(&x, fmu, "fmiGetIntegerStatus");
-    fmu->getBooleanStatus        = (fGetBooleanStatus)   getAdr(&x, fmu, "fmiGetBooleanStatus");
-    fmu->getStringStatus         = (fGetStringStatus)    getAdr(&x, fmu, "fmiGetStringStatus");
+    fmu->getStatus               = (fGetStatus)          getAdr(&x, fmu, modelIdentifier, "fmiGetStatus");
+    fmu->getRealStatus           = (fGetRealStatus)      getAdr(&x, fmu, modelIdentifier, "fmiGetRealStatus");
+    fmu->getIntegerStatus        = (fGetIntegerStatus)   getAdr(&x, fmu, modelIdentifier, "fmiGetIntegerStatus");
+    fmu->getBooleanStatus        = (fGetBooleanStatus)   getAdr(&x, fmu, modelIdentifier, "fmiGetBooleanStatus");
+    fmu->getStringStatus         = (fGetStringStatus)    getAdr(&x, fmu, modelIdentifier, "fmiGetStringStatus");
 
 #else // FMI for Model Exchange 1.0
-    fmu->getModelTypesPlatform   = (fGetModelTypesPlatform) getAdr(&s, fmu, "fmiGetModelTypesPlatform");
-    fmu->instantiateModel        = (fInstantiateModel)   getAdr(&s, fmu, "fmiInstantiateModel");
-    fmu->freeModelInstance       = (fFreeModelInstance)  getAdr(&s, fmu, "fmiFreeModelInstance");
-    fmu->setTime                 = (fSetTime)            getAdr(&s, fmu, "fmiSetTime");
-    fmu->setContinuousStates     = (fSetContinuousStates)getAdr(&s, fmu, "fmiSetContinuousStates");
-    fmu->completedIntegratorStep = (fCompletedIntegratorStep)getAdr(&s, fmu, "fmiCompletedIntegratorStep");
-    fmu->initialize              = (fInitialize)         getAdr(&s, fmu, "fmiInitialize");
-    fmu->getDerivatives          = (fGetDerivatives)     getAdr(&s, fmu, "fmiGetDerivatives");
-    fmu->getEventIndicators      = (fGetEventIndicators) getAdr(&s, fmu, "fmiGetEventIndicators");
-    fmu->eventUpdate             = (fEventUpdate)        getAdr(&s, fmu, "fmiEventUpdate");
-    fmu->getContinuousStates     = (fGetContinuousStates)getAdr(&s, fmu, "fmiGetContinuousStates");
-    fmu->getNominalContinuousStates = (fGetNominalContinuousStates)getAdr(&s, fmu, "fmiGetNominalContinuousStates");
-    fmu->getStateValueReferences = (fGetStateValueReferences)getAdr(&s, fmu, "fmiGetStateValueReferences");
-    fmu->terminate               = (fTerminate)          getAdr(&s, fmu, "fmiTerminate");
+    fmu->getModelTypesPlatform   = (fGetModelTypesPlatform) getAdr(&s, fmu, modelIdentifier, "fmiGetModelTypesPlatform");
+    fmu->instantiateModel        = (fInstantiateModel)   getAdr(&s, fmu, modelIdentifier, "fmiInstantiateModel");
+    fmu->freeModelInstance       = (fFreeModelInstance)  getAdr(&s, fmu, modelIdentifier, "fmiFreeModelInstance");
+    fmu->setTime                 = (fSetTime)            getAdr(&s, fmu, modelIdentifier, "fmiSetTime");
+    fmu->setContinuousStates     = (fSetContinuousStates)getAdr(&s, fmu, modelIdentifier, "fmiSetContinuousStates");
+    fmu->completedIntegratorStep = (fCompletedIntegratorStep)getAdr(&s, fmu, modelIdentifier, "fmiCompletedIntegratorStep");
+    fmu->initialize              = (fInitialize)         getAdr(&s, fmu, modelIdentifier, "fmiInitialize");
+    fmu->getDerivatives          = (fGetDerivatives)     getAdr(&s, fmu, modelIdentifier, "fmiGetDerivatives");
+    fmu->getEventIndicators      = (fGetEventIndicators) getAdr(&s, fmu, modelIdentifier, "fmiGetEventIndicators");
+    fmu->eventUpdate             = (fEventUpdate)        getAdr(&s, fmu, modelIdentifier, "fmiEventUpdate");
+    fmu->getContinuousStates     = (fGetContinuousStates)getAdr(&s, fmu, modelIdentifier, "fmiGetContinuousStates");
+    fmu->getNominalContinuousStates = (fGetNominalContinuousStates)getAdr(&s, fmu, modelIdentifier, "fmiGetNominalContinuousStates");
+    fmu->getStateValueReferences = (fGetStateValueReferences)getAdr(&s, fmu, modelIdentifier, "fmiGetStateValueReferences");
+    fmu->terminate               = (fTerminate)          getAdr(&s, fmu, modelIdentifier, "fmiTerminate");
 #endif 
-    fmu->getVersion              = (fGetVersion)         getAdr(&s, fmu, "fmiGetVersion");
-    fmu->setDebugLogging         = (fSetDebugLogging)    getAdr(&s, fmu, "fmiSetDebugLogging");
-    fmu->setReal                 = (fSetReal)            getAdr(&s, fmu, "fmiSetReal");
-    fmu->setInteger              = (fSetInteger)         getAdr(&s, fmu, "fmiSetInteger");
-    fmu->setBoolean              = (fSetBoolean)         getAdr(&s, fmu, "fmiSetBoolean");
-    fmu->setString               = (fSetString)          getAdr(&s, fmu, "fmiSetString");
-    fmu->getReal                 = (fGetReal)            getAdr(&s, fmu, "fmiGetReal");
-    fmu->getInteger              = (fGetInteger)         getAdr(&s, fmu, "fmiGetInteger");
-    fmu->getBoolean              = (fGetBoolean)         getAdr(&s, fmu, "fmiGetBoolean");
-    fmu->getString               = (fGetString)          getAdr(&s, fmu, "fmiGetString");
+    fmu->getVersion              = (fGetVersion)         getAdr(&s, fmu, modelIdentifier, "fmiGetVersion");
+    fmu->setDebugLogging         = (fSetDebugLogging)    getAdr(&s, fmu, modelIdentifier, "fmiSetDebugLogging");
+    fmu->setReal                 = (fSetReal)            getAdr(&s, fmu, modelIdentifier, "fmiSetReal");
+    fmu->setInteger              = (fSetInteger)         getAdr(&s, fmu, modelIdentifier, "fmiSetInteger");
+    fmu->setBoolean              = (fSetBoolean)         getAdr(&s, fmu, modelIdentifier, "fmiSetBoolean");
+    fmu->setString               = (fSetString)          getAdr(&s, fmu, modelIdentifier, "fmiSetString");
+    fmu->getReal                 = (fGetReal)            getAdr(&s, fmu, modelIdentifier, "fmiGetReal");
+    fmu->getInteger              = (fGetInteger)         getAdr(&s, fmu, modelIdentifier, "fmiGetInteger");
+    fmu->getBoolean              = (fGetBoolean)         getAdr(&s, fmu, modelIdentifier, "fmiGetBoolean");
+    fmu->getString               = (fGetString)          getAdr(&s, fmu, modelIdentifier, "fmiGetString");
     return s; 
 }
 
@@ -289,38 +289,62 @@ static void printModelDescription(ModelDescription* md){
 
 FMU* loadFMU(const char* fmuFileName) {
     char* tmpPath;
-    char* xmlPath;
-    char* dllPath;
-    
-    FMU *fmu = (FMU*)malloc(sizeof(FMU));
+    char* fmuPath;
+    FMU *fmu;
 
     // get absolute path to FMU, NULL if not found
-    fmu->path = getFmuPath(fmuFileName);
-    if (!fmu->path) exit(EXIT_FAILURE);
+    fmuPath = getFmuPath(fmuFileName);
+    if (!fmuPath) exit(EXIT_FAILURE);
 
     // unzip the FMU to the tmpPath directory
     tmpPath = getTmpPath();
-    if (!unzip(fmu->path, tmpPath)) exit(EXIT_FAILURE);
+    if (!unzip(fmuPath, tmpPath)) exit(EXIT_FAILURE);
+    free(fmuPath);
 
-    // parse tmpPath\modelDescription.xml
-    xmlPath = (char*)calloc(sizeof(char), strlen(tmpPath) + strlen(XML_FILE) + 1);
-    sprintf(xmlPath, "%s%s", tmpPath, XML_FILE);
-    fmu->modelDescription = parse(xmlPath);
+    fmu = loadExtractedFMU(fmuFileName, tmpPath);
+    free(tmpPath);
+    return fmu;
+}
+
+FMU* loadExtractedFMU(const char* fmuFileName, const char* extractedPath) {
+    char* xmlPath;
+    ModelDescription* modelDescription;
+
+    // parse extractedPath\modelDescription.xml
+    xmlPath = (char*)calloc(sizeof(char), strlen(extractedPath) + strlen(XML_FILE) + 1);
+    sprintf(xmlPath, "%s%s", extractedPath, XML_FILE);
+    modelDescription = parse(xmlPath);
     free(xmlPath);
-    if (!fmu->modelDescription) exit(EXIT_FAILURE);
-    printModelDescription(fmu->modelDescription);
+    if (!modelDescription) exit(EXIT_FAILURE);
+    printModelDescription(modelDescription);
+
+    return loadExtractedFMUDll(fmuFileName, extractedPath, modelDescription, getModelIdentifier(modelDescription));
+}
+
+FMU* loadExtractedFMUDll(const char* fmuFileName, const char* extractedPath, ModelDescription* modelDescription,
+                         const char* modelIdentifier) {
+    char* tmpPath;
+    char* dllPath;
+
+    FMU *fmu = (FMU*)malloc(sizeof(FMU));
+
+    // get absolute path to FMU, NULL if not found
+    fmu->path = getFmuPath(fmuFileName);
+    if (!fmu->path) exit(EXIT_FAILURE);
+    tmpPath = strdup(extractedPath);
+    fmu->modelDescription = modelDescription;
 
     // load the FMU dll
     dllPath = (char*)calloc(sizeof(char), strlen(tmpPath) + strlen(DLL_DIR)
-            + strlen( getModelIdentifier(fmu->modelDescription)) +  strlen(DLL_SUFFIX) + 1);
-    sprintf(dllPath,"%s%s%s%s", tmpPath, DLL_DIR, getModelIdentifier(fmu->modelDescription), DLL_SUFFIX);
-    if (!loadDll(dllPath, fmu)) {
+            + strlen(modelIdentifier) +  strlen(DLL_SUFFIX) + 1);
+    sprintf(dllPath,"%s%s%s%s", tmpPath, DLL_DIR, modelIdentifier, DLL_SUFFIX);
+    if (!loadDll(dllPath, fmu, modelIdentifier)) {
         // try the alternative directory and suffix
         free(dllPath);
         dllPath = (char*)calloc(sizeof(char), strlen(tmpPath) + strlen(DLL_DIR2)
-                + strlen( getModelIdentifier(fmu->modelDescription)) +  strlen(DLL_SUFFIX2) + 1);
-        sprintf(dllPath,"%s%s%s%s", tmpPath, DLL_DIR2, getModelIdentifier(fmu->modelDescription), DLL_SUFFIX2);
-        if (!loadDll(dllPath, fmu)) exit(EXIT_FAILURE);
+                + strlen(modelIdentifier) +  strlen(DLL_SUFFIX2) + 1);
+        sprintf(dllPath,"%s%s%s%s", tmpPath, DLL_DIR2, modelIdentifier, DLL_SUFFIX2);
+        if (!loadDll(dllPath, fmu, modelIdentifier)) exit(EXIT_FAILURE);
     }
     free(dllPath);
     fmu->tmpFolder = tmpPath;
@@ -457,8 +481,10 @@ static const char* fmiStatusToString(fmiStatus status){
 static ScalarVariable* getSV(FMU* fmu, char type, fmiValueReference vr) {
     int i;
     Elm tp;
-    ScalarVariable** vars = fmu->modelDescription->modelVariables;
-    if (vr==fmiUndefinedValueReference) return NULL;
+    ScalarVariable** vars;
+    // not parsed, if the FMU was loaded by loadExtractedFMUDll
+    if (vr==fmiUndefinedValueReference || !fmu->modelDescription) return NULL;
+    vars = fmu->modelDescription->modelVariables;
     switch (type) {
         case 'r': tp = elm_Real;    break;
         case 'i': tp = elm_Integer; break;